@@ -22,8 +22,8 @@ using namespace swss;
 #define VXLAN_BR_IF_NAME_PREFIX    "Brvxlan"
 
 FdbSync::FdbSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *config_db) :
-    m_fdbTable(pipelineAppDB, APP_VXLAN_FDB_TABLE_NAME),
-    m_imetTable(pipelineAppDB, APP_VXLAN_REMOTE_VNI_TABLE_NAME),
+    m_fdbTable(pipelineAppDB, APP_VXLAN_FDB_TABLE_NAME, true),
+    m_imetTable(pipelineAppDB, APP_VXLAN_REMOTE_VNI_TABLE_NAME, true),
     m_fdbStateTable(stateDb, STATE_FDB_TABLE_NAME),
     m_cfgEvpnNvoTable(config_db, CFG_VXLAN_EVPN_NVO_TABLE_NAME)
 {
@@ -428,8 +428,8 @@ void FdbSync::imetAddRoute(struct in_addr vtep, string vlan_str, uint32_t vni)
         m_AppRestartAssist->insertToMap(APP_VXLAN_REMOTE_VNI_TABLE_NAME, key, fvVector, false);
         return;
     }
-    
-    m_imetTable.set(key, fvVector);
+
+    m_pendingImet[key] = {false, fvVector};
     return;
 }
 
@@ -457,8 +457,8 @@ void FdbSync::imetDelRoute(struct in_addr vtep, string vlan_str, uint32_t vni)
         m_AppRestartAssist->insertToMap(APP_VXLAN_REMOTE_VNI_TABLE_NAME, key, fvVector, true);
         return;
     }
-    
-    m_imetTable.del(key);
+
+    m_pendingImet[key] = {true, {}};
     return;
 }
 
@@ -487,8 +487,8 @@ void FdbSync::macDelVxlanDB(string key)
         m_AppRestartAssist->insertToMap(APP_VXLAN_FDB_TABLE_NAME, key, fvVector, true);
         return;
     }
-    
-    m_fdbTable.del(key);
+
+    m_pendingFdb[key] = {true, {}};
     return;
 
 }
@@ -498,6 +498,19 @@ void FdbSync::macAddVxlan(string key, struct in_addr vtep, string type, uint32_t
     string svtep = inet_ntoa(vtep);
     string svni = to_string(vni);
 
+    /*
+     * The kernel re-notifies remote MACs on every state refresh, skip the
+     * update if nothing changed since it was last written.
+     */
+    auto it = m_mac.find(key);
+    if (it != m_mac.end() && it->second.vtep == svtep && it->second.type == type &&
+        it->second.vni == vni && it->second.ifname == intf_name &&
+        !m_AppRestartAssist->isWarmStartInProgress())
+    {
+        SWSS_LOG_DEBUG("VXLAN_FDB_TABLE: unchanged KEY %s vtep:%s type:%s", key.c_str(), svtep.c_str(), type.c_str());
+        return;
+    }
+
     /* Update the DB with Vxlan MAC */
     m_mac[key] = {svtep, type, vni, intf_name};
 
@@ -518,8 +531,8 @@ void FdbSync::macAddVxlan(string key, struct in_addr vtep, string type, uint32_t
         m_AppRestartAssist->insertToMap(APP_VXLAN_FDB_TABLE_NAME, key, fvVector, false);
         return;
     }
-    
-    m_fdbTable.set(key, fvVector);
+
+    m_pendingFdb[key] = {false, fvVector};
 
     return;
 }
@@ -671,6 +684,46 @@ void FdbSync::onMsgNbr(int nlmsg_type, struct nl_object *obj)
     return;
 }
 
+void FdbSync::flushPendingUpdates()
+{
+    if (m_pendingFdb.empty() && m_pendingImet.empty())
+    {
+        return;
+    }
+
+    SWSS_LOG_INFO("Flushing %zu VXLAN FDB and %zu IMET updates", m_pendingFdb.size(), m_pendingImet.size());
+
+    for (auto &it : m_pendingFdb)
+    {
+        if (it.second.del)
+        {
+            m_fdbTable.del(it.first);
+        }
+        else
+        {
+            m_fdbTable.set(it.first, it.second.fvVector);
+        }
+    }
+
+    for (auto &it : m_pendingImet)
+    {
+        if (it.second.del)
+        {
+            m_imetTable.del(it.first);
+        }
+        else
+        {
+            m_imetTable.set(it.first, it.second.fvVector);
+        }
+    }
+
+    m_pendingFdb.clear();
+    m_pendingImet.clear();
+
+    /* Both tables share the APP_DB pipeline */
+    m_fdbTable.flush();
+}
+
 void FdbSync::onMsgLink(int nlmsg_type, struct nl_object *obj)
 {
     struct rtnl_link *link;
@@ -73,6 +73,9 @@ public:
 
     void processCfgEvpnNvo();
 
+    /* Write the VXLAN FDB/IMET updates coalesced since the last flush as one pipelined batch */
+    void flushPendingUpdates();
+
     bool m_reconcileDone = false;
 
     bool m_isEvpnNvoExist = false;
@@ -129,6 +132,18 @@ private:
     };
     std::unordered_map<int, intf> m_intf_info;
 
+    struct m_pending_update
+    {
+        bool del;
+        std::vector<FieldValueTuple> fvVector;
+    };
+    /*
+     * Latest update per APP_DB key since the last flush, an add followed by
+     * a delete of the same MAC within one netlink read collapses into the delete.
+     */
+    std::unordered_map<std::string, m_pending_update> m_pendingFdb;
+    std::unordered_map<std::string, m_pending_update> m_pendingImet;
+
     void addLocalMac(std::string key, std::string op);
     void macAddVxlan(std::string key, struct in_addr vtep, std::string type, uint32_t vni, std::string intf_name);
     void macDelVxlan(std::string auxkey);
@@ -143,6 +143,9 @@ int main(int argc, char **argv)
                         }
                     }
                 }
+
+                /* Write everything translated in this iteration as one batch */
+                sync.flushPendingUpdates();
             }
         }
         catch (const std::exception& e)
@@ -0,0 +1,157 @@
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <system_error>
+#include "logger.h"
+#include "fpmsyncd/fpmcapture.h"
+
+using namespace swss;
+using namespace std;
+
+FpmCaptureWriter::FpmCaptureWriter(const string &path) :
+    m_path(path),
+    m_fd(-1),
+    m_map(NULL),
+    m_mapSize(0),
+    m_used(0)
+{
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0)
+        throw system_error(errno, system_category(), "Unable to open " + path);
+
+    grow(sizeof(fpm_capture_file_hdr_t));
+
+    fpm_capture_file_hdr_t *fileHdr = reinterpret_cast<fpm_capture_file_hdr_t *>(m_map);
+    fileHdr->magic = FPM_CAPTURE_MAGIC;
+    fileHdr->version = FPM_CAPTURE_VERSION;
+    m_used = sizeof(fpm_capture_file_hdr_t);
+
+    SWSS_LOG_NOTICE("Capturing FPM messages to %s", path.c_str());
+}
+
+FpmCaptureWriter::~FpmCaptureWriter()
+{
+    if (m_map)
+        munmap(m_map, m_mapSize);
+
+    /* Drop the unused zero-filled tail */
+    if (m_fd >= 0)
+    {
+        if (ftruncate(m_fd, (off_t)m_used) < 0)
+            SWSS_LOG_ERROR("Unable to truncate %s: %s", m_path.c_str(), strerror(errno));
+        close(m_fd);
+    }
+}
+
+void FpmCaptureWriter::grow(size_t needed)
+{
+    size_t newSize = m_mapSize + max(needed, FILE_GROWTH);
+
+    if (ftruncate(m_fd, (off_t)newSize) < 0)
+        throw system_error(errno, system_category(), "Unable to grow " + m_path);
+
+    void *map;
+    if (m_map)
+        map = mremap(m_map, m_mapSize, newSize, MREMAP_MAYMOVE);
+    else
+        map = mmap(NULL, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+
+    if (map == MAP_FAILED)
+        throw system_error(errno, system_category(), "Unable to map " + m_path);
+
+    m_map = static_cast<char *>(map);
+    m_mapSize = newSize;
+}
+
+void FpmCaptureWriter::write(const fpm_msg_hdr_t *hdr, size_t len)
+{
+    size_t recLen = sizeof(fpm_capture_rec_hdr_t) + FPM_CAPTURE_REC_ALIGN(len);
+
+    /* Always keep room for a zero length record terminating the capture */
+    if (m_used + recLen + sizeof(fpm_capture_rec_hdr_t) > m_mapSize)
+        grow(recLen + sizeof(fpm_capture_rec_hdr_t));
+
+    fpm_capture_rec_hdr_t *rec = reinterpret_cast<fpm_capture_rec_hdr_t *>(m_map + m_used);
+    memcpy(rec + 1, hdr, len);
+    rec->timestamp_ns = (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+    rec->reserved = 0;
+    rec->len = (uint32_t)len;
+
+    m_used += recLen;
+}
+
+FpmCaptureReader::FpmCaptureReader(const string &path) :
+    m_fd(-1),
+    m_map(NULL),
+    m_mapSize(0),
+    m_pos(0)
+{
+    struct stat st;
+
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0)
+        throw system_error(errno, system_category(), "Unable to open " + path);
+
+    if (fstat(m_fd, &st) < 0)
+    {
+        close(m_fd);
+        throw system_error(errno, system_category(), "Unable to stat " + path);
+    }
+
+    m_mapSize = (size_t)st.st_size;
+    if (m_mapSize < sizeof(fpm_capture_file_hdr_t))
+    {
+        close(m_fd);
+        throw system_error(make_error_code(errc::invalid_argument), "Truncated capture file " + path);
+    }
+
+    /* Private writable mapping, frames are handed out as mutable buffers */
+    void *map = mmap(NULL, m_mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, m_fd, 0);
+    if (map == MAP_FAILED)
+    {
+        close(m_fd);
+        throw system_error(errno, system_category(), "Unable to map " + path);
+    }
+    m_map = static_cast<char *>(map);
+
+    const fpm_capture_file_hdr_t *fileHdr = reinterpret_cast<const fpm_capture_file_hdr_t *>(m_map);
+    if (fileHdr->magic != FPM_CAPTURE_MAGIC || fileHdr->version != FPM_CAPTURE_VERSION)
+    {
+        munmap(m_map, m_mapSize);
+        close(m_fd);
+        throw system_error(make_error_code(errc::invalid_argument), "Not an FPM capture file " + path);
+    }
+
+    madvise(m_map, m_mapSize, MADV_SEQUENTIAL);
+    m_pos = sizeof(fpm_capture_file_hdr_t);
+}
+
+FpmCaptureReader::~FpmCaptureReader()
+{
+    munmap(m_map, m_mapSize);
+    close(m_fd);
+}
+
+bool FpmCaptureReader::next(uint64_t &timestamp_ns, fpm_msg_hdr_t *&hdr)
+{
+    if (m_pos + sizeof(fpm_capture_rec_hdr_t) > m_mapSize)
+        return false;
+
+    fpm_capture_rec_hdr_t *rec = reinterpret_cast<fpm_capture_rec_hdr_t *>(m_map + m_pos);
+    if (rec->len == 0)
+        return false;
+
+    size_t recLen = sizeof(fpm_capture_rec_hdr_t) + FPM_CAPTURE_REC_ALIGN(rec->len);
+    if (m_pos + recLen > m_mapSize)
+        return false;
+
+    timestamp_ns = rec->timestamp_ns;
+    hdr = reinterpret_cast<fpm_msg_hdr_t *>(rec + 1);
+    m_pos += recLen;
+
+    return true;
+}
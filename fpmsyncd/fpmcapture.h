@@ -0,0 +1,77 @@
+#ifndef __FPMCAPTURE__
+#define __FPMCAPTURE__
+
+#include <stdint.h>
+#include <string>
+
+#include "fpm/fpm.h"
+
+namespace swss {
+
+/*
+ * Binary capture file of received FPM frames, used to replay a route load
+ * offline through RouteSync (see fpmreplay).
+ *
+ * Layout: fpm_capture_file_hdr_t, followed by records made of an
+ * fpm_capture_rec_hdr_t and the raw FPM frame, padded to 8 bytes. The file
+ * is grown in zero-filled steps, a record with zero length marks its end.
+ */
+#define FPM_CAPTURE_MAGIC   0x46504d43 /* "FPMC" */
+#define FPM_CAPTURE_VERSION 1
+
+typedef struct fpm_capture_file_hdr_t_
+{
+    uint32_t magic;
+    uint32_t version;
+} fpm_capture_file_hdr_t;
+
+typedef struct fpm_capture_rec_hdr_t_
+{
+    uint64_t timestamp_ns; /* steady clock time the frame was received */
+    uint32_t len;          /* FPM frame length, header included */
+    uint32_t reserved;
+} fpm_capture_rec_hdr_t;
+
+#define FPM_CAPTURE_REC_ALIGN(len) (((len) + 7) & ~(size_t)7)
+
+class FpmCaptureWriter
+{
+public:
+    FpmCaptureWriter(const std::string &path);
+    ~FpmCaptureWriter();
+
+    /* Append one FPM frame stamped with the current time */
+    void write(const fpm_msg_hdr_t *hdr, size_t len);
+
+private:
+    /* Grow the file and its mapping by at least FILE_GROWTH bytes */
+    void grow(size_t needed);
+
+    static const size_t FILE_GROWTH = 64 * 1024 * 1024;
+
+    std::string m_path;
+    int m_fd;
+    char *m_map;
+    size_t m_mapSize;
+    size_t m_used;
+};
+
+class FpmCaptureReader
+{
+public:
+    FpmCaptureReader(const std::string &path);
+    ~FpmCaptureReader();
+
+    /* Return the next frame, false once the end of the capture is reached */
+    bool next(uint64_t &timestamp_ns, fpm_msg_hdr_t *&hdr);
+
+private:
+    int m_fd;
+    char *m_map;
+    size_t m_mapSize;
+    size_t m_pos;
+};
+
+}
+
+#endif
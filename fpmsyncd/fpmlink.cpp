@@ -118,7 +118,8 @@ FpmLink::FpmLink(RouteSync *rsync, unsigned short port) :
     m_pos(0),
     m_connected(false),
     m_server_up(false),
-    m_routesync(rsync)
+    m_routesync(rsync),
+    m_capture(NULL)
 {
     struct sockaddr_in addr;
     int true_val = 1;
@@ -192,6 +193,43 @@ int FpmLink::getFd()
     return m_connection_socket;
 }
 
+void FpmLink::processFpmMsg(RouteSync *rsync, fpm_msg_hdr_t *hdr)
+{
+    if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
+    {
+        bool isRaw = false;
+
+        nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
+
+        /*
+         * EVPN Type5 Add Routes need to be process in Raw mode as they contain 
+         * RMAC, VLAN and L3VNI information.
+         * Where as all other route will be using rtnl api to extract information 
+         * from the netlink msg.
+         */
+        isRaw = isRawProcessing(nl_hdr);
+
+        nl_msg *msg = nlmsg_convert(nl_hdr);
+        if (msg == NULL)
+        {
+            throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
+        }
+
+        nlmsg_set_proto(msg, NETLINK_ROUTE);
+
+        if (isRaw)
+        {
+            /* EVPN Type5 Add route processing */
+            rsync->onMsgRaw(nl_hdr);
+        }
+        else
+        {
+            NetDispatcher::getInstance().onNetlinkMessage(msg);
+        }
+        nlmsg_free(msg);
+    }
+}
+
 uint64_t FpmLink::readData()
 {
     fpm_msg_hdr_t *hdr;
@@ -221,39 +259,10 @@ uint64_t FpmLink::readData()
         if (!fpm_msg_ok(hdr, left))
             throw system_error(make_error_code(errc::bad_message), "Malformed FPM message received");
 
-        if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
-        {
-            bool isRaw = false;
-
-            nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
-
-            /*
-             * EVPN Type5 Add Routes need to be process in Raw mode as they contain 
-             * RMAC, VLAN and L3VNI information.
-             * Where as all other route will be using rtnl api to extract information 
-             * from the netlink msg.
-           * */
-            isRaw = isRawProcessing(nl_hdr);
-
-            nl_msg *msg = nlmsg_convert(nl_hdr);
-            if (msg == NULL)
-            {
-                throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
-            }
-
-            nlmsg_set_proto(msg, NETLINK_ROUTE);
+        if (m_capture)
+            m_capture->write(hdr, msg_len);
 
-            if (isRaw)
-            {
-                /* EVPN Type5 Add route processing */
-                processRawMsg(nl_hdr);
-            }
-            else
-            {
-                NetDispatcher::getInstance().onNetlinkMessage(msg);
-            }
-            nlmsg_free(msg);
-        }
+        processFpmMsg(m_routesync, hdr);
         start += msg_len;
     }
 
@@ -14,6 +14,7 @@
 #include "selectable.h"
 #include "fpm/fpm.h"
 #include "fpmsyncd/routesync.h"
+#include "fpmsyncd/fpmcapture.h"
 
 namespace swss {
 
@@ -33,14 +34,20 @@ public:
     {
     };
 
-    bool isRawProcessing(struct nlmsghdr *h);
-    void processRawMsg(struct nlmsghdr *h)
+    static bool isRawProcessing(struct nlmsghdr *h);
+
+    /* Dispatch one complete FPM message to RouteSync */
+    static void processFpmMsg(RouteSync *rsync, fpm_msg_hdr_t *hdr);
+
+    /* Record every received FPM message into capture (NULL to stop) */
+    void setCapture(FpmCaptureWriter *capture)
     {
-        m_routesync->onMsgRaw(h);
-    };
+        m_capture = capture;
+    }
 
 private:
     RouteSync *m_routesync;
+    FpmCaptureWriter *m_capture;
     unsigned int m_bufSize;
     char *m_messageBuffer;
     unsigned int m_pos;
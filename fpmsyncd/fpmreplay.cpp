@@ -0,0 +1,160 @@
+#include <getopt.h>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "logger.h"
+#include "dbconnector.h"
+#include "netdispatcher.h"
+#include "fpmsyncd/fpmlink.h"
+#include "fpmsyncd/fpmcapture.h"
+#include "fpmsyncd/routesync.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * Replay an FPM capture recorded by "fpmsyncd -c" through RouteSync against
+ * the local APPL_DB, and report route processing rate and latency.
+ */
+
+/* Messages per pipeline flush at full speed, same as FpmLink's read batch */
+const uint64_t FPM_REPLAY_BATCH_SIZE = 256;
+
+void usage()
+{
+    cout << "Usage: fpmreplay [-p] capture_file" << endl;
+    cout << "       -p: pace messages by their recorded timestamps" << endl;
+    cout << "          replay at full speed if not specified" << endl;
+}
+
+static bool isRouteMsg(fpm_msg_hdr_t *hdr)
+{
+    if (hdr->msg_type != FPM_MSG_TYPE_NETLINK)
+    {
+        return false;
+    }
+
+    nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
+
+    return nl_hdr->nlmsg_type == RTM_NEWROUTE || nl_hdr->nlmsg_type == RTM_DELROUTE;
+}
+
+static uint64_t percentile(const vector<uint64_t> &sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    size_t idx = (size_t)(p * (double)(sorted.size() - 1));
+    return sorted[idx];
+}
+
+int main(int argc, char **argv)
+{
+    swss::Logger::linkToDbNative("fpmreplay");
+    int opt;
+    bool paced = false;
+
+    while ((opt = getopt(argc, argv, "ph")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'p':
+            paced = true;
+            break;
+        case 'h':
+            usage();
+            return EXIT_FAILURE;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        FpmCaptureReader reader(argv[optind]);
+
+        DBConnector db("APPL_DB", 0);
+        RedisPipeline pipeline(&db);
+        RouteSync sync(&pipeline);
+
+        NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
+        NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
+
+        using namespace std::chrono;
+
+        vector<uint64_t> latencies;
+        uint64_t messages = 0;
+        uint64_t routes = 0;
+        uint64_t timestamp;
+        uint64_t firstTimestamp = 0;
+        fpm_msg_hdr_t *hdr;
+
+        steady_clock::time_point start = steady_clock::now();
+
+        while (reader.next(timestamp, hdr))
+        {
+            if (!messages)
+            {
+                firstTimestamp = timestamp;
+            }
+
+            if (paced)
+            {
+                this_thread::sleep_until(start + nanoseconds(timestamp - firstTimestamp));
+            }
+
+            steady_clock::time_point msgStart = steady_clock::now();
+
+            FpmLink::processFpmMsg(&sync, hdr);
+            messages++;
+
+            /*
+             * Mimic fpmsyncd, which flushes the pipeline once per socket read
+             * of up to a batch of messages, or right away when paced.
+             */
+            if (paced || messages % FPM_REPLAY_BATCH_SIZE == 0)
+            {
+                pipeline.flush();
+            }
+
+            if (isRouteMsg(hdr))
+            {
+                routes++;
+                latencies.push_back((uint64_t)duration_cast<nanoseconds>(
+                            steady_clock::now() - msgStart).count());
+            }
+        }
+        pipeline.flush();
+
+        double elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+        sort(latencies.begin(), latencies.end());
+
+        cout << "Messages replayed: " << messages << endl;
+        cout << "Route messages:    " << routes << endl;
+        cout << fixed << setprecision(3);
+        cout << "Elapsed:           " << elapsed << " s" << endl;
+        cout << "Routes/sec:        " << (elapsed > 0 ? (double)routes / elapsed : 0) << endl;
+        cout << "Latency p50:       " << (double)percentile(latencies, 0.50) / 1000 << " us" << endl;
+        cout << "Latency p99:       " << (double)percentile(latencies, 0.99) / 1000 << " us" << endl;
+        cout << "Latency max:       " << (double)percentile(latencies, 1.0) / 1000 << " us" << endl;
+    }
+    catch (const exception& e)
+    {
+        cout << "Exception \"" << e.what() << "\" had been thrown in fpmreplay" << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
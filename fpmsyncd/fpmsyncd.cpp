@@ -1,4 +1,6 @@
+#include <getopt.h>
 #include <iostream>
+#include <memory>
 #include <inttypes.h>
 #include "logger.h"
 #include "select.h"
@@ -6,6 +8,7 @@
 #include "netdispatcher.h"
 #include "warmRestartHelper.h"
 #include "fpmsyncd/fpmlink.h"
+#include "fpmsyncd/fpmcapture.h"
 #include "fpmsyncd/routesync.h"
 
 
@@ -23,6 +26,13 @@ const uint32_t DEFAULT_ROUTING_RESTART_INTERVAL = 120;
 // TODO: support eoiu hold interval config
 const uint32_t DEFAULT_EOIU_HOLD_INTERVAL = 3;
 
+void usage()
+{
+    cout << "Usage: fpmsyncd [-c capture_file]" << endl;
+    cout << "       -c capture_file: record received FPM messages into capture_file" << endl;
+    cout << "          for offline replay with fpmreplay" << endl;
+}
+
 // Check if eoiu state reached by both ipv4 and ipv6
 static bool eoiuFlagsSet(Table &bgpStateTable)
 {
@@ -47,6 +57,25 @@ static bool eoiuFlagsSet(Table &bgpStateTable)
 int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("fpmsyncd");
+    int opt;
+    unique_ptr<FpmCaptureWriter> capture;
+
+    while ((opt = getopt(argc, argv, "c:h")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'c':
+            capture.reset(new FpmCaptureWriter(optarg));
+            break;
+        case 'h':
+            usage();
+            return EXIT_FAILURE;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     DBConnector db("APPL_DB", 0);
     RedisPipeline pipeline(&db);
     RouteSync sync(&pipeline);
@@ -62,6 +91,7 @@ int main(int argc, char **argv)
         try
         {
             FpmLink fpm(&sync);
+            fpm.setCapture(capture.get());
             Select s;
             SelectableTimer warmStartTimer(timespec{0, 0});
             // Before eoiu flags detected, check them periodically. It also stop upon detection of reconciliation done.
@@ -75,14 +105,28 @@ int main(int argc, char **argv)
              */
             pipeline.flush();
 
+            /*
+             * If warm-restart feature is enabled, kick off 'restoration' logic before
+             * waiting for the fpm-client, AppDB state is then streamed in background
+             * while the connection is being established.
+             */
+            bool warmStartEnabled = sync.m_warmStartHelper.checkAndStart();
+            bool restorationStarted = false;
+            if (warmStartEnabled)
+            {
+                restorationStarted = sync.m_warmStartHelper.runRestoration();
+            }
+            else
+            {
+                sync.m_warmStartHelper.setState(WarmStart::WSDISABLED);
+            }
+
             cout << "Waiting for fpm-client connection..." << endl;
             fpm.accept();
             cout << "Connected!" << endl;
 
             s.addSelectable(&fpm);
 
-            /* If warm-restart feature is enabled, execute 'restoration' logic */
-            bool warmStartEnabled = sync.m_warmStartHelper.checkAndStart();
             if (warmStartEnabled)
             {
                 /* Obtain warm-restart timer defined for routing application */
@@ -96,8 +140,8 @@ int main(int argc, char **argv)
                     warmStartTimer.setInterval(timespec{warmRestartIval, 0});
                 }
 
-                /* Execute restoration instruction and kick off warm-restart timer */
-                if (sync.m_warmStartHelper.runRestoration())
+                /* Kick off warm-restart timer if there is restored state to reconcile */
+                if (restorationStarted)
                 {
                     warmStartTimer.start();
                     s.addSelectable(&warmStartTimer);
@@ -110,10 +154,6 @@ int main(int argc, char **argv)
                 s.addSelectable(&eoiuCheckTimer);
                 SWSS_LOG_NOTICE("Warm-Restart eoiuCheckTimer timer started.");
             }
-            else
-            {
-                sync.m_warmStartHelper.setState(WarmStart::WSDISABLED);
-            }
 
             while (true)
             {
@@ -462,6 +462,7 @@ void MclagLink::setFdbEntry(char *msg, int msg_len)
     char *cur = NULL;
     short count = 0;
     int index = 0;
+    int adds = 0, dels = 0;
 
     cur = msg;           
     count = (short)(msg_len/sizeof(struct mclag_fdb_info));
@@ -500,26 +501,65 @@ void MclagLink::setFdbEntry(char *msg, int msg_len)
             FieldValueTuple type_attr("type", fdb.type);
             attrs.push_back(type_attr);
             p_fdb_tbl->set(fdb_key, attrs);
-            SWSS_LOG_NOTICE("add fdb entry into ASIC_DB:key =%s, type =%s", fdb_key.c_str(),  fdb.type.c_str());
+            adds++;
+            SWSS_LOG_INFO("add fdb entry into ASIC_DB:key =%s, type =%s", fdb_key.c_str(),  fdb.type.c_str());
         }
         else if (fdb_info->op_type == MCLAG_FDB_OPER_DEL)
         {
             p_fdb_tbl->del(fdb_key);
-            SWSS_LOG_NOTICE("del fdb entry from ASIC_DB:key =%s", fdb_key.c_str());
+            dels++;
+            SWSS_LOG_INFO("del fdb entry from ASIC_DB:key =%s", fdb_key.c_str());
         }
     }
+
+    if (adds || dels)
+    {
+        m_fdb_pending = true;
+        SWSS_LOG_NOTICE("Queued %d fdb add and %d fdb del from iccpd", adds, dels);
+    }
     return;
 }
 
+/*
+ * FDB entries received from iccpd are buffered in the APPL_DB pipeline and
+ * written once per read from the iccpd socket, or before any other message
+ * is processed so the relative order of updates is preserved.
+ */
+void MclagLink::flushFdbEntries()
+{
+    if (!m_fdb_pending)
+        return;
+
+    p_fdb_tbl->flush();
+    m_fdb_pending = false;
+}
+
+/* Write the whole buffer to iccpd, resuming on partial writes */
+bool MclagLink::mclagsyncdWriteAll(const char *buf, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t write = ::write(m_connection_socket, buf, len);
+        if (write < 0 && errno == EINTR)
+            continue;
+        if (write <= 0)
+            return false;
+
+        buf += write;
+        len -= (size_t)write;
+    }
+    return true;
+}
+
 void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &entries)
 {
-    size_t infor_len = sizeof(mclag_msg_hdr_t);
     struct mclag_fdb_info info;
     mclag_msg_hdr_t * msg_head = NULL;
-    int count = 0;
-    ssize_t write = 0;
-
-    char *infor_start = m_messageBuffer_send;
+    std::vector<struct mclag_fdb_info> fdbs;
+    std::unordered_map<std::string, size_t> fdb_index;
+    size_t infor_len = 0;
+    size_t msg_start = 0;
+    size_t per_msg = (MCLAG_MAX_SEND_MSG_LEN - sizeof(mclag_msg_hdr_t)) / sizeof(struct mclag_fdb_info);
 
     /* Nothing popped */
     if (entries.empty())
@@ -527,12 +567,12 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
         return;
     }
 
-    for (auto entry: entries)
+    fdbs.reserve(entries.size());
+    for (const auto &entry: entries)
     {
         memset(&info, 0, sizeof(struct mclag_fdb_info));
-        count++;
-        std::string key = kfvKey(entry);
-        std::string op = kfvOp(entry);
+        const std::string &key = kfvKey(entry);
+        const std::string &op = kfvOp(entry);
 
         std::size_t delimiter = key.find_first_of(":");
         auto vlan_name = key.substr(0, delimiter);
@@ -549,11 +589,11 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
         else
             info.op_type = MCLAG_FDB_OPER_DEL;
 
-        for (auto i : kfvFieldsValues(entry))
+        for (const auto &i : kfvFieldsValues(entry))
         {
             if (fvField(i) == "port")
             {
-                memcpy(info.port_name, fvValue(i).c_str(), fvValue(i).length());
+                memcpy(info.port_name, fvValue(i).c_str(), std::min(fvValue(i).length(), sizeof(info.port_name) - 1));
             }
             if (fvField(i) == "type")
             {
@@ -565,47 +605,58 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
                     SWSS_LOG_ERROR("MCLAGSYNCD STATE FDB updates key=%s, invalid MAC type %s\n", key.c_str(), fvValue(i).c_str());
             }
         }
-        SWSS_LOG_NOTICE("MCLAGSYNCD STATE FDB updates key=%s, operation=%s, type: %d, port: %s \n",
+        SWSS_LOG_INFO("MCLAGSYNCD STATE FDB updates key=%s, operation=%s, type: %d, port: %s \n",
                 key.c_str(), op.c_str(), info.type, info.port_name);
 
-        if (MCLAG_MAX_SEND_MSG_LEN - infor_len < sizeof(struct mclag_fdb_info))
+        /* Only the latest update of a MAC in this batch is relevant to iccpd */
+        auto it = fdb_index.find(key);
+        if (it != fdb_index.end())
+        {
+            fdbs[it->second] = info;
+        }
+        else
         {
-            msg_head = reinterpret_cast<mclag_msg_hdr_t *>(static_cast<void *>(infor_start));
-            msg_head->version = 1;
-            msg_head->msg_len = (unsigned short)infor_len;
-            msg_head ->msg_type = MCLAG_SYNCD_MSG_TYPE_FDB_OPERATION;
+            fdb_index.emplace(key, fdbs.size());
+            fdbs.push_back(info);
+        }
+    }
 
-            SWSS_LOG_DEBUG("mclagsycnd buffer full send msg to iccpd, msg_len =%d, msg_type =%d count : %d",
-                    msg_head->msg_len, msg_head->msg_type, count);
-            write = ::write(m_connection_socket, infor_start, msg_head->msg_len);
+    SWSS_LOG_NOTICE("MCLAGSYNCD sending %zu STATE FDB updates to iccpd (%zu popped)", fdbs.size(), entries.size());
 
-            if (write <= 0)
+    /*
+     * Pack the updates into back-to-back FDB messages and hand a whole batch
+     * of messages to the socket in a single write.
+     */
+    for (size_t i = 0; i < fdbs.size(); i += per_msg)
+    {
+        size_t n = std::min(per_msg, fdbs.size() - i);
+        size_t msg_len = sizeof(mclag_msg_hdr_t) + n * sizeof(struct mclag_fdb_info);
+
+        if (infor_len + msg_len > m_fdbSendBufSize)
+        {
+            if (!mclagsyncdWriteAll(m_fdbSendBuffer, infor_len))
             {
                 SWSS_LOG_ERROR("mclagsycnd update FDB to ICCPD Buffer full, write to m_connection_socket failed");
             }
-
-            infor_len = sizeof(mclag_msg_hdr_t);
-            count = 0;
+            infor_len = 0;
         }
-        memcpy((char*)(infor_start + infor_len), (char*)&info, sizeof(struct mclag_fdb_info));
-        infor_len = infor_len +  sizeof(struct mclag_fdb_info);
-    }
-
 
-    if (infor_len <= sizeof(mclag_msg_hdr_t)) /*no fdb entry need notifying iccpd*/
-        return;
+        msg_start = infor_len;
+        msg_head = reinterpret_cast<mclag_msg_hdr_t *>(static_cast<void *>(m_fdbSendBuffer + msg_start));
+        msg_head->version = 1;
+        msg_head->msg_len = (unsigned short)msg_len;
+        msg_head ->msg_type = MCLAG_SYNCD_MSG_TYPE_FDB_OPERATION;
+        memcpy(m_fdbSendBuffer + msg_start + sizeof(mclag_msg_hdr_t), &fdbs[i], n * sizeof(struct mclag_fdb_info));
+        infor_len += msg_len;
 
-    msg_head = reinterpret_cast<mclag_msg_hdr_t *>(static_cast<void *>(infor_start));
-
-    msg_head->version = 1;
-    msg_head->msg_len = (unsigned short)infor_len;
-    msg_head ->msg_type = MCLAG_SYNCD_MSG_TYPE_FDB_OPERATION;
+        SWSS_LOG_DEBUG("mclagsycnd queue msg to iccpd, msg_len =%d, msg_type =%d count : %zu",
+                msg_head->msg_len, msg_head->msg_type, n);
+    }
 
-    SWSS_LOG_DEBUG("mclagsycnd send msg to iccpd, msg_len =%d, msg_type =%d count : %d",
-            msg_head->msg_len, msg_head->msg_type, count);
-    write = ::write(m_connection_socket, infor_start, msg_head->msg_len);
+    if (infor_len == 0) /*no fdb entry need notifying iccpd*/
+        return;
 
-    if (write <= 0)
+    if (!mclagsyncdWriteAll(m_fdbSendBuffer, infor_len))
     {
         SWSS_LOG_ERROR("mclagsycnd update FDB to ICCPD, write to m_connection_socket failed");
     }
@@ -1780,6 +1831,8 @@ MclagLink::MclagLink(Select *select, int port) :
     m_server_up = true;
     m_messageBuffer = new char[m_bufSize];
     m_messageBuffer_send = new char[MCLAG_MAX_SEND_MSG_LEN];
+    m_fdbSendBufSize = MCLAG_MAX_SEND_MSG_LEN * MCLAG_FDB_SEND_BATCH_MSGS;
+    m_fdbSendBuffer = new char[m_fdbSendBufSize];
 
     p_learn = NULL;
 
@@ -1789,6 +1842,7 @@ MclagLink::MclagLink(Select *select, int port) :
     p_asic_db     = unique_ptr<DBConnector>(new DBConnector("ASIC_DB", 0));
     p_counters_db = unique_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
     p_notificationsDb = unique_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
+    p_appl_pipeline   = unique_ptr<RedisPipeline>(new RedisPipeline(p_appl_db.get()));
 
     p_device_metadata_tbl          = unique_ptr<Table>(new Table(p_config_db.get(), CFG_DEVICE_METADATA_TABLE_NAME));
     p_mclag_cfg_table              = unique_ptr<Table>(new Table(p_config_db.get(), CFG_MCLAG_TABLE_NAME)); 
@@ -1801,7 +1855,7 @@ MclagLink::MclagLink(Select *select, int port) :
 
     p_intf_tbl      = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_INTF_TABLE_NAME));
     p_iso_grp_tbl   = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_ISOLATION_GROUP_TABLE_NAME));
-    p_fdb_tbl       = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_MCLAG_FDB_TABLE_NAME));
+    p_fdb_tbl       = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_pipeline.get(), APP_MCLAG_FDB_TABLE_NAME, true));
     p_acl_table_tbl = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_ACL_TABLE_TABLE_NAME));
     p_acl_rule_tbl  = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_ACL_RULE_TABLE_NAME));
     p_lag_tbl       = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_LAG_TABLE_NAME));
@@ -1817,6 +1871,7 @@ MclagLink::~MclagLink()
 {
     delete[] m_messageBuffer;
     delete[] m_messageBuffer_send;
+    delete[] m_fdbSendBuffer;
     if (m_connected)
         close(m_connection_socket);
     if (m_server_up)
@@ -1895,6 +1950,9 @@ uint64_t MclagLink::readData()
 
         msg = ((char*)hdr) + MCLAG_MSG_HDR_LEN;
 
+        if (hdr->msg_type != MCLAG_MSG_TYPE_SET_FDB)
+            flushFdbEntries();
+
         switch (hdr->msg_type)
         {
             case MCLAG_MSG_TYPE_PORT_ISOLATE:
@@ -1950,6 +2008,7 @@ uint64_t MclagLink::readData()
 
         start += msg_len;
     }
+    flushFdbEntries();
     memmove(m_messageBuffer, m_messageBuffer + start, m_pos - start);
     m_pos = m_pos - (uint32_t)start;
     return 0;
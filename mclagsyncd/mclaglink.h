@@ -34,6 +34,8 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <net/ethernet.h>
 
 #include "producerstatetable.h"
@@ -52,6 +54,9 @@
 #define MAX_L_PORT_NAME 20
 #define BRCM_PLATFORM_SUBSTRING "broadcom"
 
+/* Number of MCLAG FDB messages packed into a single write to iccpd */
+#define MCLAG_FDB_SEND_BATCH_MSGS 256
+
 using namespace std;
 
 namespace swss {
@@ -193,6 +198,8 @@ namespace swss {
             unsigned int m_bufSize;
             char *m_messageBuffer;
             char *m_messageBuffer_send;
+            char *m_fdbSendBuffer;
+            size_t m_fdbSendBufSize;
             unsigned int m_pos;
 
             bool m_connected;
@@ -213,6 +220,7 @@ namespace swss {
             unique_ptr<DBConnector> p_asic_db;
             unique_ptr<DBConnector> p_counters_db;
             unique_ptr<DBConnector> p_notificationsDb;
+            unique_ptr<RedisPipeline> p_appl_pipeline;
 
             unique_ptr<Table> p_mclag_tbl;
             unique_ptr<Table> p_mclag_local_intf_tbl;
@@ -227,7 +235,8 @@ namespace swss {
             unique_ptr<ProducerStateTable> p_acl_rule_tbl;
             unique_ptr<ProducerStateTable> p_lag_tbl;
             unique_ptr<ProducerStateTable> p_iso_grp_tbl;
-            unique_ptr<ProducerStateTable> p_fdb_tbl;
+            unique_ptr<ProducerStateTable> p_fdb_tbl;   /* buffered, see flushFdbEntries() */
+            bool m_fdb_pending = false;
 
             SubscriberStateTable *p_mclag_intf_cfg_tbl;
             SubscriberStateTable *p_mclag_unique_ip_cfg_tbl;
@@ -244,6 +253,7 @@ namespace swss {
             uint64_t readData() override; 
 
             void mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &entries);
+            bool mclagsyncdWriteAll(const char *buf, size_t len);
 
 
             void mclagsyncdSetTrafficDisable(char *msg_buf, uint8_t msg_type);
@@ -273,6 +283,7 @@ namespace swss {
             void setFdbFlush();
             void setIntfMac(char *msg);
             void setFdbEntry(char *msg, int msg_len);
+            void flushFdbEntries();
 
             void addVlanMbr(std::string, std::string);
             void delVlanMbr(std::string, std::string);
@@ -15,7 +15,15 @@
  */
 
 #include <string>
+#include <string.h>
+#include <errno.h>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
 #include <netinet/in.h>
+#include <sys/socket.h>
+#include <linux/filter.h>
+#include <linux/netlink.h>
 #include <netlink/netfilter/ct.h>
 #include <netlink/utils.h>
 
@@ -25,6 +33,7 @@
 #include "ipaddress.h"
 #include "netmsg.h"
 #include "linkcache.h"
+#include <inttypes.h>
 
 #include "natsync.h"
 #include "warm_restart.h"
@@ -38,19 +47,24 @@ using namespace swss;
 #define CT_UDP_EXPIRY_TIMEOUT   600 /* Max conntrack timeout in the user configurable range */
 
 NatSync::NatSync(RedisPipeline *pipelineAppDB, DBConnector *appDb, DBConnector *stateDb, NfNetlink *nfnl) :
-    m_natTable(appDb, APP_NAT_TABLE_NAME),
-    m_naptTable(appDb, APP_NAPT_TABLE_NAME),
-    m_natTwiceTable(appDb, APP_NAT_TWICE_TABLE_NAME),
-    m_naptTwiceTable(appDb, APP_NAPT_TWICE_TABLE_NAME),
+    m_natTable(pipelineAppDB, APP_NAT_TABLE_NAME, true),
+    m_naptTable(pipelineAppDB, APP_NAPT_TABLE_NAME, true),
+    m_natTwiceTable(pipelineAppDB, APP_NAT_TWICE_TABLE_NAME, true),
+    m_naptTwiceTable(pipelineAppDB, APP_NAPT_TWICE_TABLE_NAME, true),
     m_natCheckTable(appDb, APP_NAT_TABLE_NAME),
     m_naptCheckTable(appDb, APP_NAPT_TABLE_NAME),
     m_twiceNatCheckTable(appDb, APP_NAT_TWICE_TABLE_NAME),
     m_twiceNaptCheckTable(appDb, APP_NAPT_TWICE_TABLE_NAME),
     m_naptPoolCheckTable(appDb, APP_NAPT_POOL_IP_TABLE_NAME),
-    m_stateNatRestoreTable(stateDb, STATE_NAT_RESTORE_TABLE_NAME)
+    m_stateNatRestoreTable(stateDb, STATE_NAT_RESTORE_TABLE_NAME),
+    m_stateNatSyncStatsTable(stateDb, STATE_NAT_SYNC_STATS_TABLE_NAME),
+    m_statsTimer(timespec{NATSYNC_STATS_INTERVAL, 0})
 {
     nfsock = nfnl;
 
+    configureConntrackSocket();
+    m_statsTimer.start();
+
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "natsyncd", "nat", DEFAULT_NATSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
     {
@@ -242,6 +256,7 @@ void NatSync::onMsg(int nlmsg_type, struct nl_object *obj)
     struct naptEntry      napt;
   
     nlmsg_type = NFNL_MSG_TYPE(nlmsg_type);
+    m_ctEvents++;
 
     SWSS_LOG_DEBUG("Conntrack entry notification, msg type :%s (%d)",
         (((nlmsg_type == IPCTNL_MSG_CT_NEW) ? "CT_NEW" : ((nlmsg_type == IPCTNL_MSG_CT_DELETE) ? "CT_DELETE" : "OTHER"))),
@@ -256,6 +271,7 @@ void NatSync::onMsg(int nlmsg_type, struct nl_object *obj)
     /* Parse the conntrack notification from the kernel */
     if (-1 == parseConnTrackMsg(ct, napt))
     {
+        m_ctIgnoredEvents++;
         return;
     }
 
@@ -292,6 +308,160 @@ void NatSync::onMsg(int nlmsg_type, struct nl_object *obj)
     }
 }
 
+/* Lookup an entry in APP_DB, including the writes not flushed yet */
+bool NatSync::getNatEntry(Table &checkTable, const string &key, vector<FieldValueTuple> &values)
+{
+    auto table = m_pendingEntries.find(checkTable.getTableName());
+    if (table != m_pendingEntries.end())
+    {
+        auto it = table->second.find(key);
+        if (it != table->second.end())
+        {
+            if (it->second.del)
+            {
+                return false;
+            }
+            values = it->second.fvVector;
+            return true;
+        }
+    }
+
+    return checkTable.get(key, values);
+}
+
+void NatSync::setNatEntry(ProducerStateTable &table, const string &key, const vector<FieldValueTuple> &values)
+{
+    table.set(key, values);
+    m_pendingEntries[table.getTableName()][key] = { false, values };
+}
+
+void NatSync::delNatEntry(ProducerStateTable &table, const string &key)
+{
+    table.del(key);
+    m_pendingEntries[table.getTableName()][key] = { true, {} };
+}
+
+/* The timeout notifications refer to the entries, they are sent once the entries are in APP_DB */
+void NatSync::queueTimeoutNotification(const string &op, const string &key, const vector<FieldValueTuple> &values)
+{
+    m_pendingNotifications.emplace_back(key, op, values);
+}
+
+/* Write the NAT entries of all conntrack notifications read in this select iteration */
+void NatSync::flush()
+{
+    if (m_pendingEntries.empty())
+    {
+        return;
+    }
+
+    /* All NAT tables share the APP_DB pipeline */
+    m_natTable.flush();
+
+    for (const auto &notification : m_pendingNotifications)
+    {
+        setTimeoutNotifier->send(kfvOp(notification), kfvKey(notification), kfvFieldsValues(notification));
+    }
+
+    m_pendingEntries.clear();
+    m_pendingNotifications.clear();
+}
+
+/*
+ * Attach a filter which drops the conntrack notifications of non IPv4
+ * connections in the kernel, and enlarge the receive buffer to absorb
+ * bursts of new connections.
+ */
+void NatSync::configureConntrackSocket()
+{
+    int fd = nfsock->getFd();
+    int rcvbuf = NATSYNC_RCVBUF_SIZE;
+
+    /*
+     * nlmsg_type is in host byte order while BPF loads are in network byte
+     * order, so the type is compared in network byte order.
+     * ldh [4]; and 0xff00; jeq CTNETLINK ? check family : accept
+     * ldb [16]; jeq AF_INET ? accept : drop
+     */
+    struct sock_filter code[] = {
+        BPF_STMT(BPF_LD  | BPF_H | BPF_ABS, offsetof(struct nlmsghdr, nlmsg_type)),
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, htons(0xff00)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(NFNL_SUBSYS_CTNETLINK << 8), 0, 2),
+        BPF_STMT(BPF_LD  | BPF_B | BPF_ABS, NLMSG_HDRLEN + offsetof(struct nfgenmsg, nfgen_family)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, AF_INET, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+    struct sock_fprog filter = { (unsigned short)(sizeof(code) / sizeof(code[0])), code };
+
+    if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &filter, sizeof(filter)) < 0)
+    {
+        SWSS_LOG_WARN("Failed to attach conntrack notification filter: %s", strerror(errno));
+    }
+
+    /* Bypass net.core.rmem_max, natsyncd runs with CAP_NET_ADMIN */
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf)) < 0 &&
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)) < 0)
+    {
+        SWSS_LOG_WARN("Failed to set conntrack socket receive buffer to %d: %s", rcvbuf, strerror(errno));
+    }
+}
+
+/* Notifications dropped by the kernel because the socket receive buffer was full */
+uint64_t NatSync::getSocketDrops()
+{
+    struct sockaddr_nl addr;
+    socklen_t len = sizeof(addr);
+
+    if (getsockname(nfsock->getFd(), (struct sockaddr *)&addr, &len) < 0)
+    {
+        return 0;
+    }
+
+    /* sk Eth Pid Groups Rmem Wmem Dump Locks Drops Inode */
+    ifstream netlink("/proc/net/netlink");
+    string line;
+    getline(netlink, line);
+    while (getline(netlink, line))
+    {
+        istringstream iss(line);
+        string sk;
+        int protocol;
+        uint32_t pid;
+        string groups, rmem, wmem, dump, locks;
+        uint64_t drops;
+
+        if (!(iss >> sk >> protocol >> pid >> groups >> rmem >> wmem >> dump >> locks >> drops))
+        {
+            continue;
+        }
+        if (protocol == NETLINK_NETFILTER && pid == addr.nl_pid)
+        {
+            return drops;
+        }
+    }
+
+    return 0;
+}
+
+void NatSync::writeStats()
+{
+    uint64_t drops = getSocketDrops();
+
+    if (drops != m_socketDrops)
+    {
+        SWSS_LOG_WARN("Conntrack notifications dropped by the kernel: %" PRIu64 " (total %" PRIu64 ")",
+                      drops - m_socketDrops, drops);
+        m_socketDrops = drops;
+    }
+
+    vector<FieldValueTuple> fvVector;
+    fvVector.emplace_back("events", to_string(m_ctEvents));
+    fvVector.emplace_back("ignored_events", to_string(m_ctIgnoredEvents));
+    fvVector.emplace_back("socket_drops", to_string(m_socketDrops));
+    m_stateNatSyncStatsTable.set("conntrack", fvVector);
+}
+
 /* Conntrack notifications from the kernel don't have a flag to indicate if the
  * NAT is NAPT or basic NAT. The original L4 port and the translated L4 port may 
  * be the same and still can be the NAPT (can happen if the original L4 port is
@@ -319,7 +489,7 @@ bool NatSync::matchingSnaptEntryExists(const naptEntry &entry)
     string reverseEntryKey = entry.nat_src_ip.to_string() + ":" + to_string(entry.nat_src_l4_port);
     std::vector<FieldValueTuple> values;
 
-    if (m_naptCheckTable.get(key, values) || m_naptCheckTable.get(reverseEntryKey, values))
+    if (getNatEntry(m_naptCheckTable, key, values) || getNatEntry(m_naptCheckTable, reverseEntryKey, values))
     {
         SWSS_LOG_INFO("Matching SNAPT entry exists for key %s or reverse key %s",
                        key.c_str(), reverseEntryKey.c_str());
@@ -334,7 +504,7 @@ bool NatSync::matchingDnaptEntryExists(const naptEntry &entry)
     string reverseEntryKey = entry.nat_dest_ip.to_string() + ":" + to_string(entry.nat_dst_l4_port);
     std::vector<FieldValueTuple> values;
 
-    if (m_naptCheckTable.get(key, values) || m_naptCheckTable.get(reverseEntryKey, values))
+    if (getNatEntry(m_naptCheckTable, key, values) || getNatEntry(m_naptCheckTable, reverseEntryKey, values))
     {
         SWSS_LOG_INFO("Matching DNAPT entry exists for key %s or reverse key %s",
                        key.c_str(), reverseEntryKey.c_str());
@@ -401,7 +571,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
         string tmpReverseEntryKey = reverseEntryKey + entry.nat_dest_ip.to_string() + ":" + entry.nat_src_ip.to_string();
 
         std::vector<FieldValueTuple> values;
-        if (m_twiceNatCheckTable.get(tmpKey, values))
+        if (getNatEntry(m_twiceNatCheckTable, tmpKey, values))
         {
             src_port_natted = dst_port_natted = false;
 
@@ -449,7 +619,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
             std::vector<FieldValueTuple> values;
             /* If a matching Static Twice NAPT entry exists in the APP_DB,
              * it has higher priority than the dynamic twice napt entry. */
-            if (m_twiceNaptCheckTable.get(key, values))
+            if (getNatEntry(m_twiceNaptCheckTable, key, values))
             {
                 for (auto iter : values)
                 {
@@ -490,10 +660,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_naptTwiceTable.set(key, fvVector);
+                    setNatEntry(m_naptTwiceTable, key, fvVector);
                     SWSS_LOG_NOTICE("Twice NAPT entry with key %s added to APP_DB", key.c_str());
-                    setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
-                    m_naptTwiceTable.set(reverseEntryKey, reverseFvVector);
+                    queueTimeoutNotification("SET-TWICE-NAPT", key, fvVector);
+                    setNatEntry(m_naptTwiceTable, reverseEntryKey, reverseFvVector);
                     SWSS_LOG_NOTICE("Twice NAPT entry with reverse key %s added to APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -506,9 +676,9 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_naptTwiceTable.del(key);
+                    delNatEntry(m_naptTwiceTable, key);
                     SWSS_LOG_NOTICE("Twice NAPT entry with key %s deleted from APP_DB", key.c_str());
-                    m_naptTwiceTable.del(reverseEntryKey);
+                    delNatEntry(m_naptTwiceTable, reverseEntryKey);
                     SWSS_LOG_NOTICE("Twice NAPT entry with reverse key %s deleted from APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -531,10 +701,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_natTwiceTable.set(key, fvVector);
+                    setNatEntry(m_natTwiceTable, key, fvVector);
                     SWSS_LOG_NOTICE("Twice NAT entry with key %s added to APP_DB", key.c_str());
-                    setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
-                    m_natTwiceTable.set(reverseEntryKey, reverseFvVector);
+                    queueTimeoutNotification("SET-TWICE-NAT", key, fvVector);
+                    setNatEntry(m_natTwiceTable, reverseEntryKey, reverseFvVector);
                     SWSS_LOG_NOTICE("Twice NAT entry with reverse key %s added to APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -547,9 +717,9 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_natTwiceTable.del(key);
+                    delNatEntry(m_natTwiceTable, key);
                     SWSS_LOG_NOTICE("Twice NAT entry with key %s deleted from APP_DB", key.c_str());
-                    m_natTwiceTable.del(reverseEntryKey);
+                    delNatEntry(m_natTwiceTable, reverseEntryKey);
                     SWSS_LOG_NOTICE("Twice NAT entry with reverse key %s deleted from APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -593,7 +763,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                  * is matched by the iptables rules corresponding to the dnat static entry */
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_naptCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_naptCheckTable, key, values)))
                     {
                         for (auto iter : values)
                         {
@@ -621,12 +791,12 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_naptTable.del(key);
+                                delNatEntry(m_naptTable, key);
                                 SWSS_LOG_NOTICE("SNAPT entry with key %s deleted from APP_DB", key.c_str());
                             }
                         }
                     }
-                    if ((reverseEntryExists = m_naptCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = getNatEntry(m_naptCheckTable, reverseEntryKey, values)))
                     {
                         for (auto iter : values)
                         {
@@ -654,7 +824,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_naptTable.del(reverseEntryKey);
+                                delNatEntry(m_naptTable, reverseEntryKey);
                                 SWSS_LOG_NOTICE("Implicit DNAPT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                             }
                         }
@@ -684,10 +854,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.set(key, fvVector);
+                            setNatEntry(m_naptTable, key, fvVector);
                             SWSS_LOG_NOTICE("SNAPT entry with key %s added to APP_DB", key.c_str());
-                            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
-                            m_naptTable.set(reverseEntryKey, reverseFvVector);
+                            queueTimeoutNotification("SET-SINGLE-NAPT", key, fvVector);
+                            setNatEntry(m_naptTable, reverseEntryKey, reverseFvVector);
                             SWSS_LOG_NOTICE("Implicit DNAPT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -704,7 +874,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 std::vector<FieldValueTuple> values;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_natCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_natCheckTable, key, values)))
                     {
                         for (auto iter : values)
                         {
@@ -732,12 +902,12 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_natTable.del(key);
+                                delNatEntry(m_natTable, key);
                                 SWSS_LOG_NOTICE("SNAT entry with key %s deleted from APP_DB", key.c_str());
                             }
                         }
                     }
-                    if ((reverseEntryExists = m_natCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = getNatEntry(m_natCheckTable, reverseEntryKey, values)))
                     {
                         for (auto iter : values)
                         {
@@ -765,7 +935,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_natTable.del(reverseEntryKey);
+                                delNatEntry(m_natTable, reverseEntryKey);
                                 SWSS_LOG_NOTICE("Implicit DNAT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                             }
                         }
@@ -789,10 +959,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_natTable.set(key, fvVector);
+                            setNatEntry(m_natTable, key, fvVector);
                             SWSS_LOG_NOTICE("SNAT entry with key %s added to APP_DB", key.c_str());
-                            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
-                            m_natTable.set(reverseEntryKey, reverseFvVector);
+                            queueTimeoutNotification("SET-SINGLE-NAT", key, fvVector);
+                            setNatEntry(m_natTable, reverseEntryKey, reverseFvVector);
                             SWSS_LOG_NOTICE("Implicit DNAT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -832,7 +1002,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 std::vector<FieldValueTuple> values;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_naptCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_naptCheckTable, key, values)))
                     {
                         for (auto iter : values)
                         {
@@ -851,11 +1021,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.del(key);
+                            delNatEntry(m_naptTable, key);
                             SWSS_LOG_NOTICE("DNAPT entry with key %s deleted from APP_DB", key.c_str());
                         }
                      }
-                     if ((reverseEntryExists = m_naptCheckTable.get(reverseEntryKey, values)))
+                     if ((reverseEntryExists = getNatEntry(m_naptCheckTable, reverseEntryKey, values)))
                      {
                         for (auto iter : values)
                         {
@@ -874,7 +1044,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.del(reverseEntryKey);
+                            delNatEntry(m_naptTable, reverseEntryKey);
                             SWSS_LOG_NOTICE("Implicit SNAPT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -894,10 +1064,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                     }
                     else
                     {
-                        m_naptTable.set(key, fvVector);
+                        setNatEntry(m_naptTable, key, fvVector);
                         SWSS_LOG_NOTICE("DNAPT entry with key %s added to APP_DB", key.c_str());
-                        setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
-                        m_naptTable.set(reverseEntryKey, reverseFvVector);
+                        queueTimeoutNotification("SET-SINGLE-NAPT", key, fvVector);
+                        setNatEntry(m_naptTable, reverseEntryKey, reverseFvVector);
                         SWSS_LOG_NOTICE("Implicit SNAPT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                     }
                 }
@@ -912,7 +1082,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 std::vector<FieldValueTuple> values;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_natCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_natCheckTable, key, values)))
                     {
                         for (auto iter : values)
                         {
@@ -931,11 +1101,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         { 
-                            m_natTable.del(key);
+                            delNatEntry(m_natTable, key);
                             SWSS_LOG_NOTICE("DNAT entry with key %s deleted from APP_DB", key.c_str());
                         }
                     }
-                    if ((reverseEntryExists = m_natCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = getNatEntry(m_natCheckTable, reverseEntryKey, values)))
                     {
                         for (auto iter : values)
                         {
@@ -954,7 +1124,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         { 
-                            m_natTable.del(reverseEntryKey);
+                            delNatEntry(m_natTable, reverseEntryKey);
                             SWSS_LOG_NOTICE("Implicit SNAT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -968,10 +1138,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                     }
                     else
                     {
-                        m_natTable.set(key, fvVector);
+                        setNatEntry(m_natTable, key, fvVector);
                         SWSS_LOG_NOTICE("DNAT entry with key %s added to APP_DB", key.c_str());
-                        setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
-                        m_natTable.set(reverseEntryKey, reverseFvVector);
+                        queueTimeoutNotification("SET-SINGLE-NAT", key, fvVector);
+                        setNatEntry(m_natTable, reverseEntryKey, reverseFvVector);
                         SWSS_LOG_NOTICE("Implicit SNAT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                     }
                 }
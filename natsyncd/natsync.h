@@ -24,6 +24,9 @@
 #include "warmRestartAssist.h"
 #include "ipaddress.h"
 #include "nfnetlink.h"
+#include "selectabletimer.h"
+#include <unordered_map>
+#include <vector>
 #include <linux/netfilter/nfnetlink_conntrack.h>
 #include <linux/netfilter/nf_conntrack_common.h>
 #include <unistd.h>
@@ -36,6 +39,14 @@
 
 #define RESTORE_NAT_WAIT_TIME_OUT 120
 
+// Receive buffer size (in bytes) of the conntrack notification socket
+#define NATSYNC_RCVBUF_SIZE (64 * 1024 * 1024)
+
+// The interval (in seconds) of conntrack statistics updates in STATE_DB
+#define NATSYNC_STATS_INTERVAL 10
+
+#define STATE_NAT_SYNC_STATS_TABLE_NAME "NAT_SYNC_STATS"
+
 namespace swss {
 
 struct naptEntry;
@@ -56,7 +67,38 @@ public:
         return m_AppRestartAssist;
     }
 
+    SelectableTimer *getStatsTimer()
+    {
+        return &m_statsTimer;
+    }
+
+    bool checkStatsTimer(Selectable *s)
+    {
+        return s == &m_statsTimer;
+    }
+
+    /* Write the NAT entries buffered in this select iteration to APP_DB */
+    void flush();
+
+    /* Write the conntrack notification counters to STATE_DB */
+    void writeStats();
+
 private:
+    struct PendingNatEntry
+    {
+        bool del;
+        std::vector<FieldValueTuple> fvVector;
+    };
+
+    void        configureConntrackSocket();
+    uint64_t    getSocketDrops();
+
+    bool        getNatEntry(Table &checkTable, const std::string &key, std::vector<FieldValueTuple> &values);
+    void        setNatEntry(ProducerStateTable &table, const std::string &key, const std::vector<FieldValueTuple> &values);
+    void        delNatEntry(ProducerStateTable &table, const std::string &key);
+    void        queueTimeoutNotification(const std::string &op, const std::string &key,
+                                         const std::vector<FieldValueTuple> &values);
+
     static int  parseConnTrackMsg(const struct nfnl_ct *ct, struct naptEntry &entry);
     void        updateConnTrackEntry(struct nfnl_ct *ct);
     void        deleteConnTrackEntry(struct nfnl_ct *ct);
@@ -80,9 +122,19 @@ private:
     Table              m_twiceNaptCheckTable;
 
     Table              m_stateNatRestoreTable;
+    Table              m_stateNatSyncStatsTable;
     AppRestartAssist  *m_AppRestartAssist;
 
     NfNetlink          *nfsock;
+
+    /* Buffered writes per table and key, seen by the lookups until they are flushed */
+    std::unordered_map<std::string, std::unordered_map<std::string, PendingNatEntry>> m_pendingEntries;
+    std::vector<KeyOpFieldsValuesTuple> m_pendingNotifications;
+
+    SelectableTimer    m_statsTimer;
+    uint64_t           m_ctEvents = 0;
+    uint64_t           m_ctIgnoredEvents = 0;
+    uint64_t           m_socketDrops = 0;
 };
 
 struct naptEntry
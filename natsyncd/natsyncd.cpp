@@ -71,10 +71,16 @@ int main(int argc, char **argv)
             nfnl.dumpRequest(IPCTNL_MSG_CT_GET);
 
             s.addSelectable(&nfnl);
+            s.addSelectable(sync.getStatsTimer());
             while (true)
             {
                 Selectable *temps;
                 s.select(&temps);
+
+                if (sync.checkStatsTimer(temps))
+                {
+                    sync.writeStats();
+                }
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
@@ -87,6 +93,9 @@ int main(int argc, char **argv)
                         sync.getRestartAssist()->reconcile();
                     }
                 }
+
+                /* Write the NAT entries of the conntrack notifications read in this iteration */
+                sync.flush();
             }
         }
         catch (const std::exception& e)
@@ -18,8 +18,10 @@ using namespace std;
 using namespace swss;
 
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb) :
-    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
-    m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME)
+    m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
+    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME, true),
+    m_flushTimer(timespec{0, DEFAULT_NEIGHSYNC_FLUSH_INTERVAL_MS * 1000 * 1000}),
+    m_flushTimerRunning(false)
 {
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", DEFAULT_NEIGHSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
@@ -50,6 +52,52 @@ bool NeighSync::isNeighRestoreDone()
     return false;
 }
 
+static void onKernelNeighDump(struct nl_object *obj, void *arg)
+{
+    NeighSync *sync = static_cast<NeighSync *>(arg);
+
+    sync->onMsg(RTM_NEWNEIGH, obj);
+}
+
+bool NeighSync::reconcileFromKernelDump()
+{
+    struct nl_sock *sock = nl_socket_alloc();
+    struct nl_cache *neighCache = NULL;
+    int err = 0;
+
+    if (!sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket alloc failed");
+        return false;
+    }
+
+    if ((err = nl_connect(sock, NETLINK_ROUTE)) < 0)
+    {
+        SWSS_LOG_ERROR("Netlink socket connect failed, error '%s'", nl_geterror(err));
+        nl_socket_free(sock);
+        return false;
+    }
+
+    // A single RTM_GETNEIGH dump returns the complete kernel neighbor table
+    if ((err = rtnl_neigh_alloc_cache(sock, &neighCache)) < 0)
+    {
+        SWSS_LOG_ERROR("Neighbor table dump failed, error '%s'", nl_geterror(err));
+        nl_socket_free(sock);
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("Dumped %d kernel neighbors for reconciliation", nl_cache_nitems(neighCache));
+
+    // Every dumped entry is marked SAME or NEW in the cache map, the rest stay STALE
+    nl_cache_foreach(neighCache, onKernelNeighDump, this);
+
+    nl_cache_free(neighCache);
+    nl_socket_free(sock);
+
+    m_AppRestartAssist->reconcile();
+    return true;
+}
+
 void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
 {
     char ipStr[MAX_ADDR_SIZE + 1] = {0};
@@ -103,24 +151,102 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
-    std::vector<FieldValueTuple> fvVector;
-    FieldValueTuple f("family", family);
-    FieldValueTuple nh("neigh", macStr);
-    fvVector.push_back(nh);
-    fvVector.push_back(f);
-
     // If warmstart is in progress, we take all netlink changes into the cache map
     if (m_AppRestartAssist->isWarmStartInProgress())
     {
+        std::vector<FieldValueTuple> fvVector;
+        FieldValueTuple f("family", family);
+        FieldValueTuple nh("neigh", macStr);
+        fvVector.push_back(nh);
+        fvVector.push_back(f);
+
         m_AppRestartAssist->insertToMap(APP_NEIGH_TABLE_NAME, key, fvVector, delete_key);
     }
     else
     {
-        if (delete_key == true)
+        addPendingNeighbor(key, NeighEntry{macStr, family}, delete_key);
+    }
+}
+
+/*
+ * Record the update for the key, overriding whatever is still pending for it.
+ * The flush timer is armed on the first pending entry so that a burst of
+ * updates is written out together once the interval expires.
+ */
+void NeighSync::addPendingNeighbor(const string &key, const NeighEntry &entry, bool delete_key)
+{
+    m_pendingNeighbors[key] = PendingNeighUpdate{delete_key, entry};
+
+    if (m_pendingNeighbors.size() >= NEIGHSYNC_MAX_PENDING_ENTRIES)
+    {
+        flushPendingNeighbors();
+        return;
+    }
+
+    if (!m_flushTimerRunning)
+    {
+        m_flushTimer.start();
+        m_flushTimerRunning = true;
+    }
+}
+
+void NeighSync::flushPendingNeighbors()
+{
+    if (m_flushTimerRunning)
+    {
+        m_flushTimer.stop();
+        m_flushTimerRunning = false;
+    }
+
+    if (m_pendingNeighbors.empty())
+    {
+        return;
+    }
+
+    size_t written = 0;
+    for (const auto &it : m_pendingNeighbors)
+    {
+        const string &key = it.first;
+        const PendingNeighUpdate &update = it.second;
+        auto cached = m_neighCache.find(key);
+
+        if (update.del)
         {
+            /*
+             * Keys which were never written by this instance (e.g. restored
+             * on warm start) are still deleted, as APP_DB may hold them.
+             */
+            if (cached != m_neighCache.end())
+            {
+                m_neighCache.erase(cached);
+            }
             m_neighTable.del(key);
-            return;
+            written++;
+            continue;
         }
+
+        if (cached != m_neighCache.end() &&
+            cached->second.mac == update.entry.mac &&
+            cached->second.family == update.entry.family)
+        {
+            SWSS_LOG_DEBUG("Skip unchanged neighbor %s", key.c_str());
+            continue;
+        }
+
+        std::vector<FieldValueTuple> fvVector;
+        FieldValueTuple f("family", update.entry.family);
+        FieldValueTuple nh("neigh", update.entry.mac);
+        fvVector.push_back(nh);
+        fvVector.push_back(f);
+
         m_neighTable.set(key, fvVector);
+        m_neighCache[key] = update.entry;
+        written++;
     }
+
+    SWSS_LOG_INFO("Flushed %zu of %zu pending neighbor updates",
+                  written, m_pendingNeighbors.size());
+
+    m_pendingNeighbors.clear();
+    m_neighTable.flush();
 }
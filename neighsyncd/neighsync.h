@@ -1,8 +1,10 @@
 #ifndef __NEIGHSYNC__
 #define __NEIGHSYNC__
 
+#include <unordered_map>
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "selectabletimer.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
 
@@ -16,6 +18,15 @@
  */
 #define RESTORE_NEIGH_WAIT_TIME_OUT 120
 
+/*
+ * Neighbor updates are coalesced per (ifname, ip) key for this interval (in
+ * milliseconds) before being flushed to APP_DB as a single pipelined batch.
+ */
+#define DEFAULT_NEIGHSYNC_FLUSH_INTERVAL_MS 50
+
+// Number of pending neighbor updates which triggers a flush before the interval expires
+#define NEIGHSYNC_MAX_PENDING_ENTRIES 1024
+
 namespace swss {
 
 class NeighSync : public NetMsg
@@ -30,15 +41,59 @@ public:
 
     bool isNeighRestoreDone();
 
+    /*
+     * Warm start only: dump the kernel neighbor table once, compare it with
+     * the cached APP_DB entries and reconcile the delta right away instead
+     * of waiting for the reconcile timer. Returns false if the dump failed.
+     */
+    bool reconcileFromKernelDump();
+
     AppRestartAssist *getRestartAssist()
     {
         return m_AppRestartAssist;
     }
 
+    SelectableTimer *getFlushTimer()
+    {
+        return &m_flushTimer;
+    }
+
+    bool checkFlushTimer(Selectable *s)
+    {
+        return s == &m_flushTimer;
+    }
+
+    // Write the coalesced pending updates to APP_DB in one batch
+    void flushPendingNeighbors();
+
 private:
+    struct NeighEntry
+    {
+        std::string mac;
+        std::string family;
+    };
+
+    struct PendingNeighUpdate
+    {
+        bool       del;
+        NeighEntry entry;
+    };
+
+    void addPendingNeighbor(const std::string &key, const NeighEntry &entry, bool delete_key);
+
     Table m_stateNeighRestoreTable;
     ProducerStateTable m_neighTable;
     AppRestartAssist  *m_AppRestartAssist;
+
+    /*
+     * Latest update received for each key since the last flush. Transient
+     * state churn (e.g. REACHABLE -> STALE -> PROBE) collapses into one entry.
+     */
+    std::unordered_map<std::string, PendingNeighUpdate> m_pendingNeighbors;
+    // Last MAC/family written to APP_DB for each key, used to drop no-op rewrites
+    std::unordered_map<std::string, NeighEntry> m_neighCache;
+    SelectableTimer m_flushTimer;
+    bool m_flushTimerRunning;
 };
 
 }
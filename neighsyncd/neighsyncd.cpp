@@ -36,8 +36,10 @@ int main(int argc, char **argv)
              * If warmstart, read neighbor table to cache map.
              * Wait the kernel neighbor table restore to finish in case of warmreboot.
              * Regular swss docker warmstart should have marked the restore flag to true always.
-             * Start reconcile timer once restore flag is set
+             * Once restore flag is set, reconcile against a single kernel neighbor table dump.
+             * Start reconcile timer only if the dump could not be taken.
              */
+            bool dumpReconciled = false;
             if (sync.getRestartAssist()->isWarmStartInProgress())
             {
                 sync.getRestartAssist()->readTablesToMap();
@@ -58,18 +60,41 @@ int main(int argc, char **argv)
                     }
                     sleep(1);
                 }
-                sync.getRestartAssist()->startReconcileTimer(s);
             }
 
+            /*
+             * Subscribe before the reconcile dump so that changes racing with
+             * the dump are queued and applied on top of the reconciled table.
+             */
             netlink.registerGroup(RTNLGRP_NEIGH);
             cout << "Listens to neigh messages..." << endl;
-            netlink.dumpRequest(RTM_GETNEIGH);
+
+            if (sync.getRestartAssist()->isWarmStartInProgress())
+            {
+                dumpReconciled = sync.reconcileFromKernelDump();
+                if (!dumpReconciled)
+                {
+                    sync.getRestartAssist()->startReconcileTimer(s);
+                }
+            }
+
+            if (!dumpReconciled)
+            {
+                netlink.dumpRequest(RTM_GETNEIGH);
+            }
 
             s.addSelectable(&netlink);
+            s.addSelectable(sync.getFlushTimer());
             while (true)
             {
                 Selectable *temps;
                 s.select(&temps);
+
+                // Coalescing interval expired, write pending neighbor updates
+                if (sync.checkFlushTimer(temps))
+                {
+                    sync.flushPendingNeighbors();
+                }
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
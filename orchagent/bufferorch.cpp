@@ -3,8 +3,10 @@
 #include "logger.h"
 #include "sai_serialize.h"
 #include "warm_restart.h"
+#include "watermarkaggregator.h"
 
 #include <inttypes.h>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
@@ -17,8 +19,7 @@ extern sai_buffer_api_t *sai_buffer_api;
 
 extern PortsOrch *gPortsOrch;
 extern sai_object_id_t gSwitchId;
-
-#define BUFFER_POOL_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS  "10000"
+extern size_t gMaxBulkSize;
 
 
 static const vector<sai_buffer_pool_stat_t> bufferPoolWatermarkStatIds =
@@ -42,7 +43,9 @@ BufferOrch::BufferOrch(DBConnector *applDb, DBConnector *confDb, DBConnector *st
     m_flexCounterTable(new ProducerTable(m_flexCounterDb.get(), FLEX_COUNTER_TABLE)),
     m_flexCounterGroupTable(new ProducerTable(m_flexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE)),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
-    m_stateBufferMaximumValueTable(stateDb, STATE_BUFFER_MAXIMUM_VALUE_TABLE)
+    m_stateBufferMaximumValueTable(stateDb, STATE_BUFFER_MAXIMUM_VALUE_TABLE),
+    m_queueBulker(sai_queue_api, gSwitchId, gMaxBulkSize),
+    m_priorityGroupBulker(sai_buffer_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
     initTableHandlers();
@@ -166,11 +169,15 @@ void BufferOrch::initFlexCounterGroupTable(void)
 
     try
     {
-        string bufferPoolLuaScript = swss::loadLuaScript(bufferPoolWmPluginName);
-        string bufferPoolWmSha = swss::loadRedisScript(m_countersDb.get(), bufferPoolLuaScript);
-
         vector<FieldValueTuple> fvTuples;
-        fvTuples.emplace_back(BUFFER_POOL_PLUGIN_FIELD, bufferPoolWmSha);
+
+        // Watermarks are aggregated by WatermarkOrch in native mode
+        if (!isNativeWatermarkMode("BUFFER_POOL_WATERMARK"))
+        {
+            string bufferPoolLuaScript = swss::loadLuaScript(bufferPoolWmPluginName);
+            string bufferPoolWmSha = swss::loadRedisScript(m_countersDb.get(), bufferPoolLuaScript);
+            fvTuples.emplace_back(BUFFER_POOL_PLUGIN_FIELD, bufferPoolWmSha);
+        }
         fvTuples.emplace_back(POLL_INTERVAL_FIELD, BUFFER_POOL_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
 
         m_flexCounterGroupTable->set(BUFFER_POOL_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, fvTuples);
@@ -736,9 +743,7 @@ task_process_status BufferOrch::processQueue(KeyOpFieldsValuesTuple &tuple)
         return task_process_status::task_invalid_entry;
     }
 
-    sai_attribute_t attr;
-    attr.id = SAI_QUEUE_ATTR_BUFFER_PROFILE_ID;
-    attr.value.oid = sai_buffer_profile;
+    vector<sai_object_id_t> queue_ids;
     for (string port_name : port_names)
     {
         Port port;
@@ -764,38 +769,19 @@ task_process_status BufferOrch::processQueue(KeyOpFieldsValuesTuple &tuple)
             }
             queue_id = port.m_queue_ids[ind];
             SWSS_LOG_DEBUG("Applying buffer profile:0x%" PRIx64 " to queue index:%zd, queue sai_id:0x%" PRIx64, sai_buffer_profile, ind, queue_id);
-            sai_status_t sai_status = sai_queue_api->set_queue_attribute(queue_id, &attr);
-            if (sai_status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to set queue's buffer profile attribute, status:%d", sai_status);
-                task_process_status handle_status = handleSaiSetStatus(SAI_API_QUEUE, sai_status);
-                if (handle_status != task_process_status::task_success)
-                {
-                    return handle_status;
-                }
-            }
+            queue_ids.push_back(queue_id);
         }
     }
 
-    if (m_ready_list.find(key) != m_ready_list.end())
-    {
-        m_ready_list[key] = true;
-    }
-    else
+    sai_attribute_t attr;
+    attr.id = SAI_QUEUE_ATTR_BUFFER_PROFILE_ID;
+    attr.value.oid = sai_buffer_profile;
+    m_bufferProfileSets.push_back({ tuple, SAI_API_QUEUE, {} });
+    auto &sets = m_bufferProfileSets.back();
+    for (auto queue_id : queue_ids)
     {
-        // If a buffer queue profile is not in the initial CONFIG_DB BUFFER_QUEUE table
-        // at BufferOrch object instantiation, it is considered being applied
-        // at run time, and, in this case, is not tracked in the m_ready_list. It is up to
-        // the application to guarantee the set order that the buffer queue profile
-        // should be applied to a physical port before the physical port is brought up to
-        // carry traffic. Here, we alert to application through syslog when such a wrong
-        // set order is detected.
-        for (const auto &port_name : port_names)
-        {
-            if (gPortsOrch->isPortAdminUp(port_name)) {
-                SWSS_LOG_WARN("Queue profile '%s' applied after port %s is up", key.c_str(), port_name.c_str());
-            }
-        }
+        sets.statuses.emplace_back();
+        m_queueBulker.set_entry_attribute(&sets.statuses.back(), queue_id, &attr);
     }
 
     return task_process_status::task_success;
@@ -859,9 +845,7 @@ task_process_status BufferOrch::processPriorityGroup(KeyOpFieldsValuesTuple &tup
         return task_process_status::task_invalid_entry;
     }
 
-    sai_attribute_t attr;
-    attr.id = SAI_INGRESS_PRIORITY_GROUP_ATTR_BUFFER_PROFILE;
-    attr.value.oid = sai_buffer_profile;
+    vector<sai_object_id_t> pg_ids;
     for (string port_name : port_names)
     {
         Port port;
@@ -891,16 +875,7 @@ task_process_status BufferOrch::processPriorityGroup(KeyOpFieldsValuesTuple &tup
             {
                 pg_id = port.m_priority_group_ids[ind];
                 SWSS_LOG_DEBUG("Applying buffer profile:0x%" PRIx64 " to port:%s pg index:%zd, pg sai_id:0x%" PRIx64, sai_buffer_profile, port_name.c_str(), ind, pg_id);
-                sai_status_t sai_status = sai_buffer_api->set_ingress_priority_group_attribute(pg_id, &attr);
-                if (sai_status != SAI_STATUS_SUCCESS)
-                {
-                    SWSS_LOG_ERROR("Failed to set port:%s pg:%zd buffer profile attribute, status:%d", port_name.c_str(), ind, sai_status);
-                    task_process_status handle_status = handleSaiSetStatus(SAI_API_BUFFER, sai_status);
-                    if (handle_status != task_process_status::task_success)
-                    {
-                        return handle_status;
-                    }
-                }
+                pg_ids.push_back(pg_id);
             }
         }
         if (portUpdated)
@@ -909,28 +884,84 @@ task_process_status BufferOrch::processPriorityGroup(KeyOpFieldsValuesTuple &tup
         }
     }
 
+    sai_attribute_t attr;
+    attr.id = SAI_INGRESS_PRIORITY_GROUP_ATTR_BUFFER_PROFILE;
+    attr.value.oid = sai_buffer_profile;
+    m_bufferProfileSets.push_back({ tuple, SAI_API_BUFFER, {} });
+    auto &sets = m_bufferProfileSets.back();
+    for (auto pg_id : pg_ids)
+    {
+        sets.statuses.emplace_back();
+        m_priorityGroupBulker.set_entry_attribute(&sets.statuses.back(), pg_id, &attr);
+    }
+
+    return task_process_status::task_success;
+}
+
+/*
+Set the buffer profiles queued by processQueue and processPriorityGroup. An
+entry is marked ready once all its queues or PGs are set.
+*/
+void BufferOrch::flushBufferProfileSets(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_bufferProfileSets.empty())
+    {
+        return;
+    }
+
+    m_queueBulker.flush();
+    m_priorityGroupBulker.flush();
+
+    for (const auto &sets : m_bufferProfileSets)
+    {
+        const string key = kfvKey(sets.tuple);
+        auto failed = find_if(sets.statuses.begin(), sets.statuses.end(),
+                              [](sai_status_t status) { return status != SAI_STATUS_SUCCESS; });
+        if (failed != sets.statuses.end())
+        {
+            SWSS_LOG_ERROR("Failed to set buffer profile of %s, status:%d", key.c_str(), *failed);
+            task_process_status handle_status = handleSaiSetStatus(sets.api, *failed);
+            // A newer update of the entry replaces the retry
+            if (handle_status == task_process_status::task_need_retry &&
+                consumer.m_toSync.find(key) == consumer.m_toSync.end())
+            {
+                consumer.addToSync(sets.tuple);
+            }
+            continue;
+        }
+
+        markBufferReady(key, sets.api == SAI_API_QUEUE ? "Queue" : "PG");
+    }
+    m_bufferProfileSets.clear();
+}
+
+void BufferOrch::markBufferReady(const string &key, const string &object_type)
+{
+    SWSS_LOG_ENTER();
+
     if (m_ready_list.find(key) != m_ready_list.end())
     {
         m_ready_list[key] = true;
     }
     else
     {
-        // If a buffer pg profile is not in the initial CONFIG_DB BUFFER_PG table
-        // at BufferOrch object instantiation, it is considered being applied
+        // If a buffer queue or pg profile is not in the initial CONFIG_DB BUFFER_QUEUE or
+        // BUFFER_PG table at BufferOrch object instantiation, it is considered being applied
         // at run time, and, in this case, is not tracked in the m_ready_list. It is up to
-        // the application to guarantee the set order that the buffer pg profile
+        // the application to guarantee the set order that the buffer profile
         // should be applied to a physical port before the physical port is brought up to
         // carry traffic. Here, we alert to application through syslog when such a wrong
         // set order is detected.
+        vector<string> port_names = tokenize(tokenize(key, delimiter)[0], list_item_delimiter);
         for (const auto &port_name : port_names)
         {
             if (gPortsOrch->isPortAdminUp(port_name)) {
-                SWSS_LOG_WARN("PG profile '%s' applied after port %s is up", key.c_str(), port_name.c_str());
+                SWSS_LOG_WARN("%s profile '%s' applied after port %s is up", object_type.c_str(), key.c_str(), port_name.c_str());
             }
         }
     }
-
-    return task_process_status::task_success;
 }
 
 /*
@@ -1113,6 +1144,7 @@ void BufferOrch::doTask(Consumer &consumer)
             case task_process_status::task_failed:
                 SWSS_LOG_ERROR("Failed to process buffer task, drop it");
                 it = consumer.m_toSync.erase(it);
+                flushBufferProfileSets(consumer);
                 return;
             case task_process_status::task_need_retry:
                 SWSS_LOG_INFO("Failed to process buffer task, retry it");
@@ -1124,4 +1156,6 @@ void BufferOrch::doTask(Consumer &consumer)
                 break;
         }
     }
+
+    flushBufferProfileSets(consumer);
 }
@@ -3,12 +3,15 @@
 
 #include <string>
 #include <map>
+#include <deque>
 #include <unordered_map>
 #include "orch.h"
 #include "portsorch.h"
 #include "redisapi.h"
+#include "bulker.h"
 
 #define BUFFER_POOL_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP "BUFFER_POOL_WATERMARK_STAT_COUNTER"
+#define BUFFER_POOL_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS  "10000"
 
 const string buffer_size_field_name         = "size";
 const string buffer_pool_type_field_name    = "type";
@@ -56,6 +59,8 @@ private:
     task_process_status processPriorityGroup(KeyOpFieldsValuesTuple &tuple);
     task_process_status processIngressBufferProfileList(KeyOpFieldsValuesTuple &tuple);
     task_process_status processEgressBufferProfileList(KeyOpFieldsValuesTuple &tuple);
+    void flushBufferProfileSets(Consumer &consumer);
+    void markBufferReady(const string &key, const string &object_type);
 
     buffer_table_handler_map m_bufferHandlerMap;
     std::unordered_map<std::string, bool> m_ready_list;
@@ -70,6 +75,22 @@ private:
     unique_ptr<DBConnector> m_countersDb;
 
     bool m_isBufferPoolWatermarkCounterIdListGenerated = false;
+
+    /*
+     * Buffer profiles of queues and PGs are set at the end of each doTask
+     * pass, one SAI call per queue or PG. The statuses of each BUFFER_QUEUE or BUFFER_PG entry are
+     * checked after the flush, to retry or report the entry they came from.
+     */
+    struct BufferProfileSets
+    {
+        KeyOpFieldsValuesTuple tuple;
+        sai_api_t api;
+        std::deque<sai_status_t> statuses;
+    };
+
+    ObjectBulker<sai_queue_api_t> m_queueBulker;
+    ObjectBulker<sai_buffer_api_t> m_priorityGroupBulker;
+    std::deque<BufferProfileSets> m_bufferProfileSets;
 };
 #endif /* SWSS_BUFFORCH_H */
 
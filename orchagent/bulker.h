@@ -126,6 +126,12 @@ typedef sai_status_t (*sai_bulk_set_fdb_entry_attribute_fn)(
         _In_ const sai_attribute_t *attr_list,
         _In_ sai_bulk_op_error_mode_t mode,
         _Out_ sai_status_t *object_statuses);
+typedef sai_status_t (*sai_bulk_object_set_attribute_fn)(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
 
 template<typename T>
 struct SaiBulkerTraits { };
@@ -166,8 +172,7 @@ struct SaiBulkerTraits<sai_next_hop_group_api_t>
     using set_entry_attribute_fn = sai_set_next_hop_group_member_attribute_fn;
     using bulk_create_entry_fn = sai_bulk_object_create_fn;
     using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
-    // TODO: wait until available in SAI
-    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
 template<>
@@ -183,6 +188,46 @@ struct SaiBulkerTraits<sai_mpls_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_inseg_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_port_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_port_api_t;
+    using create_entry_fn = sai_create_port_fn;
+    using remove_entry_fn = sai_remove_port_fn;
+    using set_entry_attribute_fn = sai_set_port_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_queue_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_queue_api_t;
+    using create_entry_fn = sai_create_queue_fn;
+    using remove_entry_fn = sai_remove_queue_fn;
+    using set_entry_attribute_fn = sai_set_queue_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+// Ingress priority groups
+template<>
+struct SaiBulkerTraits<sai_buffer_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_buffer_api_t;
+    using create_entry_fn = sai_create_ingress_priority_group_fn;
+    using remove_entry_fn = sai_remove_ingress_priority_group_fn;
+    using set_entry_attribute_fn = sai_set_ingress_priority_group_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
 template <typename T>
 class EntityBulker
 {
@@ -622,6 +667,21 @@ public:
         return SAI_STATUS_NOT_EXECUTED;
     }
 
+    // Same as above, the status of the object creation is also returned in object_status
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        assert(object_status);
+        if (!object_status) throw std::invalid_argument("object_status is null");
+
+        creating_statuses[object_id] = object_status;
+        *object_status = create_entry(object_id, attr_count, attr_list);
+        return *object_status;
+    }
+
     sai_status_t remove_entry(
         _Out_ sai_status_t *object_status,
         _In_ sai_object_id_t object_id)
@@ -642,29 +702,24 @@ public:
         return *object_status;
     }
 
-    // TODO: wait until available in SAI
-    /*
-    sai_status_t set_entry_attribute(
+    void set_entry_attribute(
+        _Out_ sai_status_t *object_status,
         _In_ sai_object_id_t object_id,
         _In_ const sai_attribute_t *attr)
     {
-        auto found_setting = setting_entries.find(object_id);
-        if (found_setting != setting_entries.end())
-        {
-            // For simplicity, just insert new attribute at the vector end, no merging
-            found_setting->second.emplace_back(*attr);
-        }
-        else
-        {
-            // Create a new key if not exists in the map
-            setting_entries.emplace(std::piecewise_construct,
-                std::forward_as_tuple(object_id),
-                std::forward_as_tuple(1, *attr));
-        }
+        assert(object_status);
+        if (!object_status) throw std::invalid_argument("object_status is null");
+        assert(object_id != SAI_NULL_OBJECT_ID);
+        if (object_id == SAI_NULL_OBJECT_ID) throw std::invalid_argument("object_id is null");
+        assert(attr);
+        if (!attr) throw std::invalid_argument("attr is null");
 
-        return SAI_STATUS_SUCCESS;
+        // Attributes of an object are set in the order they are added
+        setting_entries[object_id].emplace_back(std::piecewise_construct,
+                std::forward_as_tuple(*attr),
+                std::forward_as_tuple(object_status));
+        *object_status = SAI_STATUS_NOT_EXECUTED;
     }
-    */
 
     void flush()
     {
@@ -717,42 +772,48 @@ public:
             flush_creating_entries(rs, tss, cs);
 
             creating_entries.clear();
+            creating_statuses.clear();
         }
 
         // Setting
-        // TODO: wait until available in SAI
-        /*
         if (!setting_entries.empty())
         {
             std::vector<sai_object_id_t> rs;
             std::vector<sai_attribute_t> ts;
+            std::vector<sai_status_t*> status_vector;
 
             for (auto const& i: setting_entries)
             {
                 auto const& entry = i.first;
                 auto const& attrs = i.second;
-                for (auto const& attr: attrs)
+                for (auto const& ia: attrs)
                 {
-                    rs.push_back(entry);
-                    ts.push_back(attr);
-
-                    if (rs.size() >= max_bulk_size)
+                    auto const& attr = ia.first;
+                    sai_status_t *object_status = ia.second;
+                    if (*object_status == SAI_STATUS_NOT_EXECUTED)
                     {
-                        flush_setting_entries(rs, ts);
+                        rs.push_back(entry);
+                        ts.push_back(attr);
+                        status_vector.push_back(object_status);
+
+                        if (rs.size() >= max_bulk_size)
+                        {
+                            flush_setting_entries(rs, ts, status_vector);
+                        }
                     }
                 }
             }
-            flush_setting_entries(rs, ts);
+            flush_setting_entries(rs, ts, status_vector);
 
             setting_entries.clear();
         }
-        */
     }
 
     void clear()
     {
         removing_entries.clear();
         creating_entries.clear();
+        creating_statuses.clear();
         setting_entries.clear();
     }
 
@@ -793,11 +854,18 @@ private:
             std::vector<sai_attribute_t>                    // - attrs
     >>                                                      creating_entries;
 
+                                                            // A map of
+                                                            // object_id -> object_status, for the
+                                                            // entries created with a status
+    std::unordered_map<sai_object_id_t *, sai_status_t *>   creating_statuses;
+
     std::unordered_map<                                     // A map of
-            sai_object_id_t,                                // object_id -> (OUT object_status, attributes)
-            std::pair<
-                    sai_status_t *,
-                    std::vector<sai_attribute_t>
+            sai_object_id_t,                                // object_id ->
+            std::vector<                                    //     vector of attribute and status
+                    std::pair<
+                            sai_attribute_t,                //     (attr_value, OUT object_status)
+                            sai_status_t *
+                    >
             >
     >                                                       setting_entries;
 
@@ -809,6 +877,8 @@ private:
     typename Ts::bulk_remove_entry_fn                       remove_entries;
     // TODO: wait until available in SAI
     //typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
+    // Queued sets are deferred, not bulked: one set call per attribute at flush time
+    typename Ts::set_entry_attribute_fn                     set_entry_attribute_fn = nullptr;
 
     sai_status_t flush_removing_entries(
         _Inout_ std::vector<sai_object_id_t> &rs)
@@ -870,6 +940,12 @@ private:
         {
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+
+            auto found_status = creating_statuses.find(pid);
+            if (found_status != creating_statuses.end())
+            {
+                *found_status->second = statuses[i];
+            }
         }
 
         rs.clear();
@@ -879,11 +955,10 @@ private:
         return status;
     }
 
-    // TODO: wait until available in SAI
-    /*
     sai_status_t flush_setting_entries(
         _Inout_ std::vector<sai_object_id_t> &rs,
-        _Inout_ std::vector<sai_attribute_t> &ts)
+        _Inout_ std::vector<sai_attribute_t> &ts,
+        _Inout_ std::vector<sai_status_t*> &status_vector)
     {
         if (rs.empty())
         {
@@ -891,8 +966,15 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
-        sai_status_t status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (size_t ir = 0; ir < count; ir++)
+        {
+            statuses[ir] = (*set_entry_attribute_fn)(rs[ir], &ts[ir]);
+            if (statuses[ir] != SAI_STATUS_SUCCESS)
+            {
+                status = statuses[ir];
+            }
+        }
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush setting_entries %zu\n", count);
@@ -903,12 +985,17 @@ private:
                             count, sai_serialize_status(status).c_str());
         }
 
+        for (size_t ir = 0; ir < count; ir++)
+        {
+            *status_vector[ir] = statuses[ir];
+        }
+
         rs.clear();
         ts.clear();
+        status_vector.clear();
 
         return status;
     }
-     */
 };
 
 template <>
@@ -918,6 +1005,36 @@ inline ObjectBulker<sai_next_hop_group_api_t>::ObjectBulker(SaiBulkerTraits<sai_
 {
     create_entries = api->create_next_hop_group_members;
     remove_entries = api->remove_next_hop_group_members;
-    // TODO: wait until available in SAI
-    //set_entries_attribute = ;
+    set_entry_attribute_fn = api->set_next_hop_group_member_attribute;
+}
+
+// Port, queue and PG bulkers only set attributes, the objects are created with the switch
+template <>
+inline ObjectBulker<sai_port_api_t>::ObjectBulker(SaiBulkerTraits<sai_port_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = nullptr;
+    remove_entries = nullptr;
+    set_entry_attribute_fn = api->set_port_attribute;
+}
+
+template <>
+inline ObjectBulker<sai_queue_api_t>::ObjectBulker(SaiBulkerTraits<sai_queue_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = nullptr;
+    remove_entries = nullptr;
+    set_entry_attribute_fn = api->set_queue_attribute;
+}
+
+template <>
+inline ObjectBulker<sai_buffer_api_t>::ObjectBulker(SaiBulkerTraits<sai_buffer_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = nullptr;
+    remove_entries = nullptr;
+    set_entry_attribute_fn = api->set_ingress_priority_group_attribute;
 }
@@ -3,6 +3,7 @@
 #include "select.h"
 #include "notifier.h"
 #include "sai_serialize.h"
+#include "counters_db_reply.h"
 #include <inttypes.h>
 
 #define COUNTER_CHECK_POLL_TIMEOUT_SEC   (5 * 60)
@@ -23,11 +24,19 @@ CounterCheckOrch& CounterCheckOrch::getInstance(DBConnector *db)
 
 CounterCheckOrch::CounterCheckOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
-    m_countersDb(new DBConnector("COUNTERS_DB", 0)),
-    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE))
+    m_countersDb(new DBConnector("COUNTERS_DB", 0))
 {
     SWSS_LOG_ENTER();
 
+    if (isCounterSnapshotEnabled("PORT"))
+    {
+        m_portSnapshot.reset(new CounterSnapshotReader(getCounterSnapshotName("PORT")));
+    }
+    if (isCounterSnapshotEnabled("QUEUE"))
+    {
+        m_queueSnapshot.reset(new CounterSnapshotReader(getCounterSnapshotName("QUEUE")));
+    }
+
     auto interv = timespec { .tv_sec = COUNTER_CHECK_POLL_TIMEOUT_SEC, .tv_nsec = 0 };
     auto timer = new SelectableTimer(interv);
     auto executor = new ExecutableTimer(timer, this, "MC_COUNTERS_POLL");
@@ -44,113 +53,177 @@ void CounterCheckOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    mcCounterCheck();
-    pfcFrameCounterCheck();
+    counterCheck();
 }
 
-void CounterCheckOrch::mcCounterCheck()
+/*
+ * Compare the counters of all ports with their previous values in one pass.
+ * Multicast frames are not expected on lossless queues, nor PFC frames on
+ * lossy ones.
+ */
+void CounterCheckOrch::counterCheck()
 {
     SWSS_LOG_ENTER();
 
-    for (auto& i : m_mcCountersMap)
+    vector<PortCounters *> ports;
+    for (auto& i : m_portCountersMap)
     {
-        auto oid = i.first;
-        auto mcCounters = i.second;
-        uint8_t pfcMask = 0;
+        ports.push_back(&i.second);
+    }
 
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
-        {
-            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, oid);
-            continue;
-        }
+    vector<QueueMcCounters> newMcCounters;
+    vector<PfcFrameCounters> newPfcFrameCounters;
+    fetchCounters(ports, newMcCounters, newPfcFrameCounters);
 
-        auto newMcCounters = getQueueMcCounters(port);
+    size_t index = 0;
+    for (auto& i : m_portCountersMap)
+    {
+        auto& port = i.second;
+        auto& mcCounters = newMcCounters[index];
+        auto& pfcFrameCounters = newPfcFrameCounters[index];
+        index++;
 
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
+        if (!getPfcMask(i.first, port))
         {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
+            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.alias.c_str());
             continue;
         }
 
         for (size_t prio = 0; prio != mcCounters.size(); prio++)
         {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
-            if (newMcCounters[prio] == numeric_limits<uint64_t>::max())
+            bool isLossy = ((1 << prio) & port.pfcMask) == 0;
+            if (mcCounters[prio] == numeric_limits<uint64_t>::max())
             {
                 SWSS_LOG_WARN("Could not retreive MC counters on queue %zu port %s",
                         prio,
-                        port.m_alias.c_str());
+                        port.alias.c_str());
             }
-            else if (!isLossy && mcCounters[prio] < newMcCounters[prio])
+            else if (!isLossy && prio < port.mcCounters.size() && port.mcCounters[prio] < mcCounters[prio])
             {
                 SWSS_LOG_WARN("Got Multicast %" PRIu64 " frame(s) on lossless queue %zu port %s",
-                        newMcCounters[prio] - mcCounters[prio],
+                        mcCounters[prio] - port.mcCounters[prio],
                         prio,
-                        port.m_alias.c_str());
+                        port.alias.c_str());
             }
         }
 
-        i.second= newMcCounters;
+        for (size_t prio = 0; prio != pfcFrameCounters.size(); prio++)
+        {
+            bool isLossy = ((1 << prio) & port.pfcMask) == 0;
+            if (pfcFrameCounters[prio] == numeric_limits<uint64_t>::max())
+            {
+                SWSS_LOG_WARN("Could not retreive PFC frame count on queue %zu port %s",
+                        prio,
+                        port.alias.c_str());
+            }
+            else if (isLossy && port.pfcFrameCounters[prio] < pfcFrameCounters[prio])
+            {
+                SWSS_LOG_WARN("Got PFC %" PRIu64 " frame(s) on lossy queue %zu port %s",
+                        pfcFrameCounters[prio] - port.pfcFrameCounters[prio],
+                        prio,
+                        port.alias.c_str());
+            }
+        }
+
+        port.mcCounters = mcCounters;
+        port.pfcFrameCounters = pfcFrameCounters;
     }
 }
 
-void CounterCheckOrch::pfcFrameCounterCheck()
+bool CounterCheckOrch::getPfcMask(sai_object_id_t portId, PortCounters &counters)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& i : m_pfcFrameCountersMap)
+    if (!counters.pfcMaskValid)
     {
-        auto oid = i.first;
-        auto counters = i.second;
-        auto newCounters = getPfcFrameCounters(oid);
-        uint8_t pfcMask = 0;
+        counters.pfcMaskValid = gPortsOrch->getPortPfc(portId, &counters.pfcMask);
+    }
 
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
+    return counters.pfcMaskValid;
+}
+
+/*
+ * Look up the type of the queues of the ports in COUNTERS_QUEUE_TYPE_MAP, in
+ * one round trip. The ports whose queue map is not generated yet are looked
+ * up again on the next check.
+ */
+void CounterCheckOrch::resolveMcQueues(const vector<PortCounters *> &ports)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = m_countersDb->getContext();
+    vector<PortCounters *> pending;
+    vector<string> queueIds;
+    vector<const char *> argv;
+
+    for (auto port : ports)
+    {
+        if (port->mcQueuesResolved || port->queueIds.empty())
         {
-            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, oid);
             continue;
         }
 
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
+        queueIds.clear();
+        for (auto queueId : port->queueIds)
+        {
+            queueIds.push_back(sai_serialize_object_id(queueId));
+        }
+
+        argv = { "HMGET", COUNTERS_QUEUE_TYPE_MAP };
+        for (const auto& queueId : queueIds)
+        {
+            argv.push_back(queueId.c_str());
+        }
+
+        redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr);
+        pending.push_back(port);
+    }
+
+    for (auto port : pending)
+    {
+        CountersDbReplyPtr reply = getCountersDbReply(ctx);
+        if (reply->type != REDIS_REPLY_ARRAY || reply->elements != port->queueIds.size())
         {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
             continue;
         }
 
-        for (size_t prio = 0; prio != counters.size(); prio++)
+        vector<string> mcQueueIds;
+        bool resolved = true;
+        for (size_t i = 0; i < reply->elements; i++)
         {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
-            if (newCounters[prio] == numeric_limits<uint64_t>::max())
+            const redisReply *queueType = reply->element[i];
+            if (queueType->type != REDIS_REPLY_STRING)
             {
-                SWSS_LOG_WARN("Could not retreive PFC frame count on queue %zu port %s",
-                        prio,
-                        port.m_alias.c_str());
+                resolved = false;
+                break;
             }
-            else if (isLossy && counters[prio] < newCounters[prio])
+
+            if (string(queueType->str) == "SAI_QUEUE_TYPE_MULTICAST")
             {
-                SWSS_LOG_WARN("Got PFC %" PRIu64 " frame(s) on lossy queue %zu port %s",
-                        newCounters[prio] - counters[prio],
-                        prio,
-                        port.m_alias.c_str());
+                mcQueueIds.push_back(sai_serialize_object_id(port->queueIds[i]));
             }
         }
 
-        i.second = newCounters;
+        if (resolved)
+        {
+            port->mcQueueIds = mcQueueIds;
+            port->mcQueuesResolved = true;
+        }
     }
 }
 
-
-PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
+/*
+ * Read the PFC frame counters and the multicast queue counters of the ports
+ * from the counter snapshots, and the ones missing there with one pipelined
+ * batch. Counters that are not available are set to the max value.
+ */
+void CounterCheckOrch::fetchCounters(const vector<PortCounters *> &ports,
+        vector<QueueMcCounters> &mcCounters,
+        vector<PfcFrameCounters> &pfcFrameCounters)
 {
     SWSS_LOG_ENTER();
 
-    vector<FieldValueTuple> fieldValues;
-    PfcFrameCounters counters;
-    counters.fill(numeric_limits<uint64_t>::max());
-
-    static const array<string, PFC_WD_TC_MAX> counterNames =
+    static const vector<string> counterNames =
     {
         "SAI_PORT_STAT_PFC_0_RX_PKTS",
         "SAI_PORT_STAT_PFC_1_RX_PKTS",
@@ -161,74 +234,129 @@ PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
         "SAI_PORT_STAT_PFC_6_RX_PKTS",
         "SAI_PORT_STAT_PFC_7_RX_PKTS"
     };
+    static const vector<string> queueCounterNames = { "SAI_QUEUE_STAT_PACKETS" };
+
+    resolveMcQueues(ports);
 
-    if (!m_countersTable->get(sai_serialize_object_id(portId), fieldValues))
+    redisContext *ctx = m_countersDb->getContext();
+
+    vector<const char *> argv = { "HMGET", nullptr };
+    for (const auto& name : counterNames)
     {
-        return counters;
+        argv.push_back(name.c_str());
     }
 
-    for (const auto& fv : fieldValues)
+    mcCounters.assign(ports.size(), QueueMcCounters());
+    pfcFrameCounters.assign(ports.size(), PfcFrameCounters());
+
+    for (auto snapshot : { m_portSnapshot.get(), m_queueSnapshot.get() })
     {
-        const auto field = fvField(fv);
-        const auto value = fvValue(fv);
+        if (snapshot)
+        {
+            snapshot->refresh();
+        }
+    }
+
+    /* Counters found in the snapshots are not requested */
+    vector<uint8_t> portPending(ports.size());
+    vector<vector<uint8_t>> queuePending(ports.size());
 
+    for (size_t i = 0; i < ports.size(); i++)
+    {
+        auto port = ports[i];
+        if (!m_portSnapshot || !m_portSnapshot->read(port->objectId, counterNames, pfcFrameCounters[i].data()))
+        {
+            portPending[i] = 1;
+            argv[1] = port->countersKey.c_str();
+            redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr);
+        }
 
-        for (size_t prio = 0; prio != counterNames.size(); prio++)
+        mcCounters[i].assign(port->mcQueueIds.size(), 0);
+        queuePending[i].assign(port->mcQueueIds.size(), 0);
+        for (size_t queue = 0; queue < port->mcQueueIds.size(); queue++)
         {
-            if (field == counterNames[prio])
+            const auto& queueId = port->mcQueueIds[queue];
+            if (m_queueSnapshot && m_queueSnapshot->read(queueId, queueCounterNames, &mcCounters[i][queue]))
             {
-                counters[prio] = stoul(value);
+                continue;
             }
+
+            queuePending[i][queue] = 1;
+            redisAppendCommand(ctx, "HMGET %s:%s SAI_QUEUE_STAT_PACKETS", COUNTERS_TABLE, queueId.c_str());
         }
     }
 
-    return counters;
-}
-
-QueueMcCounters CounterCheckOrch::getQueueMcCounters(
-        const Port& port)
-{
-    SWSS_LOG_ENTER();
-
-    vector<FieldValueTuple> fieldValues;
-    QueueMcCounters counters;
-
-    for (uint8_t prio = 0; prio < port.m_queue_ids.size(); prio++)
+    for (size_t i = 0; i < ports.size(); i++)
     {
-        sai_object_id_t queueId = port.m_queue_ids[prio];
-        auto queueIdStr = sai_serialize_object_id(queueId);
-        auto queueType = m_countersDb->hget(COUNTERS_QUEUE_TYPE_MAP, queueIdStr);
-
-        if (queueType.get() == nullptr || *queueType != "SAI_QUEUE_TYPE_MULTICAST" || !m_countersTable->get(queueIdStr, fieldValues))
+        if (portPending[i])
         {
-            continue;
+            CountersDbReplyPtr reply = getCountersDbReply(ctx);
+            for (size_t prio = 0; prio != counterNames.size(); prio++)
+            {
+                pfcFrameCounters[i][prio] = numeric_limits<uint64_t>::max();
+                getCountersDbCounter(reply.get(), prio, pfcFrameCounters[i][prio]);
+            }
         }
 
-        uint64_t pkts = numeric_limits<uint64_t>::max();
-        for (const auto& fv : fieldValues)
+        for (size_t queue = 0; queue < queuePending[i].size(); queue++)
         {
-            const auto field = fvField(fv);
-            const auto value = fvValue(fv);
-
-            if (field == "SAI_QUEUE_STAT_PACKETS")
+            if (queuePending[i][queue])
             {
-                pkts = stoul(value);
+                CountersDbReplyPtr queueReply = getCountersDbReply(ctx);
+                mcCounters[i][queue] = numeric_limits<uint64_t>::max();
+                getCountersDbCounter(queueReply.get(), 0, mcCounters[i][queue]);
             }
         }
-        counters.push_back(pkts);
     }
-
-    return counters;
 }
 
 void CounterCheckOrch::addPort(const Port& port)
 {
-    m_mcCountersMap.emplace(port.m_port_id, getQueueMcCounters(port));
-    m_pfcFrameCountersMap.emplace(port.m_port_id, getPfcFrameCounters(port.m_port_id));
+    SWSS_LOG_ENTER();
+
+    auto inserted = m_portCountersMap.emplace(port.m_port_id, PortCounters());
+    auto& counters = inserted.first->second;
+
+    if (inserted.second)
+    {
+        counters.alias = port.m_alias;
+        counters.objectId = sai_serialize_object_id(port.m_port_id);
+        counters.countersKey = string(COUNTERS_TABLE) + ":" + counters.objectId;
+        counters.pfcFrameCounters.fill(numeric_limits<uint64_t>::max());
+    }
+
+    /*
+     * The port is added with both its queue map and its PG map, the queue
+     * types are only known once the queue map is generated
+     */
+    if (!inserted.second && counters.mcQueuesResolved)
+    {
+        return;
+    }
+    counters.queueIds = port.m_queue_ids;
+
+    vector<QueueMcCounters> mcCounters;
+    vector<PfcFrameCounters> pfcFrameCounters;
+    fetchCounters({ &counters }, mcCounters, pfcFrameCounters);
+
+    counters.mcCounters = mcCounters[0];
+    counters.pfcFrameCounters = pfcFrameCounters[0];
 }
 
 void CounterCheckOrch::removePort(const Port& port)
 {
-    m_mcCountersMap.erase(port.m_port_id);
-    m_pfcFrameCountersMap.erase(port.m_port_id);
+    SWSS_LOG_ENTER();
+
+    m_portCountersMap.erase(port.m_port_id);
+}
+
+void CounterCheckOrch::invalidatePfcMask(sai_object_id_t portId)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_portCountersMap.find(portId);
+    if (it != m_portCountersMap.end())
+    {
+        it->second.pfcMaskValid = false;
+    }
 }
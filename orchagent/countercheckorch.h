@@ -4,7 +4,9 @@
 #include "orch.h"
 #include "port.h"
 #include "timer.h"
+#include "counter_snapshot.h"
 #include <array>
+#include <memory>
 
 #define PFC_WD_TC_MAX 8
 
@@ -23,20 +25,40 @@ public:
     virtual void doTask(Consumer &consumer) {}
     void addPort(const swss::Port& port);
     void removePort(const swss::Port& port);
+    void invalidatePfcMask(sai_object_id_t portId);
 
 private:
+    struct PortCounters
+    {
+        std::string alias;
+        std::string objectId;
+        std::string countersKey;
+        std::vector<sai_object_id_t> queueIds;
+        /* Object ids of the multicast queues, once the queue types are known */
+        std::vector<std::string> mcQueueIds;
+        bool mcQueuesResolved = false;
+        bool pfcMaskValid = false;
+        uint8_t pfcMask = 0;
+        QueueMcCounters mcCounters;
+        PfcFrameCounters pfcFrameCounters;
+    };
+
     CounterCheckOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
     virtual ~CounterCheckOrch(void);
-    QueueMcCounters getQueueMcCounters(const swss::Port& port);
-    PfcFrameCounters getPfcFrameCounters(sai_object_id_t portId);
-    void mcCounterCheck();
-    void pfcFrameCounterCheck();
+    void resolveMcQueues(const std::vector<PortCounters *> &ports);
+    void fetchCounters(const std::vector<PortCounters *> &ports,
+            std::vector<QueueMcCounters> &mcCounters,
+            std::vector<PfcFrameCounters> &pfcFrameCounters);
+    bool getPfcMask(sai_object_id_t portId, PortCounters &counters);
+    void counterCheck();
 
-    std::map<sai_object_id_t, QueueMcCounters> m_mcCountersMap;
-    std::map<sai_object_id_t, PfcFrameCounters> m_pfcFrameCountersMap;
+    std::map<sai_object_id_t, PortCounters> m_portCountersMap;
 
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
-    std::shared_ptr<swss::Table> m_countersTable = nullptr;
+
+    /* Set if the counters may be read from the shared memory snapshot */
+    std::unique_ptr<CounterSnapshotReader> m_portSnapshot;
+    std::unique_ptr<CounterSnapshotReader> m_queueSnapshot;
 };
 
 #endif
@@ -13,6 +13,7 @@
 
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 
 extern sai_next_hop_group_api_t*    sai_next_hop_group_api;
 extern sai_route_api_t*             sai_route_api;
@@ -26,8 +27,10 @@ FgNhgOrch::FgNhgOrch(DBConnector *db, DBConnector *appDb, DBConnector *stateDb,
         m_neighOrch(neighOrch),
         m_intfsOrch(intfsOrch),
         m_vrfOrch(vrfOrch),
-        m_stateWarmRestartRouteTable(stateDb, STATE_FG_ROUTE_TABLE_NAME),
-        m_routeTable(appDb, APP_ROUTE_TABLE_NAME)
+        m_statePipeline(stateDb),
+        m_stateWarmRestartRouteTable(&m_statePipeline, STATE_FG_ROUTE_TABLE_NAME, true),
+        m_routeTable(appDb, APP_ROUTE_TABLE_NAME),
+        m_nextHopGroupMemberBulker(sai_next_hop_group_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
     isFineGrainedConfigured = false;
@@ -196,60 +199,100 @@ void FgNhgOrch::calculateBankHashBucketStartIndices(FgNhgEntry *fgNhgEntry)
 }
 
 
-void FgNhgOrch::setStateDbRouteEntry(const IpPrefix &ipPrefix, uint32_t index, NextHopKey nextHop)
+/* setStateDbRouteEntry: Writes the whole hash bucket layout of a FG next hop group
+ * to the state db entry of a route pointing to it.
+ */
+void FgNhgOrch::setStateDbRouteEntry(const IpPrefix &ipPrefix, const FGNextHopGroupEntry &syncd_fg_route_entry)
 {
     SWSS_LOG_ENTER();
 
-    string key = ipPrefix.to_string();
-    // Write to StateDb
     std::vector<FieldValueTuple> fvs;
-
-    // check if profile already exists - if yes - skip creation
-    m_stateWarmRestartRouteTable.get(key, fvs);
-
-    //bucket rewrite
-    if (fvs.size() > index)
-    {
-        FieldValueTuple fv(std::to_string(index), nextHop.to_string());
-        fvs[index] = fv;
-        SWSS_LOG_INFO("Set state db entry for ip prefix %s next hop %s with index %d",
-                        ipPrefix.to_string().c_str(), nextHop.to_string().c_str(), index);
-        m_stateWarmRestartRouteTable.set(key, fvs);
-    }
-    else
+    for (const auto &bank_fgnhg_map : syncd_fg_route_entry.syncd_fgnhg_map)
     {
-        fvs.push_back(FieldValueTuple(std::to_string(index), nextHop.to_string()));
-        SWSS_LOG_INFO("Add new next hop entry %s with index %d for ip prefix %s",
-                nextHop.to_string().c_str(), index, ipPrefix.to_string().c_str());
-        m_stateWarmRestartRouteTable.set(key, fvs);
+        for (const auto &nh_buckets : bank_fgnhg_map)
+        {
+            for (auto index : nh_buckets.second)
+            {
+                fvs.push_back(FieldValueTuple(std::to_string(index), nh_buckets.first.to_string()));
+            }
+        }
     }
 
+    m_stateWarmRestartRouteTable.del(ipPrefix.to_string());
+    m_stateWarmRestartRouteTable.set(ipPrefix.to_string(), fvs);
 }
 
-bool FgNhgOrch::writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry, uint32_t index, sai_object_id_t nh_oid,
-        const IpPrefix &ipPrefix, NextHopKey nextHop)
+
+/* queueHashBucketChange: Records the next hop to set on a hash bucket for the route being processed.
+ * A bucket may be reassigned several times while the bank changes are computed, only the last
+ * assignment is kept and applied by commitHashBucketChanges.
+ */
+void FgNhgOrch::queueHashBucketChange(uint32_t index, sai_object_id_t nh_oid, const NextHopKey &nextHop)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t nhgm_attr;
-    nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-    nhgm_attr.value.oid = nh_oid;
-    sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(
-                                                              syncd_fg_route_entry->nhopgroup_members[index],
-                                                              &nhgm_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    m_bucketChanges[index] = std::make_pair(nh_oid, nextHop);
+}
+
+
+/* commitHashBucketChanges: Applies the queued hash bucket changes of a FG next hop group.
+ * Buckets which end up on the next hop already programmed are skipped, the remaining
+ * ones are set in SAI and written to the state db entries of all routes sharing the group.
+ */
+bool FgNhgOrch::commitHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<FieldValueTuple> fvs;
+    bool success = true;
+
+    for (const auto &change : m_bucketChanges)
     {
-        SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
-            syncd_fg_route_entry->nhopgroup_members[index], nh_oid, status);
-        task_process_status handle_status = handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, status);
-        if (handle_status != task_success)
+        uint32_t index = change.first;
+        sai_object_id_t nh_oid = change.second.first;
+        const NextHopKey &nextHop = change.second.second;
+
+        if (syncd_fg_route_entry->bucket_nh_oids[index] == nh_oid)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            continue;
         }
+
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = nh_oid;
+        sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(
+                                                                  syncd_fg_route_entry->nhopgroup_members[index],
+                                                                  &nhgm_attr);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
+                syncd_fg_route_entry->nhopgroup_members[index], nh_oid, status);
+            task_process_status handle_status = handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, status);
+            if (handle_status != task_success)
+            {
+                success = parseHandleSaiStatusFailure(handle_status);
+                break;
+            }
+        }
+
+        syncd_fg_route_entry->bucket_nh_oids[index] = nh_oid;
+        fvs.push_back(FieldValueTuple(std::to_string(index), nextHop.to_string()));
     }
 
-    setStateDbRouteEntry(ipPrefix, index, nextHop);
-    return true;
+    SWSS_LOG_INFO("Set %zu of %zu changed hash buckets for next hop group %s, shared by %zu routes",
+            fvs.size(), m_bucketChanges.size(), syncd_fg_route_entry->nhg_key.to_string().c_str(),
+            syncd_fg_route_entry->routes.size());
+    m_bucketChanges.clear();
+
+    if (!fvs.empty())
+    {
+        for (const auto &route : syncd_fg_route_entry->routes)
+        {
+            m_stateWarmRestartRouteTable.set(route.second.to_string(), fvs);
+        }
+    }
+
+    return success;
 }
 
 
@@ -314,19 +357,132 @@ bool FgNhgOrch::createFineGrainedNextHopGroup(FGNextHopGroupEntry &syncd_fg_rout
 }
 
 
+/* createHashBucketMembers: Creates the next hop group members of all hash buckets in bulk,
+ * member i being set to nh_oids[i]. The group is removed if any member fails to be created.
+ */
+bool FgNhgOrch::createHashBucketMembers(FGNextHopGroupEntry &syncd_fg_route_entry, const std::vector<sai_object_id_t> &nh_oids)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<sai_object_id_t> nhgm_ids(nh_oids.size());
+    std::vector<sai_status_t> statuses(nh_oids.size());
+    for (uint32_t j = 0; j < nh_oids.size(); j++)
+    {
+        sai_attribute_t nhgm_attr;
+        vector<sai_attribute_t> nhgm_attrs;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        nhgm_attr.value.oid = syncd_fg_route_entry.next_hop_group_id;
+        nhgm_attrs.push_back(nhgm_attr);
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = nh_oids[j];
+        nhgm_attrs.push_back(nhgm_attr);
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_INDEX;
+        nhgm_attr.value.s32 = j;
+        nhgm_attrs.push_back(nhgm_attr);
+
+        m_nextHopGroupMemberBulker.create_entry(&nhgm_ids[j], &statuses[j],
+                                                (uint32_t)nhgm_attrs.size(),
+                                                nhgm_attrs.data());
+    }
+    m_nextHopGroupMemberBulker.flush();
+
+    /* Status of the first member which failed to be created */
+    sai_status_t status = SAI_STATUS_SUCCESS;
+    for (uint32_t j = 0; j < nh_oids.size(); j++)
+    {
+        if (statuses[j] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create next hop group %" PRIx64 " member for hash bucket %d: %d",
+               syncd_fg_route_entry.next_hop_group_id, j, statuses[j]);
+            if (status == SAI_STATUS_SUCCESS)
+            {
+                status = statuses[j];
+            }
+            continue;
+        }
+
+        syncd_fg_route_entry.nhopgroup_members.push_back(nhgm_ids[j]);
+        syncd_fg_route_entry.bucket_nh_oids.push_back(nh_oids[j]);
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+    }
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        if (!removeFineGrainedNextHopGroup(&syncd_fg_route_entry))
+        {
+            SWSS_LOG_ERROR("Failed to clean-up after next-hop member creation failure");
+        }
+
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+
+/* cloneFineGrainedNextHopGroup: Creates a FG next hop group with the same hash bucket layout as src_entry.
+ * Used when a route sharing src_entry changes its next hops: the route moves to the copy, and only
+ * the hash buckets affected by the next hop change are then moved, as if the group was updated in place.
+ */
+bool FgNhgOrch::cloneFineGrainedNextHopGroup(const FGNextHopGroupEntry &src_entry, FGNextHopGroupEntry &syncd_fg_route_entry,
+        const NextHopGroupKey &nextHops)
+{
+    SWSS_LOG_ENTER();
+
+    if (!createFineGrainedNextHopGroup(syncd_fg_route_entry, src_entry.fg_nhg_entry, nextHops))
+    {
+        return false;
+    }
+
+    if (!createHashBucketMembers(syncd_fg_route_entry, src_entry.bucket_nh_oids))
+    {
+        return false;
+    }
+
+    syncd_fg_route_entry.active_nexthops = src_entry.active_nexthops;
+    syncd_fg_route_entry.syncd_fgnhg_map = src_entry.syncd_fgnhg_map;
+    syncd_fg_route_entry.nhg_key = src_entry.nhg_key;
+    syncd_fg_route_entry.inactive_to_active_map = src_entry.inactive_to_active_map;
+    syncd_fg_route_entry.fg_nhg_entry = src_entry.fg_nhg_entry;
+
+    /* The copy holds its own references to the next hops */
+    for (const auto &nh : syncd_fg_route_entry.active_nexthops)
+    {
+        m_neighOrch->increaseNextHopRefCount(nh);
+    }
+
+    SWSS_LOG_INFO("Cloned next hop group %s for %s", src_entry.nhg_key.to_string().c_str(),
+            nextHops.to_string().c_str());
+    return true;
+}
+
+
 bool FgNhgOrch::removeFineGrainedNextHopGroup(FGNextHopGroupEntry *syncd_fg_route_entry)
 {
     SWSS_LOG_ENTER();
-    sai_status_t status;
 
-    for (auto nhgm : syncd_fg_route_entry->nhopgroup_members)
+    size_t nhgm_count = syncd_fg_route_entry->nhopgroup_members.size();
+    vector<sai_status_t> statuses(nhgm_count);
+    for (size_t i = 0; i < nhgm_count; i++)
     {
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nhgm);
-        if (status != SAI_STATUS_SUCCESS)
+        m_nextHopGroupMemberBulker.remove_entry(&statuses[i], syncd_fg_route_entry->nhopgroup_members[i]);
+    }
+    m_nextHopGroupMemberBulker.flush();
+
+    for (size_t i = 0; i < nhgm_count; i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to remove next hop group member %" PRIx64 ", rv:%d",
-                nhgm, status);
-            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+                syncd_fg_route_entry->nhopgroup_members[i], statuses[i]);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
             if (handle_status != task_success)
             {
                 return parseHandleSaiStatusFailure(handle_status);
@@ -348,66 +504,50 @@ bool FgNhgOrch::validNextHopInNextHopGroup(const NextHopKey& nexthop)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &route_tables : m_syncdFGRouteTables)
+    /* Hash buckets are updated once per FG next hop group, for all the routes sharing it */
+    for (auto &nhg : m_syncdFGNextHopGroups)
     {
-        for (auto &route_table : route_tables.second)
+        if (!(nhg.second.nhg_key.contains(nexthop)))
         {
-            if (!(route_table.second.nhg_key.contains(nexthop)))
-            {
-                continue;
-            }
+            continue;
+        }
 
-            FGNextHopGroupEntry *syncd_fg_route_entry = &(route_table.second);
-            FgNhgEntry *fgNhgEntry = 0;
-            auto prefix_entry = m_fgNhgPrefixes.find(route_table.first);
-            if (prefix_entry == m_fgNhgPrefixes.end())
-            {
-                auto member_entry = m_fgNhgNexthops.find(nexthop.ip_address);
-                if (member_entry == m_fgNhgNexthops.end())
-                {
-                    SWSS_LOG_ERROR("fgNhgOrch got a validNextHopInNextHopGroup for non-configured FG ECMP entry");
-                    return false;
-                }
-                fgNhgEntry = member_entry->second;
-            }
-            else 
-            {
-                fgNhgEntry = prefix_entry->second;
-            }
-            std::map<NextHopKey,sai_object_id_t> nhopgroup_members_set;
+        FGNextHopGroupEntry *syncd_fg_route_entry = &(nhg.second);
+        FgNhgEntry *fgNhgEntry = syncd_fg_route_entry->fg_nhg_entry;
+        std::map<NextHopKey,sai_object_id_t> nhopgroup_members_set;
 
-            std::vector<BankMemberChanges> bank_member_changes(
-                fgNhgEntry->hash_bucket_indices.size(), BankMemberChanges());
+        std::vector<BankMemberChanges> bank_member_changes(
+            fgNhgEntry->hash_bucket_indices.size(), BankMemberChanges());
 
-            if (syncd_fg_route_entry->active_nexthops.find(nexthop) !=
-                    syncd_fg_route_entry->active_nexthops.end())
-            {
-                return true;
-            }
+        if (syncd_fg_route_entry->active_nexthops.find(nexthop) !=
+                syncd_fg_route_entry->active_nexthops.end())
+        {
+            continue;
+        }
 
-            for (auto active_nh : syncd_fg_route_entry->active_nexthops)
-            {
-                bank_member_changes[fgNhgEntry->next_hops[active_nh.ip_address].bank].
-                    active_nhs.push_back(active_nh);
-            }
+        for (auto active_nh : syncd_fg_route_entry->active_nexthops)
+        {
+            bank_member_changes[fgNhgEntry->next_hops[active_nh.ip_address].bank].
+                active_nhs.push_back(active_nh);
+        }
 
-            bank_member_changes[fgNhgEntry->next_hops[nexthop.ip_address].bank].
-                    nhs_to_add.push_back(nexthop);
-            nhopgroup_members_set[nexthop] = m_neighOrch->getNextHopId(nexthop);
+        bank_member_changes[fgNhgEntry->next_hops[nexthop.ip_address].bank].
+                nhs_to_add.push_back(nexthop);
+        nhopgroup_members_set[nexthop] = m_neighOrch->getNextHopId(nexthop);
 
-            if (!computeAndSetHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
-                    bank_member_changes, nhopgroup_members_set, route_table.first))
-            {
-                SWSS_LOG_ERROR("Failed to set fine grained next hop %s",
-                    nexthop.to_string().c_str());
-                return false;
-            }
+        if (!computeAndSetHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
+                bank_member_changes, nhopgroup_members_set))
+        {
+            SWSS_LOG_ERROR("Failed to set fine grained next hop %s",
+                nexthop.to_string().c_str());
+            return false;
+        }
 
-            m_neighOrch->increaseNextHopRefCount(nexthop);
+        m_neighOrch->increaseNextHopRefCount(nexthop);
 
-            SWSS_LOG_INFO("FG nh %s for prefix %s is up",
-                    nexthop.to_string().c_str(), route_table.first.to_string().c_str());
-        }
+        SWSS_LOG_INFO("FG nh %s for next hop group %s shared by %zu routes is up",
+                nexthop.to_string().c_str(), nhg.second.nhg_key.to_string().c_str(),
+                nhg.second.routes.size());
     }
 
     return true;
@@ -418,74 +558,57 @@ bool FgNhgOrch::invalidNextHopInNextHopGroup(const NextHopKey& nexthop)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &route_tables : m_syncdFGRouteTables)
+    /* Hash buckets are updated once per FG next hop group, for all the routes sharing it */
+    for (auto &nhg : m_syncdFGNextHopGroups)
     {
-        for (auto &route_table : route_tables.second)
+        if (!(nhg.second.nhg_key.contains(nexthop)))
         {
-            if (!(route_table.second.nhg_key.contains(nexthop)))
-            {
-                continue;
-            }
+            continue;
+        }
 
-            FGNextHopGroupEntry *syncd_fg_route_entry = &(route_table.second);
-            FgNhgEntry *fgNhgEntry = 0;
-            auto prefix_entry = m_fgNhgPrefixes.find(route_table.first);
-            if (prefix_entry == m_fgNhgPrefixes.end())
-            {
-                auto member_entry = m_fgNhgNexthops.find(nexthop.ip_address);
-                if (member_entry == m_fgNhgNexthops.end())
-                {
-                    SWSS_LOG_ERROR("fgNhgOrch got an invalidNextHopInNextHopGroup for non-configured FG ECMP entry");
-                    return false;
-                }
-                fgNhgEntry = member_entry->second;
-            }
-            else 
-            {
-                fgNhgEntry = prefix_entry->second;
-            }
+        FGNextHopGroupEntry *syncd_fg_route_entry = &(nhg.second);
+        FgNhgEntry *fgNhgEntry = syncd_fg_route_entry->fg_nhg_entry;
+        std::map<NextHopKey,sai_object_id_t> nhopgroup_members_set;
 
-            std::map<NextHopKey,sai_object_id_t> nhopgroup_members_set;
+        std::vector<BankMemberChanges> bank_member_changes(
+            fgNhgEntry->hash_bucket_indices.size(), BankMemberChanges());
 
-            std::vector<BankMemberChanges> bank_member_changes(
-                fgNhgEntry->hash_bucket_indices.size(), BankMemberChanges());
+        if (syncd_fg_route_entry->active_nexthops.find(nexthop) ==
+                syncd_fg_route_entry->active_nexthops.end())
+        {
+            continue;
+        }
 
-            if (syncd_fg_route_entry->active_nexthops.find(nexthop) ==
-                    syncd_fg_route_entry->active_nexthops.end())
+        for (auto active_nh : syncd_fg_route_entry->active_nexthops)
+        {
+            if (active_nh.ip_address == nexthop.ip_address &&
+                    active_nh.alias == nexthop.alias)
             {
-                return true;
+                continue;
             }
 
-            for (auto active_nh : syncd_fg_route_entry->active_nexthops)
-            {
-                if (active_nh.ip_address == nexthop.ip_address &&
-                        active_nh.alias == nexthop.alias)
-                {
-                    continue;
-                }
-
-                bank_member_changes[fgNhgEntry->next_hops[active_nh.ip_address].bank].
-                    active_nhs.push_back(active_nh);
+            bank_member_changes[fgNhgEntry->next_hops[active_nh.ip_address].bank].
+                active_nhs.push_back(active_nh);
 
-                nhopgroup_members_set[active_nh] = m_neighOrch->getNextHopId(active_nh);
-            }
+            nhopgroup_members_set[active_nh] = m_neighOrch->getNextHopId(active_nh);
+        }
 
-            bank_member_changes[fgNhgEntry->next_hops[nexthop.ip_address].bank].
-                    nhs_to_del.push_back(nexthop);
+        bank_member_changes[fgNhgEntry->next_hops[nexthop.ip_address].bank].
+                nhs_to_del.push_back(nexthop);
 
-            if (!computeAndSetHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
-                    bank_member_changes, nhopgroup_members_set, route_table.first))
-            {
-                SWSS_LOG_ERROR("Failed to set fine grained next hop %s",
-                    nexthop.to_string().c_str());
-                return false;
-            }
+        if (!computeAndSetHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
+                bank_member_changes, nhopgroup_members_set))
+        {
+            SWSS_LOG_ERROR("Failed to set fine grained next hop %s",
+                nexthop.to_string().c_str());
+            return false;
+        }
 
-            m_neighOrch->decreaseNextHopRefCount(nexthop);
+        m_neighOrch->decreaseNextHopRefCount(nexthop);
 
-            SWSS_LOG_INFO("FG nh %s for prefix %s is down",
-                    nexthop.to_string().c_str(), route_table.first.to_string().c_str());
-        }
+        SWSS_LOG_INFO("FG nh %s for next hop group %s shared by %zu routes is down",
+                nexthop.to_string().c_str(), nhg.second.nhg_key.to_string().c_str(),
+                nhg.second.routes.size());
     }
 
     return true;
@@ -504,7 +627,7 @@ bool FgNhgOrch::invalidNextHopInNextHopGroup(const NextHopKey& nexthop)
  */
 bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
         uint32_t bank, uint32_t syncd_bank, std::vector<BankMemberChanges> bank_member_changes, 
-        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix &ipPrefix)
+        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set)
 {
     SWSS_LOG_ENTER();
 
@@ -518,12 +641,9 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
         HashBuckets *hash_buckets = &(bank_fgnhg_map->at(bank_member_change.nhs_to_del[del_idx]));
         for (uint32_t i = 0; i < hash_buckets->size(); i++)
         {
-            if (!writeHashBucketChange(syncd_fg_route_entry, hash_buckets->at(i), 
-                        nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
-                        ipPrefix, bank_member_change.nhs_to_add[add_idx]))
-            {
-                return false;
-            }
+            queueHashBucketChange(hash_buckets->at(i),
+                    nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
+                    bank_member_change.nhs_to_add[add_idx]);
         }
 
         (*bank_fgnhg_map)[bank_member_change.nhs_to_add[add_idx]] =*hash_buckets;
@@ -557,11 +677,7 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
                 NextHopKey round_robin_nh = bank_member_change.active_nhs[i %
                     bank_member_change.active_nhs.size()];
 
-                if (!writeHashBucketChange(syncd_fg_route_entry, hash_buckets->at(i), 
-                        nhopgroup_members_set[round_robin_nh], ipPrefix, round_robin_nh))
-                {
-                    return false;
-                }
+                queueHashBucketChange(hash_buckets->at(i), nhopgroup_members_set[round_robin_nh], round_robin_nh);
                 bank_fgnhg_map->at(round_robin_nh).push_back(hash_buckets->at(i));
 
                 /* Logic below ensure that # hash buckets assigned to a nh is equalized,
@@ -657,12 +773,9 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
                 {
                     uint32_t last_elem = map_entry->at((*map_entry).size() - 1);
 
-                    if (!writeHashBucketChange(syncd_fg_route_entry, last_elem, 
-                        nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
-                        ipPrefix, bank_member_change.nhs_to_add[add_idx]))
-                    {
-                        return false;
-                    }
+                    queueHashBucketChange(last_elem,
+                            nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
+                            bank_member_change.nhs_to_add[add_idx]);
 
                     (*bank_fgnhg_map)[bank_member_change.nhs_to_add[add_idx]].push_back(last_elem);
                     (*map_entry).erase((*map_entry).end() - 1);
@@ -721,7 +834,7 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
 
 bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
         uint32_t bank, std::vector<BankMemberChanges> bank_member_changes,
-        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix &ipPrefix)
+        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set)
 {
     SWSS_LOG_ENTER();
 
@@ -746,11 +859,7 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
                 NextHopKey bank_nh_memb = bank_member_changes[new_bank_idx].
                          active_nhs[i % bank_member_changes[new_bank_idx].active_nhs.size()];
 
-                if (!writeHashBucketChange(syncd_fg_route_entry, i,
-                    nhopgroup_members_set[bank_nh_memb],ipPrefix, bank_nh_memb ))
-                {
-                    return false;
-                }
+                queueHashBucketChange(i, nhopgroup_members_set[bank_nh_memb], bank_nh_memb);
 
                 syncd_fg_route_entry->syncd_fgnhg_map[bank][bank_nh_memb].push_back(i);
             }
@@ -760,8 +869,8 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
 
     if (new_bank_idx == bank_member_changes.size())
     {
-        SWSS_LOG_NOTICE("All banks of FG next-hops are down for prefix %s", 
-                ipPrefix.to_string().c_str());
+        SWSS_LOG_NOTICE("All banks of FG next-hops are down for next hop group %s", 
+                syncd_fg_route_entry->nhg_key.to_string().c_str());
         /* Case where there are no active banks */
         /* Note: There is no way to set a NULL OID to the now inactive next-hops
          * so we leave the next-hops as is in SAI, and future route/neighbor changes
@@ -787,7 +896,7 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
  */
 bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
         uint32_t bank,std::vector<BankMemberChanges> &bank_member_changes, 
-        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix &ipPrefix)
+        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set)
 {
     SWSS_LOG_ENTER();
 
@@ -801,25 +910,21 @@ bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_r
             NextHopKey bank_nh_memb = bank_member_changes[bank].
                 nhs_to_add[i % bank_member_changes[bank].nhs_to_add.size()];
 
-            if (!writeHashBucketChange(syncd_fg_route_entry, i, 
-                  nhopgroup_members_set[bank_nh_memb], ipPrefix, bank_nh_memb))
-            {
-                return false;
-            }
+            queueHashBucketChange(i, nhopgroup_members_set[bank_nh_memb], bank_nh_memb);
 
             syncd_fg_route_entry->syncd_fgnhg_map[bank][bank_nh_memb].push_back(i);
             syncd_fg_route_entry->active_nexthops.insert(bank_nh_memb);
         }
         syncd_fg_route_entry->inactive_to_active_map[bank] = bank;
 
-        SWSS_LOG_NOTICE("Bank# %d of FG next-hops is up for prefix %s", 
-                bank, ipPrefix.to_string().c_str());
+        SWSS_LOG_NOTICE("Bank# %d of FG next-hops is up for next hop group %s", 
+                bank, syncd_fg_route_entry->nhg_key.to_string().c_str());
     }
     else if (bank_member_changes[bank].nhs_to_del.size() > 0)
     {
         /* Previously active bank now transitions to inactive */
         if (!setInactiveBankToNextAvailableActiveBank(syncd_fg_route_entry, fgNhgEntry,
-                    bank, bank_member_changes, nhopgroup_members_set, ipPrefix))
+                    bank, bank_member_changes, nhopgroup_members_set))
         {
             SWSS_LOG_INFO("Failed to map to active_bank and set nh in SAI");
             return false;
@@ -830,8 +935,8 @@ bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_r
             syncd_fg_route_entry->active_nexthops.erase(memb);
         }
 
-        SWSS_LOG_NOTICE("Bank# %d of FG next-hops is down for prefix %s", bank, 
-                ipPrefix.to_string().c_str());
+        SWSS_LOG_NOTICE("Bank# %d of FG next-hops is down for next hop group %s", bank, 
+                syncd_fg_route_entry->nhg_key.to_string().c_str());
     }
     else
     {
@@ -840,7 +945,7 @@ bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_r
         if (bank_member_changes[active_bank].active_nhs.size() == 0)
         {
             if (!setInactiveBankToNextAvailableActiveBank(syncd_fg_route_entry, fgNhgEntry,
-                        bank, bank_member_changes, nhopgroup_members_set, ipPrefix))
+                        bank, bank_member_changes, nhopgroup_members_set))
             {
                 SWSS_LOG_INFO("Failed to map to active_bank and set nh in SAI");
                 return false;
@@ -849,7 +954,7 @@ bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_r
         else
         {
             if (!setActiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
-                active_bank, bank, bank_member_changes, nhopgroup_members_set, ipPrefix))
+                active_bank, bank, bank_member_changes, nhopgroup_members_set))
             {
                 SWSS_LOG_INFO("Failed setActiveBankHashBucketChanges");
                 return false;
@@ -862,12 +967,19 @@ bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_r
 
 bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, 
         FgNhgEntry *fgNhgEntry, std::vector<BankMemberChanges> &bank_member_changes, 
-        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set,
-        const IpPrefix &ipPrefix)
+        std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set)
 {
     SWSS_LOG_ENTER();
 
-    for (uint32_t bank_idx = 0; bank_idx < bank_member_changes.size(); bank_idx++)
+    /* Hash bucket changes of all banks are collected first and applied at once,
+     * so a bucket reassigned several times is only written with its final next hop.
+     * Changes computed before a failure are still applied, since the local bank maps
+     * already reflect them.
+     */
+    bool success = true;
+    m_bucketChanges.clear();
+
+    for (uint32_t bank_idx = 0; success && bank_idx < bank_member_changes.size(); bank_idx++)
     {
         if (bank_member_changes[bank_idx].active_nhs.size() != 0 ||
                 (bank_member_changes[bank_idx].nhs_to_add.size() != 0 &&
@@ -878,23 +990,22 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
              * simultaneously, nhs were added(nhs_to_add > 0). 
              * Route this to fn which deals with active banks
              */
-            if (!setActiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
-                        bank_idx, bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix))
-            {
-                return false;
-            }
+            success = setActiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
+                        bank_idx, bank_idx, bank_member_changes, nhopgroup_members_set);
         }
         else
         {
-            if (!setInactiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
-                        bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix))
-            {
-                return false;
-            }
+            success = setInactiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, 
+                        bank_idx, bank_member_changes, nhopgroup_members_set);
         }
     }
 
-    return true;
+    if (!commitHashBucketChanges(syncd_fg_route_entry))
+    {
+        return false;
+    }
+
+    return success;
 }
 
 
@@ -904,9 +1015,10 @@ bool FgNhgOrch::setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNh
 {
     SWSS_LOG_ENTER();
 
-    sai_status_t status;
     bool isWarmReboot = false;
     auto nexthopsMap = m_recoveryMap.find(ipPrefix.to_string());
+    /* Next hop of each hash bucket, in the order of hash bucket indices */
+    std::vector<NextHopKey> bucket_nhs;
     for (uint32_t i = 0; i < fgNhgEntry->hash_bucket_indices.size(); i++) 
     {
         uint32_t bank = i;
@@ -967,52 +1079,27 @@ bool FgNhgOrch::setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNh
                     bank_member_changes[bank].nhs_to_add.size()];
             }
 
-            // Create a next hop group member
-            sai_attribute_t nhgm_attr;
-            vector<sai_attribute_t> nhgm_attrs;
-            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-            nhgm_attr.value.oid = syncd_fg_route_entry.next_hop_group_id;
-            nhgm_attrs.push_back(nhgm_attr);
-
-            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-            nhgm_attr.value.oid = nhopgroup_members_set[bank_nh_memb];
-            nhgm_attrs.push_back(nhgm_attr);
-
-            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_INDEX;
-            nhgm_attr.value.s32 = j;
-            nhgm_attrs.push_back(nhgm_attr);
-
-            sai_object_id_t next_hop_group_member_id;
-            status = sai_next_hop_group_api->create_next_hop_group_member(
-                                                              &next_hop_group_member_id,
-                                                              gSwitchId,
-                                                              (uint32_t)nhgm_attrs.size(),
-                                                              nhgm_attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to create next hop group %" PRIx64 " member %" PRIx64 ": %d",
-                   syncd_fg_route_entry.next_hop_group_id, next_hop_group_member_id, status);
-                
-                if (!removeFineGrainedNextHopGroup(&syncd_fg_route_entry))
-                {
-                    SWSS_LOG_ERROR("Failed to clean-up after next-hop member creation failure");
-                }
-                
-                task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
-                if (handle_status != task_success)
-                {
-                    return parseHandleSaiStatusFailure(handle_status);
-                }
-            }
-
-            setStateDbRouteEntry(ipPrefix, j, bank_nh_memb);
+            bucket_nhs.push_back(bank_nh_memb);
             syncd_fg_route_entry.syncd_fgnhg_map[i][bank_nh_memb].push_back(j);
             syncd_fg_route_entry.active_nexthops.insert(bank_nh_memb);
-            syncd_fg_route_entry.nhopgroup_members.push_back(next_hop_group_member_id);
-            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
         }
     }
 
+    std::vector<sai_object_id_t> nh_oids;
+    std::vector<FieldValueTuple> fvs;
+    for (uint32_t j = 0; j < bucket_nhs.size(); j++)
+    {
+        nh_oids.push_back(nhopgroup_members_set[bucket_nhs[j]]);
+        fvs.push_back(FieldValueTuple(std::to_string(j), bucket_nhs[j].to_string()));
+    }
+
+    if (!createHashBucketMembers(syncd_fg_route_entry, nh_oids))
+    {
+        return false;
+    }
+
+    m_stateWarmRestartRouteTable.set(ipPrefix.to_string(), fvs);
+
     if (isWarmReboot)
     {
         m_recoveryMap.erase(nexthopsMap);
@@ -1124,9 +1211,10 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
         }
     }
  
+    FGNextHopGroupKey fg_nhg_key(fgNhgEntry->fg_nhg_name, nextHops);
     if (m_syncdFGRouteTables.find(vrf_id) != m_syncdFGRouteTables.end() &&
         m_syncdFGRouteTables.at(vrf_id).find(ipPrefix) != m_syncdFGRouteTables.at(vrf_id).end() &&
-        m_syncdFGRouteTables.at(vrf_id).at(ipPrefix).nhg_key == nextHops)
+        m_syncdFGRouteTables.at(vrf_id).at(ipPrefix) == fg_nhg_key)
     {
         return true;
     }
@@ -1137,8 +1225,52 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
         m_vrfOrch->increaseVrfRefCount(vrf_id);
     }
 
-    std::map<NextHopKey,sai_object_id_t> nhopgroup_members_set;
     auto syncd_fg_route_entry_it = m_syncdFGRouteTables.at(vrf_id).find(ipPrefix);
+    bool route_exists = (syncd_fg_route_entry_it != m_syncdFGRouteTables.at(vrf_id).end());
+
+    auto nhg_it = m_syncdFGNextHopGroups.find(fg_nhg_key);
+    if (nhg_it != m_syncdFGNextHopGroups.end())
+    {
+        /* Routes with the same FG_NHG and next hops share one FG next hop group */
+        if (nhg_it->second.active_nexthops.empty())
+        {
+            SWSS_LOG_INFO("There were no valid next-hops to add %s:%s", ipPrefix.to_string().c_str(),
+                    nextHops.to_string().c_str());
+            /* Let the route retry logic(upon false rc) take care of this case */
+            return false;
+        }
+
+        if (route_exists)
+        {
+            detachRouteFromFgNhg(vrf_id, ipPrefix);
+        }
+
+        nhg_it->second.routes.insert(std::make_pair(vrf_id, ipPrefix));
+        m_syncdFGRouteTables[vrf_id][ipPrefix] = fg_nhg_key;
+        setStateDbRouteEntry(ipPrefix, nhg_it->second);
+        /* The hash bucket layout of the shared group is kept over the one recovered for the route */
+        m_recoveryMap.erase(ipPrefix.to_string());
+
+        prevNhgWasFineGrained = false;
+        next_hop_id = nhg_it->second.next_hop_group_id;
+
+        SWSS_LOG_NOTICE("Route %s:%s shares next hop group with %zu other routes", ipPrefix.to_string().c_str(),
+                nextHops.to_string().c_str(), nhg_it->second.routes.size() - 1);
+        return true;
+    }
+
+    FGNextHopGroupEntry *syncd_fg_route_entry = NULL;
+    if (route_exists)
+    {
+        syncd_fg_route_entry = &(m_syncdFGNextHopGroups.at(syncd_fg_route_entry_it->second));
+        if (syncd_fg_route_entry->fg_nhg_entry != fgNhgEntry)
+        {
+            /* Next hops of the route moved to another FG_NHG, a new group is created */
+            syncd_fg_route_entry = NULL;
+        }
+    }
+
+    std::map<NextHopKey,sai_object_id_t> nhopgroup_members_set;
     bool next_hop_to_add = false;
 
     /* Default init with # of banks */
@@ -1188,7 +1320,7 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
             continue;
         }
 
-        if (syncd_fg_route_entry_it == m_syncdFGRouteTables.at(vrf_id).end())
+        if (!syncd_fg_route_entry)
         {
             bank_member_changes[fgNhgEntry->next_hops[nhk.ip_address].bank].
                 nhs_to_add.push_back(nhk);
@@ -1196,7 +1328,6 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
         }
         else 
         {
-            FGNextHopGroupEntry *syncd_fg_route_entry = &(syncd_fg_route_entry_it->second);
             if (syncd_fg_route_entry->active_nexthops.find(nhk) == 
                 syncd_fg_route_entry->active_nexthops.end())
             {
@@ -1209,9 +1340,8 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
         nhopgroup_members_set[nhk] = nhid;
     }
 
-    if (syncd_fg_route_entry_it != m_syncdFGRouteTables.at(vrf_id).end())
+    if (syncd_fg_route_entry)
     {
-        FGNextHopGroupEntry *syncd_fg_route_entry = &(syncd_fg_route_entry_it->second);
         /* Route exists, update FG ECMP group in SAI */
         for (auto nhk : syncd_fg_route_entry->active_nexthops)
         {
@@ -1227,11 +1357,54 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
             }
         }
 
-        if (!computeAndSetHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, bank_member_changes, 
-                nhopgroup_members_set, ipPrefix))
+        if (syncd_fg_route_entry->routes.size() > 1)
         {
-            return false;
+            /* Other routes keep their next hops on the shared group: the route moves to
+             * a copy of the group, which is then updated */
+            FGNextHopGroupEntry fg_route_entry;
+            if (!cloneFineGrainedNextHopGroup(*syncd_fg_route_entry, fg_route_entry, nextHops))
+            {
+                return false;
+            }
+            fg_route_entry.routes.insert(std::make_pair(vrf_id, ipPrefix));
+
+            if (!computeAndSetHashBucketChanges(&fg_route_entry, fgNhgEntry, bank_member_changes,
+                    nhopgroup_members_set))
+            {
+                if (!removeFineGrainedNextHopGroup(&fg_route_entry))
+                {
+                    SWSS_LOG_ERROR("Failed to clean-up copy of next hop group %s",
+                            syncd_fg_route_entry->nhg_key.to_string().c_str());
+                }
+                /* Release the references taken by the copy, its active next hops may have changed */
+                for (const auto &nh : syncd_fg_route_entry->active_nexthops)
+                {
+                    m_neighOrch->decreaseNextHopRefCount(nh);
+                }
+                setStateDbRouteEntry(ipPrefix, *syncd_fg_route_entry);
+                return false;
+            }
+
+            syncd_fg_route_entry->routes.erase(std::make_pair(vrf_id, ipPrefix));
+            fg_route_entry.nhg_key = nextHops;
+            m_syncdFGNextHopGroups[fg_nhg_key] = fg_route_entry;
+            prevNhgWasFineGrained = false;
         }
+        else
+        {
+            if (!computeAndSetHashBucketChanges(syncd_fg_route_entry, fgNhgEntry, bank_member_changes, 
+                    nhopgroup_members_set))
+            {
+                return false;
+            }
+
+            /* The route is the only user of the group, which was updated in place */
+            FGNextHopGroupEntry fg_route_entry = *syncd_fg_route_entry;
+            m_syncdFGNextHopGroups.erase(syncd_fg_route_entry_it->second);
+            fg_route_entry.nhg_key = nextHops;
+            m_syncdFGNextHopGroups[fg_nhg_key] = fg_route_entry;
+        }
+        m_syncdFGRouteTables[vrf_id][ipPrefix] = fg_nhg_key;
     }
     else
     {
@@ -1245,22 +1418,30 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
             return false;
         }
 
-        FGNextHopGroupEntry syncd_fg_route_entry;
-        if (!createFineGrainedNextHopGroup(syncd_fg_route_entry, fgNhgEntry, nextHops))
+        FGNextHopGroupEntry fg_route_entry;
+        fg_route_entry.fg_nhg_entry = fgNhgEntry;
+        fg_route_entry.nhg_key = nextHops;
+        if (!createFineGrainedNextHopGroup(fg_route_entry, fgNhgEntry, nextHops))
         {
             return false;
         }
 
-        if (!setNewNhgMembers(syncd_fg_route_entry, fgNhgEntry, bank_member_changes, nhopgroup_members_set, ipPrefix))
+        if (!setNewNhgMembers(fg_route_entry, fgNhgEntry, bank_member_changes, nhopgroup_members_set, ipPrefix))
         {
             return false;
         }
 
-        m_syncdFGRouteTables[vrf_id][ipPrefix] = syncd_fg_route_entry;
+        if (route_exists)
+        {
+            detachRouteFromFgNhg(vrf_id, ipPrefix);
+        }
+
+        fg_route_entry.routes.insert(std::make_pair(vrf_id, ipPrefix));
+        m_syncdFGNextHopGroups[fg_nhg_key] = fg_route_entry;
+        m_syncdFGRouteTables[vrf_id][ipPrefix] = fg_nhg_key;
 
         SWSS_LOG_NOTICE("Created route %s:%s", ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
     }
-    m_syncdFGRouteTables[vrf_id][ipPrefix].nhg_key = nextHops; 
 
     for (uint32_t bank_idx = 0; bank_idx < bank_member_changes.size(); bank_idx++)
     {
@@ -1279,7 +1460,7 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
         }
     }
 
-    next_hop_id =  m_syncdFGRouteTables[vrf_id][ipPrefix].next_hop_group_id;
+    next_hop_id = m_syncdFGNextHopGroups.at(fg_nhg_key).next_hop_group_id;
     return true;
 }
 
@@ -1309,16 +1490,27 @@ bool FgNhgOrch::removeFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix)
         return true;
     }
 
-    FGNextHopGroupEntry *syncd_fg_route_entry = &(it_route->second);
-    if (!removeFineGrainedNextHopGroup(syncd_fg_route_entry))
+    auto it_nhg = m_syncdFGNextHopGroups.find(it_route->second);
+    FGNextHopGroupEntry *syncd_fg_route_entry = &(it_nhg->second);
+    if (syncd_fg_route_entry->routes.size() > 1)
     {
-        SWSS_LOG_ERROR("Failed to clean-up fine grained ECMP SAI group");
-        return false;
+        /* The group is still used by other routes */
+        syncd_fg_route_entry->routes.erase(std::make_pair(vrf_id, ipPrefix));
     }
-
-    for (auto nh : syncd_fg_route_entry->active_nexthops)
+    else
     {
-        m_neighOrch->decreaseNextHopRefCount(nh);
+        if (!removeFineGrainedNextHopGroup(syncd_fg_route_entry))
+        {
+            SWSS_LOG_ERROR("Failed to clean-up fine grained ECMP SAI group");
+            return false;
+        }
+
+        for (auto nh : syncd_fg_route_entry->active_nexthops)
+        {
+            m_neighOrch->decreaseNextHopRefCount(nh);
+        }
+
+        m_syncdFGNextHopGroups.erase(it_nhg);
     }
 
     // remove state_db entry
@@ -1337,6 +1529,28 @@ bool FgNhgOrch::removeFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix)
 }
 
 
+/* detachRouteFromFgNhg: Removes a route, which moves to another FG next hop group, from its current one.
+ * The route still points to the current group in SAI until the route is set, so a group
+ * left without routes is only removed in doTask().
+ */
+void FgNhgOrch::detachRouteFromFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix)
+{
+    SWSS_LOG_ENTER();
+
+    auto &route_table = m_syncdFGRouteTables.at(vrf_id);
+    auto it_route = route_table.find(ipPrefix);
+    auto it_nhg = m_syncdFGNextHopGroups.find(it_route->second);
+
+    it_nhg->second.routes.erase(std::make_pair(vrf_id, ipPrefix));
+    if (it_nhg->second.routes.empty())
+    {
+        m_fgNhgsToRemove.push_back(it_nhg->second);
+        m_syncdFGNextHopGroups.erase(it_nhg);
+    }
+    route_table.erase(it_route);
+}
+
+
 vector<FieldValueTuple> FgNhgOrch::generateRouteTableFromNhgKey(NextHopGroupKey nhg)
 {
     SWSS_LOG_ENTER();
@@ -1575,7 +1789,7 @@ bool FgNhgOrch::doTaskFgNhgPrefix(const KeyOpFieldsValuesTuple & t)
         if (m_syncdFGRouteTables.find(vrf_id) != m_syncdFGRouteTables.end() &&
                     m_syncdFGRouteTables.at(vrf_id).find(ip_prefix) != m_syncdFGRouteTables.at(vrf_id).end())
         {
-            nhg = m_syncdFGRouteTables.at(vrf_id).at(ip_prefix).nhg_key;
+            nhg = m_syncdFGRouteTables.at(vrf_id).at(ip_prefix).second;
         } 
 
         auto delCache = m_fgPrefixDelCache.find(ip_prefix);
@@ -1786,6 +2000,36 @@ bool FgNhgOrch::doTaskFgNhgMember(const KeyOpFieldsValuesTuple & t)
 }
         
 
+void FgNhgOrch::doTask()
+{
+    SWSS_LOG_ENTER();
+
+    Orch::doTask();
+
+    /* Routes moved off these groups in this iteration, and were set to their new groups by now */
+    auto it = m_fgNhgsToRemove.begin();
+    while (it != m_fgNhgsToRemove.end())
+    {
+        if (!removeFineGrainedNextHopGroup(&(*it)))
+        {
+            SWSS_LOG_ERROR("Failed to remove unused next hop group %s", it->nhg_key.to_string().c_str());
+            it++;
+            continue;
+        }
+
+        for (const auto &nh : it->active_nexthops)
+        {
+            m_neighOrch->decreaseNextHopRefCount(nh);
+        }
+        it = m_fgNhgsToRemove.erase(it);
+    }
+
+    /* The state db route entries written while handling route and neighbor
+     * changes in this iteration are buffered, write them out at once */
+    m_statePipeline.flush();
+}
+
+
 void FgNhgOrch::doTask(Consumer& consumer) 
 {
     SWSS_LOG_ENTER();
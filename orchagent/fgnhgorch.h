@@ -6,6 +6,7 @@
 #include "intfsorch.h"
 #include "neighorch.h"
 #include "producerstatetable.h"
+#include "bulker.h"
 
 #include "ipaddress.h"
 #include "ipaddresses.h"
@@ -21,6 +22,12 @@ typedef std::vector<uint32_t> HashBuckets;
 typedef std::map<NextHopKey, HashBuckets> FGNextHopGroupMap;
 typedef std::vector<FGNextHopGroupMap> BankFGNextHopGroupMap;
 typedef std::map<Bank,Bank> InactiveBankMapsToBank;
+/* Map from hash bucket index to the next hop oid and next hop to set on it */
+typedef std::map<uint32_t, std::pair<sai_object_id_t, NextHopKey>> HashBucketChanges;
+/* Routes pointing to a FG next hop group: (vrf_id, ip prefix) */
+typedef std::set<std::pair<sai_object_id_t, IpPrefix>> FGRoutes;
+
+struct FgNhgEntry;
 
 struct FGNextHopGroupEntry
 {
@@ -30,6 +37,9 @@ struct FGNextHopGroupEntry
     BankFGNextHopGroupMap   syncd_fgnhg_map;        // Map of (bank) -> (nexthops) -> (index in nhopgroup_members)
     NextHopGroupKey         nhg_key;                // Full next hop group key
     InactiveBankMapsToBank  inactive_to_active_map; // Maps an inactive bank to an active one in terms of hash bkts
+    std::vector<sai_object_id_t> bucket_nh_oids;    // Next hop oid currently programmed on each hash bucket
+    FgNhgEntry              *fg_nhg_entry;          // FG_NHG the group was created for
+    FGRoutes                routes;                 // Routes sharing the group
 };
 
 struct FGNextHopInfo
@@ -39,8 +49,11 @@ struct FGNextHopInfo
     bool link_oper_state;                           // Current link oper state(optional)
 };
 
-/*TODO: can we make an optimization here when we get multiple routes pointing to a fgnhg */
-typedef std::map<IpPrefix, FGNextHopGroupEntry> FGRouteTable;
+/* A FG next hop group is shared by all routes with the same FG_NHG and next hops: (FG_NHG name, nhg key) */
+typedef std::pair<std::string, NextHopGroupKey> FGNextHopGroupKey;
+typedef std::map<FGNextHopGroupKey, FGNextHopGroupEntry> FGNextHopGroupTable;
+/* FGRouteTable: ip prefix, key of the FG next hop group the route points to */
+typedef std::map<IpPrefix, FGNextHopGroupKey> FGRouteTable;
 /* RouteTables: vrf_id, FGRouteTable */
 typedef std::map<sai_object_id_t, FGRouteTable> FGRouteTables;
 /* Name of the FG NHG group */
@@ -117,10 +130,14 @@ private:
 
     FgNhgs m_FgNhgs;
     FGRouteTables m_syncdFGRouteTables;
+    FGNextHopGroupTable m_syncdFGNextHopGroups;
+    // FG next hop groups left without routes, removed once the routes point to their new groups
+    std::vector<FGNextHopGroupEntry> m_fgNhgsToRemove;
     FgNhgMembers m_fgNhgNexthops;
     FgNhgPrefixes m_fgNhgPrefixes;
     bool isFineGrainedConfigured;
 
+    RedisPipeline m_statePipeline;
     Table m_stateWarmRestartRouteTable;
     ProducerStateTable m_routeTable;
 
@@ -131,28 +148,36 @@ private:
     // < ip_prefix, < HashBuckets, nh_ip>>
     WarmBootRecoveryMap m_recoveryMap;
 
+    // Hash bucket changes computed for the route being processed
+    HashBucketChanges m_bucketChanges;
+    ObjectBulker<sai_next_hop_group_api_t> m_nextHopGroupMemberBulker;
+
     bool setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     std::vector<BankMemberChanges> &bank_member_changes, 
                     std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
     bool computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry,
                     FgNhgEntry *fgNhgEntry, std::vector<BankMemberChanges> &bank_member_changes,
-                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
+                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set);
     bool setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     uint32_t bank, uint32_t syncd_bank, std::vector<BankMemberChanges> bank_member_changes,
-                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
+                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set);
     bool setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     uint32_t bank,std::vector<BankMemberChanges> &bank_member_changes,
-                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
+                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set);
     bool setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     uint32_t bank, std::vector<BankMemberChanges> bank_member_changes,
-                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
+                    std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set);
     void calculateBankHashBucketStartIndices(FgNhgEntry *fgNhgEntry);
-    void setStateDbRouteEntry(const IpPrefix&, uint32_t index, NextHopKey nextHop);
-    bool writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry, uint32_t index, sai_object_id_t nh_oid,
-                    const IpPrefix &ipPrefix, NextHopKey nextHop);
+    void setStateDbRouteEntry(const IpPrefix &ipPrefix, const FGNextHopGroupEntry &syncd_fg_route_entry);
+    void queueHashBucketChange(uint32_t index, sai_object_id_t nh_oid, const NextHopKey &nextHop);
+    bool commitHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry);
     bool createFineGrainedNextHopGroup(FGNextHopGroupEntry &syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     const NextHopGroupKey &nextHops);
+    bool createHashBucketMembers(FGNextHopGroupEntry &syncd_fg_route_entry, const std::vector<sai_object_id_t> &nh_oids);
+    bool cloneFineGrainedNextHopGroup(const FGNextHopGroupEntry &src_entry, FGNextHopGroupEntry &syncd_fg_route_entry,
+                    const NextHopGroupKey &nextHops);
     bool removeFineGrainedNextHopGroup(FGNextHopGroupEntry *syncd_fg_route_entry);
+    void detachRouteFromFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix);
 
     vector<FieldValueTuple> generateRouteTableFromNhgKey(NextHopGroupKey nhg);
     void cleanupIpInLinkToIpMap(const string &link, const IpAddress &ip, FgNhgEntry &fgNhg_entry);
@@ -160,6 +185,7 @@ private:
     bool doTaskFgNhg(const KeyOpFieldsValuesTuple&);
     bool doTaskFgNhgPrefix(const KeyOpFieldsValuesTuple&);
     bool doTaskFgNhgMember(const KeyOpFieldsValuesTuple&);
+    void doTask() override;
     void doTask(Consumer& consumer);
 };
 
@@ -0,0 +1,335 @@
+#include "counter_rates.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "schema.h"
+#include "logger.h"
+#include "counters_db_reply.h"
+#include "flex_counter_config.h"
+
+using std::string;
+using std::vector;
+using std::chrono::steady_clock;
+using swss::DBConnector;
+
+#define RATES_TABLE "RATES"
+
+bool isNativeRatesMode(const string& flex_counter_key)
+{
+    SWSS_LOG_ENTER();
+
+    string mode;
+    return getFlexCounterField(flex_counter_key, RATES_MODE_FIELD, mode) && mode == RATES_MODE_NATIVE;
+}
+
+CounterRates::CounterRates(
+        DBConnector *counters_db,
+        const string& object_type,
+        const vector<Rate>& rates) :
+    counters_db(counters_db),
+    object_type(object_type),
+    alpha_key(string(RATES_TABLE) + ":" + object_type),
+    alpha_field(object_type + "_ALPHA"),
+    rates(rates),
+    current(rates.size()),
+    last(rates.size()),
+    values(rates.size())
+{
+    SWSS_LOG_ENTER();
+
+    // Every counter is read once, even if it's used by several rates
+    for (const auto& rate: rates)
+    {
+        vector<size_t> counter_index;
+        for (const auto& counter: rate.counters)
+        {
+            size_t index = 0;
+            while (index < counter_fields.size() && counter_fields[index] != counter)
+            {
+                index++;
+            }
+            if (index == counter_fields.size())
+            {
+                counter_fields.push_back(counter);
+            }
+            counter_index.push_back(index);
+        }
+        rate_counter_index.push_back(counter_index);
+    }
+
+    if (isCounterSnapshotEnabled(object_type))
+    {
+        snapshot.reset(new CounterSnapshotReader(getCounterSnapshotName(object_type)));
+    }
+}
+
+void CounterRates::addObject(const string& object_id)
+{
+    SWSS_LOG_ENTER();
+
+    size_t slot;
+    if (!slots.add(object_id, slot))
+    {
+        return;
+    }
+
+    if (slot == states.size())
+    {
+        states.push_back(SampleState::NONE);
+        valid.push_back(0);
+        sample_times.emplace_back();
+        for (size_t r = 0; r < rates.size(); r++)
+        {
+            current[r].push_back(0);
+            last[r].push_back(0);
+            values[r].push_back(0);
+        }
+    }
+
+    states[slot] = SampleState::NONE;
+    valid[slot] = 0;
+    samples.reset(slot);
+}
+
+void CounterRates::removeObject(const string& object_id)
+{
+    SWSS_LOG_ENTER();
+
+    size_t slot;
+    if (!slots.remove(object_id, slot))
+    {
+        return;
+    }
+
+    states[slot] = SampleState::NONE;
+    valid[slot] = 0;
+}
+
+void CounterRates::poll()
+{
+    SWSS_LOG_ENTER();
+
+    double alpha = 0;
+    if (!readCounters(alpha))
+    {
+        // Same as the plugins, nothing is done until the smoothing factor is configured
+        SWSS_LOG_DEBUG("%s is not defined", alpha_field.c_str());
+        return;
+    }
+
+    computeRates(alpha, steady_clock::now());
+    writeRates();
+}
+
+// Reads the smoothing factor and the counters of all objects in one round
+// trip, the counters found in the snapshot are not requested
+bool CounterRates::readCounters(double& alpha)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = counters_db->getContext();
+
+    redisAppendCommand(ctx, "HGET %s %s", alpha_key.c_str(), alpha_field.c_str());
+
+    vector<const char *> argv = { "HMGET", nullptr };
+    for (const auto& field: counter_fields)
+    {
+        argv.push_back(field.c_str());
+    }
+
+    if (snapshot)
+    {
+        snapshot->refresh();
+    }
+
+    vector<uint64_t> counters(counter_fields.size());
+    vector<uint8_t> pending(slots.size());
+    vector<string> keys(slots.size());
+    for (size_t slot = 0; slot < slots.size(); slot++)
+    {
+        if (!slots.used(slot))
+        {
+            continue;
+        }
+
+        if (snapshot && snapshot->read(slots.objectId(slot), counter_fields, counters.data()))
+        {
+            valid[slot] = 1;
+            setCurrent(slot, counters);
+            continue;
+        }
+
+        pending[slot] = 1;
+        keys[slot] = string(COUNTERS_TABLE) + ":" + slots.objectId(slot);
+        argv[1] = keys[slot].c_str();
+        redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr);
+    }
+
+    CountersDbReplyPtr alpha_reply = getCountersDbReply(ctx);
+    bool has_alpha = alpha_reply->type == REDIS_REPLY_STRING;
+    if (has_alpha)
+    {
+        alpha = strtod(alpha_reply->str, nullptr);
+    }
+
+    for (size_t slot = 0; slot < slots.size(); slot++)
+    {
+        if (!pending[slot])
+        {
+            continue;
+        }
+
+        CountersDbReplyPtr reply = getCountersDbReply(ctx);
+        valid[slot] = 1;
+
+        for (size_t i = 0; i < counter_fields.size(); i++)
+        {
+            if (!getCountersDbCounter(reply.get(), i, counters[i]))
+            {
+                valid[slot] = 0;
+                break;
+            }
+        }
+
+        if (valid[slot])
+        {
+            setCurrent(slot, counters);
+        }
+    }
+
+    return has_alpha;
+}
+
+void CounterRates::setCurrent(size_t slot, const vector<uint64_t>& counters)
+{
+    for (size_t r = 0; r < rates.size(); r++)
+    {
+        uint64_t sum = 0;
+        for (auto index: rate_counter_index[r])
+        {
+            sum += counters[index];
+        }
+        current[r][slot] = sum;
+    }
+}
+
+// Computes the rates of all objects over the time elapsed since their last
+// sample, rates are unsmoothed on the first interval of an object and
+// smoothed with alpha afterwards
+void CounterRates::computeRates(double alpha, steady_clock::time_point now)
+{
+    SWSS_LOG_ENTER();
+
+    size_t count = slots.size();
+    vector<double> interval(count);
+    vector<double> weight(count);
+    vector<uint8_t> sampled(count);
+    vector<uint8_t> active(count);
+
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        if (!valid[slot])
+        {
+            continue;
+        }
+
+        bool unchanged = states[slot] != SampleState::NONE;
+        for (size_t r = 0; unchanged && r < rates.size(); r++)
+        {
+            unchanged = current[r][slot] == last[r][slot];
+        }
+        if (!samples.take(slot, unchanged))
+        {
+            continue;
+        }
+
+        sampled[slot] = 1;
+        interval[slot] = std::chrono::duration<double, std::milli>(now - sample_times[slot]).count();
+        sample_times[slot] = now;
+        active[slot] = states[slot] != SampleState::NONE && interval[slot] > 0;
+        weight[slot] = states[slot] == SampleState::DONE ? alpha : 1.0;
+    }
+
+    for (size_t r = 0; r < rates.size(); r++)
+    {
+        const uint64_t *cur = current[r].data();
+        const uint64_t *prev = last[r].data();
+        double *value = values[r].data();
+
+        for (size_t slot = 0; slot < count; slot++)
+        {
+            // Counters cleared in hardware give a zero rate rather than a negative one
+            double rate = active[slot] && cur[slot] >= prev[slot] ? static_cast<double>(cur[slot] - prev[slot]) / interval[slot] : 0;
+            double smoothed = weight[slot] * rate + (1.0 - weight[slot]) * value[slot];
+            value[slot] = active[slot] ? smoothed : value[slot];
+        }
+
+        for (size_t slot = 0; slot < count; slot++)
+        {
+            last[r][slot] = sampled[slot] ? current[r][slot] : last[r][slot];
+        }
+    }
+
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        if (!valid[slot])
+        {
+            // Start over once the counters are back, the last sample is stale
+            states[slot] = SampleState::NONE;
+        }
+        else if (active[slot])
+        {
+            states[slot] = SampleState::DONE;
+        }
+        else if (sampled[slot] && states[slot] == SampleState::NONE)
+        {
+            states[slot] = SampleState::COUNTERS_LAST;
+        }
+    }
+}
+
+// Writes the rates of all objects in one pipelined batch
+void CounterRates::writeRates()
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = counters_db->getContext();
+
+    vector<string> args;
+    vector<const char *> argv;
+    size_t pending = 0;
+    char buf[32];
+
+    for (size_t slot = 0; slot < slots.size(); slot++)
+    {
+        if (!valid[slot] || states[slot] != SampleState::DONE)
+        {
+            continue;
+        }
+
+        args.clear();
+        args.push_back("HMSET");
+        args.push_back(string(RATES_TABLE) + ":" + slots.objectId(slot));
+        for (size_t r = 0; r < rates.size(); r++)
+        {
+            snprintf(buf, sizeof(buf), "%.14g", values[r][slot]);
+            args.push_back(rates[r].name);
+            args.push_back(buf);
+        }
+
+        argv.clear();
+        for (const auto& arg: args)
+        {
+            argv.push_back(arg.c_str());
+        }
+
+        redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr);
+        pending++;
+    }
+
+    while (pending--)
+    {
+        getCountersDbReply(ctx);
+    }
+}
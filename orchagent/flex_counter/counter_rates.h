@@ -0,0 +1,95 @@
+#ifndef ORCHAGENT_COUNTER_RATES_H
+#define ORCHAGENT_COUNTER_RATES_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include "dbconnector.h"
+#include "counter_snapshot.h"
+#include "counter_slots.h"
+
+// FLEX_COUNTER|PORT_RATES and FLEX_COUNTER|RIF_RATES field selecting how
+// the RATES table is computed, read when orchagent starts
+#define RATES_MODE_FIELD    "RATES_MODE"
+#define RATES_MODE_PLUGIN   "plugin"
+#define RATES_MODE_NATIVE   "native"
+
+// Returns true if the rates of the flex counter key are computed in
+// orchagent instead of the port_rates.lua/rif_rates.lua plugins.
+bool isNativeRatesMode(const std::string& flex_counter_key);
+
+// CounterRates computes the smoothed rates of the RATES table in process,
+// as the port_rates.lua and rif_rates.lua plugins do server side. Rates are
+// in the plugins' unit, per millisecond, over the time elapsed between two
+// samples instead of the configured poll interval.
+//
+// The previous samples and rates are kept in memory. Each poll reads the
+// counters of all objects from the counter snapshot if it is enabled for the
+// object type, and the others in one pipelined round trip, computes the rates
+// of all objects in one pass over contiguous arrays and writes them with
+// one pipelined batch.
+// Samples unchanged since the last one of an object are skipped once by a
+// SampleFilter instead of giving a zero rate.
+class CounterRates
+{
+    public:
+        // A rate and the counters summed into it, e.g. RX_PPS from the
+        // unicast and non-unicast packet counters
+        struct Rate
+        {
+            std::string name;
+            std::vector<std::string> counters;
+        };
+
+        // object_type is PORT or RIF: the smoothing factor is read from
+        // RATES:<object_type> <object_type>_ALPHA
+        CounterRates(
+                swss::DBConnector *counters_db,
+                const std::string& object_type,
+                const std::vector<Rate>& rates);
+
+        CounterRates(const CounterRates&) = delete;
+        CounterRates& operator=(const CounterRates&) = delete;
+
+        void addObject(const std::string& object_id);
+        void removeObject(const std::string& object_id);
+
+        void poll();
+
+    private:
+        enum class SampleState : uint8_t
+        {
+            NONE,
+            COUNTERS_LAST,
+            DONE,
+        };
+
+        bool readCounters(double& alpha);
+        void setCurrent(size_t slot, const std::vector<uint64_t>& counters);
+        void computeRates(double alpha, std::chrono::steady_clock::time_point now);
+        void writeRates();
+
+        swss::DBConnector *counters_db;
+        std::string object_type;
+        std::string alpha_key;
+        std::string alpha_field;
+        std::vector<Rate> rates;
+        std::vector<std::string> counter_fields;
+        std::vector<std::vector<size_t>> rate_counter_index;
+        std::unique_ptr<CounterSnapshotReader> snapshot;
+
+        // Objects and their state, indexed by slot
+        CounterSlots slots;
+        SampleFilter samples;
+        std::vector<SampleState> states;
+        std::vector<uint8_t> valid;
+        std::vector<std::chrono::steady_clock::time_point> sample_times;
+
+        // Per rate arrays, indexed by slot
+        std::vector<std::vector<uint64_t>> current;
+        std::vector<std::vector<uint64_t>> last;
+        std::vector<std::vector<double>> values;
+};
+
+#endif // ORCHAGENT_COUNTER_RATES_H
@@ -0,0 +1,121 @@
+#include "counter_slots.h"
+
+using std::string;
+using std::chrono::steady_clock;
+
+size_t CounterSlots::allocate()
+{
+    size_t slot;
+    if (!free_slots.empty())
+    {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    else
+    {
+        slot = slot_used.size();
+        object_ids.emplace_back();
+        slot_used.push_back(0);
+    }
+
+    slot_used[slot] = 1;
+    used_count++;
+    return slot;
+}
+
+void CounterSlots::release(size_t slot)
+{
+    if (!used(slot))
+    {
+        return;
+    }
+
+    object_ids[slot].clear();
+    slot_used[slot] = 0;
+    free_slots.push_back(slot);
+    used_count--;
+}
+
+bool CounterSlots::add(const string& object_id, size_t& slot)
+{
+    auto it = object_slots.find(object_id);
+    if (it != object_slots.end())
+    {
+        slot = it->second;
+        return false;
+    }
+
+    slot = allocate();
+    object_ids[slot] = object_id;
+    object_slots[object_id] = slot;
+    return true;
+}
+
+bool CounterSlots::remove(const string& object_id, size_t& slot)
+{
+    auto it = object_slots.find(object_id);
+    if (it == object_slots.end())
+    {
+        return false;
+    }
+
+    slot = it->second;
+    object_slots.erase(it);
+    release(slot);
+    return true;
+}
+
+bool CounterSlots::find(const string& object_id, size_t& slot) const
+{
+    auto it = object_slots.find(object_id);
+    if (it == object_slots.end())
+    {
+        return false;
+    }
+
+    slot = it->second;
+    return true;
+}
+
+bool SampleFilter::take(size_t slot, bool unchanged, steady_clock::time_point now)
+{
+    if (!unchanged)
+    {
+        reset(slot);
+        return true;
+    }
+
+    if (slot >= skipped.size() || !skipped[slot])
+    {
+        skip(slot, now);
+        return false;
+    }
+
+    if (now - skip_times[slot] < hold)
+    {
+        return false;
+    }
+
+    skipped[slot] = 0;
+    return true;
+}
+
+void SampleFilter::skip(size_t slot, steady_clock::time_point now)
+{
+    if (slot >= skipped.size())
+    {
+        skipped.resize(slot + 1, 0);
+        skip_times.resize(slot + 1);
+    }
+
+    skipped[slot] = 1;
+    skip_times[slot] = now;
+}
+
+void SampleFilter::reset(size_t slot)
+{
+    if (slot < skipped.size())
+    {
+        skipped[slot] = 0;
+    }
+}
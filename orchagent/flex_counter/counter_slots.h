@@ -0,0 +1,102 @@
+#ifndef ORCHAGENT_COUNTER_SLOTS_H
+#define ORCHAGENT_COUNTER_SLOTS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The orchagent components processing counters in process, CounterRates,
+// WatermarkAggregator and PfcWdDetector, keep the state of their objects in
+// arrays indexed by slot and process all the slots in one pass per poll.
+
+// CounterSlots assigns the slots. The slots of removed objects are reused
+// first, so the arrays only grow to the largest number of objects at once.
+class CounterSlots
+{
+    public:
+        // Returns a slot for an object without id, e.g. a PFC watchdog queue
+        size_t allocate();
+        void release(size_t slot);
+
+        // Returns true and the slot of the object if it was not added yet
+        bool add(const std::string& object_id, size_t& slot);
+        // Returns true and the slot the object had if it was added
+        bool remove(const std::string& object_id, size_t& slot);
+        // Returns true and the slot of the object if it was added
+        bool find(const std::string& object_id, size_t& slot) const;
+
+        bool used(size_t slot) const
+        {
+            return slot < slot_used.size() && slot_used[slot];
+        }
+
+        // Empty for the slots not used and the objects without id
+        const std::string& objectId(size_t slot) const
+        {
+            return object_ids[slot];
+        }
+
+        // Number of slots, the size of the arrays indexed by slot
+        size_t size() const
+        {
+            return slot_used.size();
+        }
+
+        // Number of slots in use
+        size_t count() const
+        {
+            return used_count;
+        }
+
+    private:
+        std::vector<std::string> object_ids;
+        std::vector<uint8_t> slot_used;
+        std::vector<size_t> free_slots;
+        std::unordered_map<std::string, size_t> object_slots;
+        size_t used_count = 0;
+};
+
+// The counters are polled by syncd, and orchagent polls them on its own
+// timer, not in phase with syncd: a sample read between two syncd polls is
+// the same as the previous one and tells nothing about the time between
+// them. SampleFilter skips a sample unchanged since the last one of its
+// slot, as syncd may not have polled the counters again. Unchanged again
+// after the hold, syncd did poll and the counters really did not move.
+class SampleFilter
+{
+    public:
+        // With no hold, an unchanged sample is skipped once
+        explicit SampleFilter(
+                std::chrono::steady_clock::duration hold = std::chrono::steady_clock::duration::zero()) :
+            hold(hold)
+        {
+        }
+
+        void setHold(std::chrono::steady_clock::duration hold)
+        {
+            this->hold = hold;
+        }
+
+        // Returns true if the sample of the slot is to be processed, now is
+        // only needed with a hold
+        bool take(
+                size_t slot,
+                bool unchanged,
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::time_point());
+
+        // Counts a sample of the slot as skipped at now, the hold starts
+        // there, e.g. when the counters of the slot are cleared
+        void skip(size_t slot, std::chrono::steady_clock::time_point now);
+
+        // Forgets the skipped sample of a slot, e.g. when its object changes
+        void reset(size_t slot);
+
+    private:
+        std::chrono::steady_clock::duration hold;
+        std::vector<uint8_t> skipped;
+        std::vector<std::chrono::steady_clock::time_point> skip_times;
+};
+
+#endif // ORCHAGENT_COUNTER_SLOTS_H
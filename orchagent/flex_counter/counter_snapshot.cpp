@@ -0,0 +1,403 @@
+#include "counter_snapshot.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "logger.h"
+#include "flex_counter_config.h"
+
+using std::string;
+using std::vector;
+using std::atomic;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Counter snapshot requires lock free 64 bit atomics");
+
+namespace
+{
+    const uint32_t SNAPSHOT_MAGIC = 0x534e4150;
+    const uint32_t SNAPSHOT_VERSION = 1;
+    const size_t COUNTER_NAME_SIZE = 64;
+    const size_t OBJECT_ID_SIZE = 64;
+    const int MAX_READ_ATTEMPTS = 16;
+
+    struct SnapshotHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t counter_count;
+        uint64_t max_objects;
+        // Number of slots in use, slots are only added
+        atomic<uint64_t> object_count;
+        // Cleared by the producer before removing the region
+        atomic<uint64_t> open;
+    };
+
+    struct ObjectSlot
+    {
+        char object_id[OBJECT_ID_SIZE];
+        // Odd while the counters are being written, 0 until the first write
+        atomic<uint64_t> seq;
+        // Followed by the counters
+    };
+
+    size_t slotSize(size_t counter_count)
+    {
+        return sizeof(ObjectSlot) + counter_count * sizeof(atomic<uint64_t>);
+    }
+
+    size_t regionSize(size_t counter_count, size_t max_objects)
+    {
+        return sizeof(SnapshotHeader) + counter_count * COUNTER_NAME_SIZE + max_objects * slotSize(counter_count);
+    }
+
+    SnapshotHeader *getHeader(void *region)
+    {
+        return static_cast<SnapshotHeader *>(region);
+    }
+
+    char *getCounterName(void *region, size_t index)
+    {
+        return static_cast<char *>(region) + sizeof(SnapshotHeader) + index * COUNTER_NAME_SIZE;
+    }
+
+    ObjectSlot *getSlot(void *region, size_t slot)
+    {
+        size_t counter_count = getHeader(region)->counter_count;
+        char *slots = getCounterName(region, counter_count);
+        return reinterpret_cast<ObjectSlot *>(slots + slot * slotSize(counter_count));
+    }
+
+    atomic<uint64_t> *getCounters(ObjectSlot *slot)
+    {
+        return reinterpret_cast<atomic<uint64_t> *>(slot + 1);
+    }
+}
+
+bool isCounterSnapshotEnabled(const string& flex_counter_key)
+{
+    SWSS_LOG_ENTER();
+
+    string value;
+    return getFlexCounterField(flex_counter_key, COUNTER_SNAPSHOT_FIELD, value) && value == COUNTER_SNAPSHOT_ENABLE;
+}
+
+string getCounterSnapshotName(const string& flex_counter_key)
+{
+    return "/swss_counters_" + flex_counter_key;
+}
+
+CounterSnapshotWriter::CounterSnapshotWriter(
+        const string& name,
+        const vector<string>& counter_names,
+        size_t max_objects) :
+    name(name),
+    counter_count(counter_names.size()),
+    max_objects(max_objects)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto& counter_name: counter_names)
+    {
+        if (counter_name.size() >= COUNTER_NAME_SIZE)
+        {
+            SWSS_LOG_THROW("Counter name %s is too long for snapshot %s", counter_name.c_str(), name.c_str());
+        }
+    }
+
+    // A region left by a previous producer is detached by its readers once removed
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        SWSS_LOG_THROW("Failed to create counter snapshot %s: %s", name.c_str(), strerror(errno));
+    }
+
+    region_size = regionSize(counter_count, max_objects);
+    if (ftruncate(fd, static_cast<off_t>(region_size)) != 0)
+    {
+        int err = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        SWSS_LOG_THROW("Failed to size counter snapshot %s: %s", name.c_str(), strerror(err));
+    }
+
+    region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int err = errno;
+    close(fd);
+    if (region == MAP_FAILED)
+    {
+        region = nullptr;
+        shm_unlink(name.c_str());
+        SWSS_LOG_THROW("Failed to map counter snapshot %s: %s", name.c_str(), strerror(err));
+    }
+
+    SnapshotHeader *header = new (region) SnapshotHeader();
+    header->magic = SNAPSHOT_MAGIC;
+    header->version = SNAPSHOT_VERSION;
+    header->counter_count = counter_count;
+    header->max_objects = max_objects;
+    header->object_count.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < counter_count; i++)
+    {
+        strncpy(getCounterName(region, i), counter_names[i].c_str(), COUNTER_NAME_SIZE);
+    }
+
+    // Readers only use the region once it is open
+    header->open.store(1, std::memory_order_release);
+}
+
+CounterSnapshotWriter::~CounterSnapshotWriter()
+{
+    if (region == nullptr)
+    {
+        return;
+    }
+
+    getHeader(region)->open.store(0, std::memory_order_release);
+    munmap(region, region_size);
+    shm_unlink(name.c_str());
+}
+
+size_t CounterSnapshotWriter::addObject(const string& object_id)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = object_slots.find(object_id);
+    if (it != object_slots.end())
+    {
+        return it->second;
+    }
+
+    if (object_slots.size() >= max_objects)
+    {
+        SWSS_LOG_THROW("Counter snapshot %s is full, %zu objects", name.c_str(), max_objects);
+    }
+    if (object_id.size() >= OBJECT_ID_SIZE)
+    {
+        SWSS_LOG_THROW("Object id %s is too long for snapshot %s", object_id.c_str(), name.c_str());
+    }
+
+    size_t slot = object_slots.size();
+    ObjectSlot *object_slot = new (getSlot(region, slot)) ObjectSlot();
+    strncpy(object_slot->object_id, object_id.c_str(), OBJECT_ID_SIZE);
+    object_slot->seq.store(0, std::memory_order_relaxed);
+    atomic<uint64_t> *counters = getCounters(object_slot);
+    for (size_t i = 0; i < counter_count; i++)
+    {
+        new (&counters[i]) atomic<uint64_t>(0);
+    }
+
+    // Publish the slot once its object id is written
+    getHeader(region)->object_count.store(slot + 1, std::memory_order_release);
+    object_slots[object_id] = slot;
+    return slot;
+}
+
+void CounterSnapshotWriter::write(size_t slot, const uint64_t *values)
+{
+    if (slot >= object_slots.size())
+    {
+        SWSS_LOG_THROW("Invalid slot %zu in counter snapshot %s", slot, name.c_str());
+    }
+
+    ObjectSlot *object_slot = getSlot(region, slot);
+    atomic<uint64_t> *counters = getCounters(object_slot);
+
+    uint64_t seq = object_slot->seq.load(std::memory_order_relaxed);
+    object_slot->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < counter_count; i++)
+    {
+        counters[i].store(values[i], std::memory_order_relaxed);
+    }
+
+    object_slot->seq.store(seq + 2, std::memory_order_release);
+}
+
+CounterSnapshotReader::CounterSnapshotReader(const string& name) :
+    name(name)
+{
+}
+
+CounterSnapshotReader::~CounterSnapshotReader()
+{
+    detach();
+}
+
+bool CounterSnapshotReader::attach()
+{
+    SWSS_LOG_ENTER();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader))
+    {
+        close(fd);
+        return false;
+    }
+
+    region_size = static_cast<size_t>(st.st_size);
+    region_dev = st.st_dev;
+    region_ino = st.st_ino;
+    region = mmap(nullptr, region_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED)
+    {
+        region = nullptr;
+        return false;
+    }
+
+    SnapshotHeader *header = getHeader(region);
+    if (!header->open.load(std::memory_order_acquire) ||
+        header->magic != SNAPSHOT_MAGIC ||
+        header->version != SNAPSHOT_VERSION ||
+        region_size < regionSize(header->counter_count, header->max_objects))
+    {
+        detach();
+        return false;
+    }
+
+    for (size_t i = 0; i < header->counter_count; i++)
+    {
+        const char *counter_name = getCounterName(region, i);
+        counter_index[string(counter_name, strnlen(counter_name, COUNTER_NAME_SIZE))] = i;
+    }
+
+    SWSS_LOG_NOTICE("Attached counter snapshot %s", name.c_str());
+    return true;
+}
+
+void CounterSnapshotReader::detach()
+{
+    if (region != nullptr)
+    {
+        munmap(region, region_size);
+        region = nullptr;
+    }
+    counter_index.clear();
+    object_slots.clear();
+    known_objects = 0;
+}
+
+void CounterSnapshotReader::refresh()
+{
+    SWSS_LOG_ENTER();
+
+    if (region == nullptr)
+    {
+        attach();
+        return;
+    }
+
+    // The region of a producer that did not exit cleanly is still open, but
+    // its name is removed or taken by the region of the new producer
+    bool replaced = true;
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd >= 0)
+    {
+        struct stat st;
+        replaced = fstat(fd, &st) != 0 || st.st_dev != region_dev || st.st_ino != region_ino;
+        close(fd);
+    }
+
+    if (replaced || !getHeader(region)->open.load(std::memory_order_acquire))
+    {
+        SWSS_LOG_NOTICE("Counter snapshot %s was replaced", name.c_str());
+        detach();
+        attach();
+    }
+}
+
+void CounterSnapshotReader::refreshObjects()
+{
+    SnapshotHeader *header = getHeader(region);
+    size_t count = header->object_count.load(std::memory_order_acquire);
+    if (count > header->max_objects)
+    {
+        count = header->max_objects;
+    }
+
+    for (; known_objects < count; known_objects++)
+    {
+        const char *object_id = getSlot(region, known_objects)->object_id;
+        object_slots[string(object_id, strnlen(object_id, OBJECT_ID_SIZE))] = known_objects;
+    }
+}
+
+bool CounterSnapshotReader::read(
+        const string& object_id,
+        const vector<string>& counter_names,
+        uint64_t *values)
+{
+    // The region is only attached by refresh(), once per poll
+    if (region == nullptr)
+    {
+        return false;
+    }
+    if (!getHeader(region)->open.load(std::memory_order_acquire))
+    {
+        // The producer removed its region, a new one is attached on refresh()
+        detach();
+        return false;
+    }
+
+    refreshObjects();
+    auto it = object_slots.find(object_id);
+    if (it == object_slots.end())
+    {
+        return false;
+    }
+
+    read_index.clear();
+    for (const auto& counter_name: counter_names)
+    {
+        auto index = counter_index.find(counter_name);
+        if (index == counter_index.end())
+        {
+            return false;
+        }
+        read_index.push_back(index->second);
+    }
+
+    ObjectSlot *object_slot = getSlot(region, it->second);
+    const atomic<uint64_t> *counters = getCounters(object_slot);
+
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++)
+    {
+        uint64_t seq = object_slot->seq.load(std::memory_order_acquire);
+        if (seq == 0)
+        {
+            // Not written yet
+            return false;
+        }
+        if (seq & 1)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < read_index.size(); i++)
+        {
+            values[i] = counters[read_index[i]].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (object_slot->seq.load(std::memory_order_relaxed) == seq)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
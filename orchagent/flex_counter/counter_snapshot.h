@@ -0,0 +1,105 @@
+#ifndef ORCHAGENT_COUNTER_SNAPSHOT_H
+#define ORCHAGENT_COUNTER_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <sys/types.h>
+
+// FLEX_COUNTER|<group> field letting orchagent read the counters of the group
+// from the shared memory snapshot of the counter producer, read when
+// orchagent starts. The counters are still published in COUNTERS_DB.
+#define COUNTER_SNAPSHOT_FIELD     "COUNTER_SNAPSHOT"
+#define COUNTER_SNAPSHOT_ENABLE    "enable"
+
+// Returns true if the counters of the flex counter key may be read from the
+// shared memory snapshot.
+bool isCounterSnapshotEnabled(const std::string& flex_counter_key);
+
+// Name of the shared memory region holding the counters of a flex counter
+// group, e.g. /swss_counters_PORT for FLEX_COUNTER|PORT
+std::string getCounterSnapshotName(const std::string& flex_counter_key);
+
+// The snapshot region holds the latest value of a fixed set of counters for
+// each object, as the producer writes them to COUNTERS_DB. Each object slot
+// is protected by a sequence lock: the producer never waits for readers and
+// readers retry while a slot is being written.
+//
+// Region layout: a header, the counter names, then one slot per object with
+// its object id, its sequence number and its counters, indexed by counter.
+
+// CounterSnapshotWriter is meant for the counter producer, syncd, which is
+// not part of this tree: until it writes the regions, all the reads fall
+// back to COUNTERS_DB.
+class CounterSnapshotWriter
+{
+    public:
+        // Creates the region, replacing any region left with the same name
+        CounterSnapshotWriter(
+                const std::string& name,
+                const std::vector<std::string>& counter_names,
+                size_t max_objects);
+        ~CounterSnapshotWriter();
+
+        CounterSnapshotWriter(const CounterSnapshotWriter&) = delete;
+        CounterSnapshotWriter& operator=(const CounterSnapshotWriter&) = delete;
+
+        // Returns the slot of the object, adding it if needed
+        size_t addObject(const std::string& object_id);
+
+        // Writes the counters of a slot, in the order of counter_names
+        void write(size_t slot, const uint64_t *values);
+
+    private:
+        std::string name;
+        void *region = nullptr;
+        size_t region_size = 0;
+        size_t counter_count;
+        size_t max_objects;
+        std::unordered_map<std::string, size_t> object_slots;
+};
+
+// CounterSnapshotReader is used by the orchagent components reading
+// counters. Reads fail, and callers fall back to COUNTERS_DB, while the
+// region or the object is missing.
+//
+// Only refresh() looks up the region, so reads while no producer runs cost
+// no system call. A producer that exits without removing its region leaves
+// it open, the reader only notices the region was replaced or removed on
+// refresh().
+class CounterSnapshotReader
+{
+    public:
+        explicit CounterSnapshotReader(const std::string& name);
+        ~CounterSnapshotReader();
+
+        CounterSnapshotReader(const CounterSnapshotReader&) = delete;
+        CounterSnapshotReader& operator=(const CounterSnapshotReader&) = delete;
+
+        // Attaches to the current region of the producer, or detaches from a
+        // replaced one, to call once per poll before the reads
+        void refresh();
+
+        // Reads the named counters of an object into values
+        bool read(
+                const std::string& object_id,
+                const std::vector<std::string>& counter_names,
+                uint64_t *values);
+
+    private:
+        bool attach();
+        void detach();
+        void refreshObjects();
+
+        std::string name;
+        void *region = nullptr;
+        size_t region_size = 0;
+        dev_t region_dev = 0;
+        ino_t region_ino = 0;
+        std::unordered_map<std::string, size_t> counter_index;
+        std::unordered_map<std::string, size_t> object_slots;
+        size_t known_objects = 0;
+        std::vector<size_t> read_index;
+};
+
+#endif // ORCHAGENT_COUNTER_SNAPSHOT_H
@@ -0,0 +1,39 @@
+#include "counters_db_reply.h"
+
+#include <cstdlib>
+
+#include "logger.h"
+
+CountersDbReplyPtr getCountersDbReply(redisContext *ctx)
+{
+    void *reply = nullptr;
+    if (redisGetReply(ctx, &reply) != REDIS_OK || reply == nullptr)
+    {
+        SWSS_LOG_THROW("Failed to get COUNTERS_DB reply: %s", ctx->errstr);
+    }
+
+    return CountersDbReplyPtr(static_cast<redisReply *>(reply));
+}
+
+const char *getCountersDbField(const redisReply *reply, size_t index)
+{
+    if (reply == nullptr || reply->type != REDIS_REPLY_ARRAY || index >= reply->elements ||
+        reply->element[index]->type != REDIS_REPLY_STRING)
+    {
+        return nullptr;
+    }
+
+    return reply->element[index]->str;
+}
+
+bool getCountersDbCounter(const redisReply *reply, size_t index, uint64_t &value)
+{
+    const char *str = getCountersDbField(reply, index);
+    if (str == nullptr)
+    {
+        return false;
+    }
+
+    value = strtoull(str, nullptr, 10);
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef ORCHAGENT_COUNTERS_DB_REPLY_H
+#define ORCHAGENT_COUNTERS_DB_REPLY_H
+
+#include <cstdint>
+#include <memory>
+
+#include "dbconnector.h"
+
+// Readers of the replies of COUNTERS_DB commands pipelined with
+// redisAppendCommand, the replies are taken in the order of the commands.
+
+struct CountersDbReplyDeleter
+{
+    void operator()(redisReply *reply) const
+    {
+        freeReplyObject(reply);
+    }
+};
+
+typedef std::unique_ptr<redisReply, CountersDbReplyDeleter> CountersDbReplyPtr;
+
+// Takes the next reply of the pipeline, throws if the connection failed
+CountersDbReplyPtr getCountersDbReply(redisContext *ctx);
+
+// Returns the field at index of an HMGET reply, nullptr if the field is missing
+const char *getCountersDbField(const redisReply *reply, size_t index);
+
+// Parses the counter at index of an HMGET reply into value, returns false and
+// leaves value unchanged if the field is missing
+bool getCountersDbCounter(const redisReply *reply, size_t index, uint64_t &value);
+
+#endif // ORCHAGENT_COUNTERS_DB_REPLY_H
@@ -0,0 +1,20 @@
+#include "flex_counter_config.h"
+
+#include "schema.h"
+#include "table.h"
+#include "logger.h"
+
+using std::string;
+using swss::DBConnector;
+using swss::Table;
+
+bool getFlexCounterField(const string& group, const string& field, string& value)
+{
+    SWSS_LOG_ENTER();
+
+    // One connection for all the groups and fields
+    static DBConnector config_db("CONFIG_DB", 0);
+    static Table flex_counter_table(&config_db, CFG_FLEX_COUNTER_TABLE_NAME);
+
+    return flex_counter_table.hget(group, field, value);
+}
@@ -0,0 +1,11 @@
+#ifndef ORCHAGENT_FLEX_COUNTER_CONFIG_H
+#define ORCHAGENT_FLEX_COUNTER_CONFIG_H
+
+#include <string>
+
+// Reads a field of the FLEX_COUNTER|<group> entry of CONFIG_DB, e.g. the
+// RATES_MODE, WATERMARK_MODE and COUNTER_SNAPSHOT fields read when
+// orchagent starts. Returns false if the field is not set.
+bool getFlexCounterField(const std::string& group, const std::string& field, std::string& value);
+
+#endif // ORCHAGENT_FLEX_COUNTER_CONFIG_H
@@ -17,6 +17,7 @@ using std::vector;
 using swss::DBConnector;
 using swss::FieldValueTuple;
 using swss::ProducerTable;
+using swss::RedisPipeline;
 
 const string FLEX_COUNTER_ENABLE("enable");
 const string FLEX_COUNTER_DISABLE("disable");
@@ -51,8 +52,9 @@ FlexCounterManager::FlexCounterManager(
     polling_interval(polling_interval),
     enabled(enabled),
     flex_counter_db(new DBConnector("FLEX_COUNTER_DB", 0)),
+    flex_counter_pipeline(new RedisPipeline(flex_counter_db.get())),
     flex_counter_group_table(new ProducerTable(flex_counter_db.get(), FLEX_COUNTER_GROUP_TABLE)),
-    flex_counter_table(new ProducerTable(flex_counter_db.get(), FLEX_COUNTER_TABLE))
+    flex_counter_table(new ProducerTable(flex_counter_pipeline.get(), FLEX_COUNTER_TABLE, true))
 {
     SWSS_LOG_ENTER();
 
@@ -69,6 +71,7 @@ FlexCounterManager::~FlexCounterManager()
     {
         flex_counter_table->del(getFlexCounterTableKey(group_name, counter));
     }
+    flex_counter_table->flush();
 
     flex_counter_group_table->del(group_name);
 
@@ -167,16 +170,50 @@ void FlexCounterManager::setCounterIdList(
 
     std::vector<swss::FieldValueTuple> field_values =
     {
-        FieldValueTuple(counter_type_it->second, serializeCounterStats(counter_stats))
+        FieldValueTuple(counter_type_it->second, getSerializedCounterStats(counter_stats))
     };
     flex_counter_table->set(getFlexCounterTableKey(group_name, object_id), field_values);
     installed_counters.insert(object_id);
+    commit();
 
     SWSS_LOG_DEBUG("Updated flex counter id list for object '%" PRIu64 "' in group '%s'.",
             object_id,
             group_name.c_str());
 }
 
+// setCounterIdList configures flex counters to poll the same set of stats on
+// all the given objects. The counter id lists are written in one batch.
+void FlexCounterManager::setCounterIdList(
+        const vector<sai_object_id_t>& object_ids,
+        const CounterType counter_type,
+        const unordered_set<string>& counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    auto counter_type_it = counter_id_field_lookup.find(counter_type);
+    if (counter_type_it == counter_id_field_lookup.end())
+    {
+        SWSS_LOG_ERROR("Could not update flex counter id list for group '%s': counter type not found.",
+                group_name.c_str());
+        return;
+    }
+
+    std::vector<swss::FieldValueTuple> field_values =
+    {
+        FieldValueTuple(counter_type_it->second, getSerializedCounterStats(counter_stats))
+    };
+    for (const auto& object_id: object_ids)
+    {
+        flex_counter_table->set(getFlexCounterTableKey(group_name, object_id), field_values);
+        installed_counters.insert(object_id);
+    }
+    commit();
+
+    SWSS_LOG_DEBUG("Updated flex counter id list for %zu objects in group '%s'.",
+            object_ids.size(),
+            group_name.c_str());
+}
+
 // clearCounterIdList clears all stats that are currently being polled from
 // the given object.
 void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
@@ -194,12 +231,40 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
 
     flex_counter_table->del(getFlexCounterTableKey(group_name, object_id));
     installed_counters.erase(counter_it);
+    commit();
 
     SWSS_LOG_DEBUG("Cleared flex counter id list for object '%" PRIu64 "' in group '%s'.",
             object_id,
             group_name.c_str());
 }
 
+// In deferred mode the counter id lists are only written to FLEX_COUNTER_DB
+// when flush is called or the mode is left, e.g. to register the counters of
+// all ports in one batch during boot.
+void FlexCounterManager::setDeferredMode(const bool deferred)
+{
+    SWSS_LOG_ENTER();
+
+    this->deferred = deferred;
+    commit();
+}
+
+// flush writes the buffered counter id lists to FLEX_COUNTER_DB.
+void FlexCounterManager::flush()
+{
+    SWSS_LOG_ENTER();
+
+    flex_counter_table->flush();
+}
+
+void FlexCounterManager::commit()
+{
+    if (!deferred)
+    {
+        flex_counter_table->flush();
+    }
+}
+
 string FlexCounterManager::getFlexCounterTableKey(
         const string& group_name,
         const sai_object_id_t object_id) const
@@ -230,3 +295,17 @@ string FlexCounterManager::serializeCounterStats(
 
     return stats_string;
 }
+
+const string& FlexCounterManager::getSerializedCounterStats(
+        const unordered_set<string>& counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    if (counter_stats != last_counter_stats || last_serialized_counter_stats.empty())
+    {
+        last_counter_stats = counter_stats;
+        last_serialized_counter_stats = serializeCounterStats(counter_stats);
+    }
+
+    return last_serialized_counter_stats;
+}
@@ -2,9 +2,11 @@
 #define ORCHAGENT_FLEX_COUNTER_MANAGER_H
 
 #include <string>
+#include <vector>
 #include <unordered_set>
 #include <unordered_map>
 #include "dbconnector.h"
+#include "redispipeline.h"
 #include "producertable.h"
 #include <inttypes.h>
 
@@ -52,8 +54,15 @@ class FlexCounterManager
                 const sai_object_id_t object_id,
                 const CounterType counter_type,
                 const std::unordered_set<std::string>& counter_stats);
+        void setCounterIdList(
+                const std::vector<sai_object_id_t>& object_ids,
+                const CounterType counter_type,
+                const std::unordered_set<std::string>& counter_stats);
         void clearCounterIdList(const sai_object_id_t object_id);
 
+        void setDeferredMode(const bool deferred);
+        void flush();
+
     protected:
         void applyGroupConfiguration();
 
@@ -63,14 +72,24 @@ class FlexCounterManager
                 const sai_object_id_t object_id) const;
         std::string serializeCounterStats(
                 const std::unordered_set<std::string>& counter_stats) const;
+        const std::string& getSerializedCounterStats(
+                const std::unordered_set<std::string>& counter_stats);
+        void commit();
 
         std::string group_name;
         StatsMode stats_mode;
         uint polling_interval;
         bool enabled;
+        bool deferred = false;
         std::unordered_set<sai_object_id_t> installed_counters;
 
+        // Most objects of a group poll the same stats, the last serialized
+        // stats are reused as long as the stats don't change
+        std::unordered_set<std::string> last_counter_stats;
+        std::string last_serialized_counter_stats;
+
         std::shared_ptr<swss::DBConnector> flex_counter_db = nullptr;
+        std::shared_ptr<swss::RedisPipeline> flex_counter_pipeline = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_group_table = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_table = nullptr;
 
@@ -9,6 +9,7 @@
 #include "bufferorch.h"
 #include "flexcounterorch.h"
 #include "debugcounterorch.h"
+#include "watermarkaggregator.h"
 
 extern sai_port_api_t *sai_port_api;
 
@@ -144,6 +145,16 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     fieldValues.emplace_back(FLEX_COUNTER_STATUS_FIELD, value);
                     m_flexCounterGroupTable->set(flexCounterGroupMap[key], fieldValues);
                 }
+                else if (field == RATES_MODE_FIELD)
+                {
+                    // Rates mode is selected when orchagent starts
+                    SWSS_LOG_NOTICE("Flex counter %s rates mode %s applies after restart", key.c_str(), value.c_str());
+                }
+                else if (field == WATERMARK_MODE_FIELD)
+                {
+                    // Watermark mode is selected when orchagent starts
+                    SWSS_LOG_NOTICE("Flex counter %s watermark mode %s applies after restart", key.c_str(), value.c_str());
+                }
                 else
                 {
                     SWSS_LOG_NOTICE("Unsupported field %s", field.c_str());
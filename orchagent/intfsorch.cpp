@@ -85,20 +85,42 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
 
     string rifRatePluginName = "rif_rates.lua";
 
-    try
+    if (isNativeRatesMode("RIF_RATES"))
     {
-        string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
-        string rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(RIF_PLUGIN_FIELD, rifRateSha);
-        fieldValues.emplace_back(POLL_INTERVAL_FIELD, RIF_FLEX_STAT_COUNTER_POLL_MSECS);
-        fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
-        m_flexCounterGroupTable->set(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
+        const vector<CounterRates::Rate> rifRates =
+        {
+            { "RX_BPS", { "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS" } },
+            { "RX_PPS", { "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS" } },
+            { "TX_BPS", { "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS" } },
+            { "TX_PPS", { "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS" } },
+        };
+        m_rifRates = unique_ptr<CounterRates>(new CounterRates(m_counter_db.get(), "RIF", rifRates));
+
+        int interval = stoi(RIF_FLEX_STAT_COUNTER_POLL_MSECS);
+        auto intervR = timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 };
+        m_rifRatesTimer = new SelectableTimer(intervR);
+        auto executorR = new ExecutableTimer(m_rifRatesTimer, this, "RIF_RATES_TIMER");
+        Orch::addExecutor(executorR);
+        m_rifRatesTimer->start();
+        SWSS_LOG_NOTICE("RIF rates are computed in orchagent");
     }
-    catch (const runtime_error &e)
+    else
     {
-        SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
+        try
+        {
+            string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
+            string rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
+
+            vector<FieldValueTuple> fieldValues;
+            fieldValues.emplace_back(RIF_PLUGIN_FIELD, rifRateSha);
+            fieldValues.emplace_back(POLL_INTERVAL_FIELD, RIF_FLEX_STAT_COUNTER_POLL_MSECS);
+            fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
+            m_flexCounterGroupTable->set(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
+        }
+        catch (const runtime_error &e)
+        {
+            SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
+        }
     }
 
     if(gMySwitchType == "voq")
@@ -1389,6 +1411,11 @@ void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const
     vector<FieldValueTuple> fieldValues;
     fieldValues.emplace_back(RIF_COUNTER_ID_LIST, counters_stream.str());
     m_flexCounterTable->set(key, fieldValues);
+
+    if (m_rifRates)
+    {
+        m_rifRates->addObject(id);
+    }
     SWSS_LOG_DEBUG("Registered interface %s to Flex counter", name.c_str());
 }
 
@@ -1403,6 +1430,11 @@ void IntfsOrch::removeRifFromFlexCounter(const string &id, const string &name)
     string key = getRifFlexCounterTableKey(id);
 
     m_flexCounterTable->del(key);
+
+    if (m_rifRates)
+    {
+        m_rifRates->removeObject(id);
+    }
     SWSS_LOG_DEBUG("Unregistered interface %s from Flex counter", name.c_str());
 }
 
@@ -1437,6 +1469,12 @@ void IntfsOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_rifRatesTimer)
+    {
+        m_rifRates->poll();
+        return;
+    }
+
     SWSS_LOG_DEBUG("Registering %" PRId64 " new intfs", m_rifsToAdd.size());
     string value;
     for (auto it = m_rifsToAdd.begin(); it != m_rifsToAdd.end(); )
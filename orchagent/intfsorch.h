@@ -73,6 +73,8 @@ private:
 
     SelectableTimer* m_updateMapsTimer = nullptr;
     std::vector<Port> m_rifsToAdd;
+    unique_ptr<CounterRates> m_rifRates;
+    SelectableTimer* m_rifRatesTimer = nullptr;
 
     VRFOrch *m_vrfOrch;
     IntfsTable m_syncdIntfses;
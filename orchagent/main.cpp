@@ -48,6 +48,7 @@ MacAddress gMacAddress;
 MacAddress gVxlanMacAddress;
 
 extern size_t gMaxBulkSize;
+extern size_t gNextHopGroupPoolSize;
 
 #define DEFAULT_BATCH_SIZE  128
 int gBatchSize = DEFAULT_BATCH_SIZE;
@@ -74,7 +75,7 @@ string gMyAsicName = "";
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-n nhg_pool_size]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    0: do not record logs" << endl;
@@ -90,6 +91,7 @@ void usage()
     cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec')" << endl;
     cout << "    -j sairedis_rec_filename: sairedis record log filename(default sairedis.rec)" << endl;
     cout << "    -k max bulk size in bulk mode (default 1000)" << endl;
+    cout << "    -n number of pre-created next hop groups (default 0)" << endl;
 }
 
 void sighup_handler(int signo)
@@ -322,7 +324,7 @@ int main(int argc, char **argv)
     string swss_rec_filename = "swss.rec";
     string sairedis_rec_filename = "sairedis.rec";
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:n:")) != -1)
     {
         switch (opt)
         {
@@ -414,6 +416,20 @@ int main(int argc, char **argv)
                 }
             }
             break;
+        case 'n':
+            {
+                auto pool_size = atoi(optarg);
+                if (pool_size >= 0)
+                {
+                    gNextHopGroupPoolSize = pool_size;
+                    SWSS_LOG_NOTICE("Setting next hop group pool size as %zu", gNextHopGroupPoolSize);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for next hop group pool size: %d. Ignoring.", pool_size);
+                }
+            }
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
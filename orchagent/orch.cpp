@@ -21,6 +21,11 @@ extern ofstream gRecordOfs;
 extern bool gLogRotate;
 extern string gRecordFile;
 
+static const size_t maxParsedReferences = 65536;
+
+unordered_map<string, Orch::ParsedReference> Orch::m_parsedReferences;
+unordered_map<string, Orch::ReferencedObjectList> Orch::m_referencedObjectLists;
+
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
     addConsumer(db, tableName, pri);
@@ -314,57 +319,102 @@ bool Orch::parseReference(type_map &type_maps, string &ref_in, string &type_name
 {
     SWSS_LOG_ENTER();
 
+    const ParsedReference *parsed = nullptr;
+    referenced_object *obj = lookupReference(type_maps, ref_in, parsed);
+    if (parsed == nullptr || (obj == nullptr && !parsed->type_name.empty()))
+    {
+        return false;
+    }
+    type_name = parsed->type_name;
+    object_name = parsed->object_name;
+    return true;
+}
+
+/*
+- Parses a reference once, later calls return the cached result
+- Returns nullptr for a malformed reference
+*/
+const Orch::ParsedReference *Orch::getParsedReference(const string &ref_in)
+{
+    SWSS_LOG_ENTER();
+
+    auto parsed = m_parsedReferences.find(ref_in);
+    if (parsed != m_parsedReferences.end())
+    {
+        return &parsed->second;
+    }
+
     SWSS_LOG_DEBUG("input:%s", ref_in.c_str());
     if (ref_in.size() < 2)
     {
         SWSS_LOG_ERROR("invalid reference received:%s\n", ref_in.c_str());
-        return false;
+        return nullptr;
     }
     if ((ref_in[0] != ref_start) || (ref_in[ref_in.size()-1] != ref_end))
     {
         SWSS_LOG_ERROR("malformed reference:%s. Must be surrounded by [ ]\n", ref_in.c_str());
-        return false;
+        return nullptr;
     }
-    if (ref_in.size() == 2)
-    {
-        // value set by user is "[]"
-        // Deem it as a valid format
-        // clear both type_name and object_name
-        // as an indication to the caller that
-        // such a case has been encountered
-        type_name.clear();
-        object_name.clear();
-        return true;
-    }
-    string ref_content = ref_in.substr(1, ref_in.size() - 2);
-    vector<string> tokens;
-    tokens = tokenize(ref_content, delimiter);
-    if (tokens.size() != 2)
+
+    ParsedReference ref;
+    if (ref_in.size() > 2)
     {
-        tokens = tokenize(ref_content, config_db_key_delimiter);
+        string ref_content = ref_in.substr(1, ref_in.size() - 2);
+        vector<string> tokens;
+        tokens = tokenize(ref_content, delimiter);
         if (tokens.size() != 2)
         {
-            SWSS_LOG_ERROR("malformed reference:%s. Must contain 2 tokens\n", ref_content.c_str());
-            return false;
+            tokens = tokenize(ref_content, config_db_key_delimiter);
+            if (tokens.size() != 2)
+            {
+                SWSS_LOG_ERROR("malformed reference:%s. Must contain 2 tokens\n", ref_content.c_str());
+                return nullptr;
+            }
         }
+        ref.type_name = tokens[0];
+        ref.object_name = tokens[1];
+        ref.referenced_object_name = tokens[0] + delimiter + tokens[1];
+    }
+
+    // References come from the configuration, the cache only grows past the limit on misuse
+    if (m_parsedReferences.size() >= maxParsedReferences)
+    {
+        m_parsedReferences.clear();
+    }
+    return &m_parsedReferences.emplace(ref_in, ref).first->second;
+}
+
+/*
+- Returns the object a reference points to, or nullptr if the reference is
+- malformed, "[]" or points to an unknown object. parsed is set unless the
+- reference is malformed.
+*/
+referenced_object *Orch::lookupReference(type_map &type_maps, const string &ref_in, const ParsedReference *&parsed)
+{
+    SWSS_LOG_ENTER();
+
+    parsed = getParsedReference(ref_in);
+    if (parsed == nullptr || parsed->type_name.empty())
+    {
+        // value set by user is "[]", deemed as a valid format
+        return nullptr;
     }
-    auto type_it = type_maps.find(tokens[0]);
+
+    auto type_it = type_maps.find(parsed->type_name);
     if (type_it == type_maps.end())
     {
-        SWSS_LOG_ERROR("not recognized type:%s\n", tokens[0].c_str());
-        return false;
+        SWSS_LOG_ERROR("not recognized type:%s\n", parsed->type_name.c_str());
+        parsed = nullptr;
+        return nullptr;
     }
-    auto obj_map = type_maps[tokens[0]];
-    auto obj_it = obj_map->find(tokens[1]);
-    if (obj_it == obj_map->end())
+    auto obj_it = type_it->second->find(parsed->object_name);
+    if (obj_it == type_it->second->end())
     {
-        SWSS_LOG_INFO("map:%s does not contain object with name:%s\n", tokens[0].c_str(), tokens[1].c_str());
-        return false;
+        SWSS_LOG_INFO("map:%s does not contain object with name:%s\n", parsed->type_name.c_str(), parsed->object_name.c_str());
+        return nullptr;
     }
-    type_name = tokens[0];
-    object_name = tokens[1];
-    SWSS_LOG_DEBUG("parsed: type_name:%s, object_name:%s", type_name.c_str(), object_name.c_str());
-    return true;
+    SWSS_LOG_DEBUG("parsed: type_name:%s, object_name:%s", parsed->type_name.c_str(), parsed->object_name.c_str());
+    return &obj_it->second;
 }
 
 ref_resolve_status Orch::resolveFieldRefValue(
@@ -387,17 +437,18 @@ ref_resolve_status Orch::resolveFieldRefValue(
                 SWSS_LOG_ERROR("Multiple same fields %s", field_name.c_str());
                 return ref_resolve_status::multiple_instances;
             }
-            string ref_type_name, object_name;
-            if (!parseReference(type_maps, fvValue(*i), ref_type_name, object_name))
+            const ParsedReference *parsed = nullptr;
+            referenced_object *obj = lookupReference(type_maps, fvValue(*i), parsed);
+            if (parsed == nullptr || (obj == nullptr && !parsed->type_name.empty()))
             {
                 return ref_resolve_status::not_resolved;
             }
-            else if (ref_type_name.empty() && object_name.empty())
+            else if (obj == nullptr)
             {
                 return ref_resolve_status::empty;
             }
-            sai_object = (*(type_maps[ref_type_name]))[object_name].m_saiObjectId;
-            referenced_object_name = ref_type_name + delimiter + object_name;
+            sai_object = obj->m_saiObjectId;
+            referenced_object_name = parsed->referenced_object_name;
             hit = true;
         }
     }
@@ -416,13 +467,11 @@ void Orch::removeMeFromObjsReferencedByMe(
     const string &field,
     const string &old_referenced_obj_name)
 {
-    vector<string> objects = tokenize(old_referenced_obj_name, list_item_delimiter);
-    for (auto &obj : objects)
+    for (auto &obj : getReferencedObjectList(old_referenced_obj_name))
     {
         // obj_name references token
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &ref_obj_name = tokens[1];
+        auto &referenced_table = obj.first;
+        auto &ref_obj_name = obj.second;
         auto &old_referenced_obj = (*type_maps[referenced_table])[ref_obj_name];
         old_referenced_obj.m_objsDependingOnMe.erase(obj_name);
         SWSS_LOG_INFO("Obj %s.%s Field %s: Remove reference to %s %s (now %s)",
@@ -432,6 +481,32 @@ void Orch::removeMeFromObjsReferencedByMe(
     }
 }
 
+/*
+- Splits a "table:name,table:name" list of referenced objects once, later
+- calls return the cached result
+*/
+const Orch::ReferencedObjectList &Orch::getReferencedObjectList(const string &referenced_objs)
+{
+    auto list = m_referencedObjectLists.find(referenced_objs);
+    if (list != m_referencedObjectLists.end())
+    {
+        return list->second;
+    }
+
+    ReferencedObjectList objs;
+    for (auto &obj : tokenize(referenced_objs, list_item_delimiter))
+    {
+        auto tokens = tokenize(obj, delimiter);
+        objs.emplace_back(tokens[0], tokens[1]);
+    }
+
+    if (m_referencedObjectLists.size() >= maxParsedReferences)
+    {
+        m_referencedObjectLists.clear();
+    }
+    return m_referencedObjectLists.emplace(referenced_objs, objs).first->second;
+}
+
 void Orch::setObjectReference(
     type_map &type_maps,
     const string &table,
@@ -448,12 +523,10 @@ void Orch::setObjectReference(
     obj.m_objsReferencingByMe[field] = referenced_obj;
 
     // Add the reference to the new object being referenced
-    vector<string> objs = tokenize(referenced_obj, list_item_delimiter);
-    for (auto &obj : objs)
+    for (auto &obj : getReferencedObjectList(referenced_obj))
     {
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &referenced_obj_name = tokens[1];
+        auto &referenced_table = obj.first;
+        auto &referenced_obj_name = obj.second;
         auto &new_obj_being_referenced = (*type_maps[referenced_table])[referenced_obj_name];
         new_obj_being_referenced.m_objsDependingOnMe.insert(obj_name);
         SWSS_LOG_INFO("Obj %s.%s Field %s: Add reference to %s %s (now %s)",
@@ -585,7 +658,6 @@ ref_resolve_status Orch::resolveFieldRefArray(
                 SWSS_LOG_ERROR("Singleton field with name:%s must have only 1 instance, actual count:%zd\n", field_name.c_str(), count);
                 return ref_resolve_status::multiple_instances;
             }
-            string ref_type_name, object_name;
             string list = fvValue(*i);
             vector<string> list_items;
             if (list.find(list_item_delimiter) != string::npos)
@@ -598,17 +670,19 @@ ref_resolve_status Orch::resolveFieldRefArray(
             }
             for (size_t ind = 0; ind < list_items.size(); ind++)
             {
-                if (!parseReference(type_maps, list_items[ind], ref_type_name, object_name))
+                const ParsedReference *parsed = nullptr;
+                referenced_object *obj = lookupReference(type_maps, list_items[ind], parsed);
+                if (obj == nullptr)
                 {
                     SWSS_LOG_ERROR("Failed to parse profile reference:%s\n", list_items[ind].c_str());
                     return ref_resolve_status::not_resolved;
                 }
-                sai_object_id_t sai_obj = (*(type_maps[ref_type_name]))[object_name].m_saiObjectId;
-                SWSS_LOG_DEBUG("Resolved to sai_object:0x%" PRIx64 ", type:%s, name:%s", sai_obj, ref_type_name.c_str(), object_name.c_str());
+                sai_object_id_t sai_obj = obj->m_saiObjectId;
+                SWSS_LOG_DEBUG("Resolved to sai_object:0x%" PRIx64 ", type:%s, name:%s", sai_obj, parsed->type_name.c_str(), parsed->object_name.c_str());
                 sai_object_arr.push_back(sai_obj);
                 if (!object_name_list.empty())
                     object_name_list += list_item_delimiter;
-                object_name_list += ref_type_name + delimiter + object_name;
+                object_name_list += parsed->referenced_object_name;
             }
             count++;
         }
@@ -57,7 +57,7 @@ typedef enum
 typedef struct
 {
     // m_objsDependingOnMe stores names (without table name) of all objects depending on the current obj
-    std::set<std::string> m_objsDependingOnMe;
+    std::unordered_set<std::string> m_objsDependingOnMe;
     // m_objsReferencingByMe is a map from a field of the current object's to the object names it references
     // the object names are with table name
     // multiple objects being referenced are separated by ','
@@ -65,8 +65,8 @@ typedef struct
     sai_object_id_t m_saiObjectId;
 } referenced_object;
 
-typedef std::map<std::string, referenced_object> object_reference_map;
-typedef std::map<std::string, object_reference_map*> type_map;
+typedef std::unordered_map<std::string, referenced_object> object_reference_map;
+typedef std::unordered_map<std::string, object_reference_map*> type_map;
 
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
@@ -243,6 +243,25 @@ protected:
     virtual task_process_status handleSaiGetStatus(sai_api_t api, sai_status_t status, void *context = nullptr);
     bool parseHandleSaiStatusFailure(task_process_status status);
 private:
+    /*
+     * A reference such as "[BUFFER_PROFILE_TABLE|ingress_lossless_profile]"
+     * parsed once, with the "table:name" form used in referenced object names
+     */
+    struct ParsedReference
+    {
+        std::string type_name;
+        std::string object_name;
+        std::string referenced_object_name;
+    };
+    typedef std::vector<std::pair<std::string, std::string>> ReferencedObjectList;
+
+    /* Shared by all orchs, the same references are used by several tables */
+    static std::unordered_map<std::string, ParsedReference> m_parsedReferences;
+    static std::unordered_map<std::string, ReferencedObjectList> m_referencedObjectLists;
+
+    const ParsedReference *getParsedReference(const std::string &ref);
+    referenced_object *lookupReference(type_map &type_maps, const std::string &ref, const ParsedReference *&parsed);
+    const ReferencedObjectList &getReferencedObjectList(const std::string &referenced_objs);
     void removeMeFromObjsReferencedByMe(type_map &type_maps, const std::string &table, const std::string &obj_name, const std::string &field, const std::string &old_referenced_obj_name);
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri = default_orch_pri);
 };
@@ -3,6 +3,7 @@
 #include "logger.h"
 #include "sai_serialize.h"
 #include "portsorch.h"
+#include "counters_db_reply.h"
 #include <vector>
 #include <inttypes.h>
 
@@ -89,25 +90,139 @@ void PfcWdActionHandler::commitCounters(bool periodic /* = false */)
 
     auto finalStats = getQueueStats(m_countersTable, sai_serialize_object_id(m_queue));
 
+    accumulateStats(finalStats, hwStats, periodic);
+
+    updateWdCounters(sai_serialize_object_id(m_queue), finalStats);
+}
+
+void PfcWdActionHandler::accumulateStats(PfcWdQueueStats& stats, const PfcWdHwStats& hwStats, bool periodic)
+{
+    SWSS_LOG_ENTER();
+
     if (!periodic)
     {
-        finalStats.restoreCount++;
+        stats.restoreCount++;
     }
-    finalStats.operational = !periodic;
+    stats.operational = !periodic;
 
-    finalStats.txPktLast += hwStats.txPkt - m_hwStats.txPkt;
-    finalStats.txDropPktLast += hwStats.txDropPkt - m_hwStats.txDropPkt;
-    finalStats.rxPktLast += hwStats.rxPkt - m_hwStats.rxPkt;
-    finalStats.rxDropPktLast += hwStats.rxDropPkt - m_hwStats.rxDropPkt;
+    stats.txPktLast += hwStats.txPkt - m_hwStats.txPkt;
+    stats.txDropPktLast += hwStats.txDropPkt - m_hwStats.txDropPkt;
+    stats.rxPktLast += hwStats.rxPkt - m_hwStats.rxPkt;
+    stats.rxDropPktLast += hwStats.rxDropPkt - m_hwStats.rxDropPkt;
 
-    finalStats.txPkt += hwStats.txPkt - m_hwStats.txPkt;
-    finalStats.txDropPkt += hwStats.txDropPkt - m_hwStats.txDropPkt;
-    finalStats.rxPkt += hwStats.rxPkt - m_hwStats.rxPkt;
-    finalStats.rxDropPkt += hwStats.rxDropPkt - m_hwStats.rxDropPkt;
+    stats.txPkt += hwStats.txPkt - m_hwStats.txPkt;
+    stats.txDropPkt += hwStats.txDropPkt - m_hwStats.txDropPkt;
+    stats.rxPkt += hwStats.rxPkt - m_hwStats.rxPkt;
+    stats.rxDropPkt += hwStats.rxDropPkt - m_hwStats.rxDropPkt;
 
     m_hwStats = hwStats;
+}
 
-    updateWdCounters(sai_serialize_object_id(m_queue), finalStats);
+string PfcWdActionHandler::getCountersKey(void) const
+{
+    return m_countersTable->getTableName() + m_countersTable->getTableNameSeparator() + sai_serialize_object_id(m_queue);
+}
+
+void PfcWdActionHandler::commitCounters(DBConnector *countersDb,
+        const vector<shared_ptr<PfcWdActionHandler>> &handlers, bool periodic /* = false */)
+{
+    SWSS_LOG_ENTER();
+
+    vector<PfcWdActionHandler *> committed;
+    vector<PfcWdHwStats> hwStats;
+    committed.reserve(handlers.size());
+    hwStats.reserve(handlers.size());
+
+    for (const auto &handler : handlers)
+    {
+        PfcWdHwStats stats;
+        if (!handler->getHwCounters(stats))
+        {
+            continue;
+        }
+
+        committed.push_back(handler.get());
+        hwStats.push_back(stats);
+    }
+
+    if (committed.empty())
+    {
+        return;
+    }
+
+    redisContext *ctx = countersDb->getContext();
+    vector<string> keys;
+    keys.reserve(committed.size());
+
+    for (auto handler : committed)
+    {
+        keys.push_back(handler->getCountersKey());
+        redisAppendCommand(ctx, "HMGET %s "
+                PFC_WD_QUEUE_STATS_DEADLOCK_DETECTED " "
+                PFC_WD_QUEUE_STATS_DEADLOCK_RESTORED " "
+                PFC_WD_QUEUE_STATS_TX_PACKETS " "
+                PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS " "
+                PFC_WD_QUEUE_STATS_RX_PACKETS " "
+                PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS " "
+                PFC_WD_QUEUE_STATS_TX_PACKETS_LAST " "
+                PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS_LAST " "
+                PFC_WD_QUEUE_STATS_RX_PACKETS_LAST " "
+                PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS_LAST,
+                keys.back().c_str());
+    }
+
+    vector<PfcWdQueueStats> queueStats(committed.size());
+    for (size_t i = 0; i < committed.size(); i++)
+    {
+        CountersDbReplyPtr reply = getCountersDbReply(ctx);
+        PfcWdQueueStats &stats = queueStats[i];
+        getCountersDbCounter(reply.get(), 0, stats.detectCount);
+        getCountersDbCounter(reply.get(), 1, stats.restoreCount);
+        getCountersDbCounter(reply.get(), 2, stats.txPkt);
+        getCountersDbCounter(reply.get(), 3, stats.txDropPkt);
+        getCountersDbCounter(reply.get(), 4, stats.rxPkt);
+        getCountersDbCounter(reply.get(), 5, stats.rxDropPkt);
+        getCountersDbCounter(reply.get(), 6, stats.txPktLast);
+        getCountersDbCounter(reply.get(), 7, stats.txDropPktLast);
+        getCountersDbCounter(reply.get(), 8, stats.rxPktLast);
+        getCountersDbCounter(reply.get(), 9, stats.rxDropPktLast);
+
+        committed[i]->accumulateStats(stats, hwStats[i], periodic);
+    }
+
+    for (size_t i = 0; i < committed.size(); i++)
+    {
+        const PfcWdQueueStats &stats = queueStats[i];
+        redisAppendCommand(ctx, "HMSET %s "
+                PFC_WD_QUEUE_STATS_DEADLOCK_DETECTED " %s "
+                PFC_WD_QUEUE_STATS_DEADLOCK_RESTORED " %s "
+                PFC_WD_QUEUE_STATS_TX_PACKETS " %s "
+                PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS " %s "
+                PFC_WD_QUEUE_STATS_RX_PACKETS " %s "
+                PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS " %s "
+                PFC_WD_QUEUE_STATS_TX_PACKETS_LAST " %s "
+                PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS_LAST " %s "
+                PFC_WD_QUEUE_STATS_RX_PACKETS_LAST " %s "
+                PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS_LAST " %s "
+                PFC_WD_QUEUE_STATUS " %s",
+                keys[i].c_str(),
+                to_string(stats.detectCount).c_str(),
+                to_string(stats.restoreCount).c_str(),
+                to_string(stats.txPkt).c_str(),
+                to_string(stats.txDropPkt).c_str(),
+                to_string(stats.rxPkt).c_str(),
+                to_string(stats.rxDropPkt).c_str(),
+                to_string(stats.txPktLast).c_str(),
+                to_string(stats.txDropPktLast).c_str(),
+                to_string(stats.rxPktLast).c_str(),
+                to_string(stats.rxDropPktLast).c_str(),
+                stats.operational ? PFC_WD_QUEUE_STATUS_OPERATIONAL : PFC_WD_QUEUE_STATUS_STORMED);
+    }
+
+    for (size_t i = 0; i < committed.size(); i++)
+    {
+        getCountersDbReply(ctx);
+    }
 }
 
 PfcWdActionHandler::PfcWdQueueStats PfcWdActionHandler::getQueueStats(shared_ptr<Table> countersTable, const string &queueIdStr)
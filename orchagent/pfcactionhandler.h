@@ -49,6 +49,12 @@ class PfcWdActionHandler
         static void initWdCounters(shared_ptr<Table> countersTable, const string &queueIdStr);
         void initCounters(void);
         void commitCounters(bool periodic = false);
+        /*
+         * Same as commitCounters() on each handler, with the PFC WD counters of
+         * all queues read in one pipelined round trip and written in another.
+         */
+        static void commitCounters(DBConnector *countersDb,
+                const vector<shared_ptr<PfcWdActionHandler>> &handlers, bool periodic = false);
 
         virtual bool getHwCounters(PfcWdHwStats& counters)
         {
@@ -75,6 +81,8 @@ class PfcWdActionHandler
 
         static PfcWdQueueStats getQueueStats(shared_ptr<Table> countersTable, const string &queueIdStr);
         void updateWdCounters(const string& queueIdStr, const PfcWdQueueStats& stats);
+        void accumulateStats(PfcWdQueueStats& stats, const PfcWdHwStats& hwStats, bool periodic);
+        string getCountersKey(void) const;
 
         sai_object_id_t m_port = SAI_NULL_OBJECT_ID;
         sai_object_id_t m_queue = SAI_NULL_OBJECT_ID;
@@ -0,0 +1,203 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "redisapi.h"
+#include "schema.h"
+#include "pfcwddetector.h"
+
+using namespace std;
+using namespace swss;
+
+///
+/// Microbenchmark of PFC watchdog storm detection: the syncd Lua plugins against PfcWdDetector
+/// Usage: pfcwd_bench [queues] [iterations] [platform] [lua directory]
+///
+/// Runs on fake counters of queues with no storm in COUNTERS_DB, which are removed afterwards.
+///
+
+#define QUEUES_PER_PORT 8
+
+struct BenchQueue
+{
+    string queueId;
+    string portId;
+    uint8_t index;
+};
+
+string readScript(const string & path)
+{
+    ifstream file(path);
+    if (!file)
+    {
+        throw runtime_error("Can't read " + path);
+    }
+
+    stringstream script;
+    script << file.rdbuf();
+    return script.str();
+}
+
+void populateCounters(DBConnector & db, const vector<BenchQueue> & queues)
+{
+    for (const auto & queue : queues)
+    {
+        const string queueKey = string(COUNTERS_TABLE) + ":" + queue.queueId;
+        const string portKey = string(COUNTERS_TABLE) + ":" + queue.portId;
+        const string pfc = "SAI_PORT_STAT_PFC_" + to_string(queue.index);
+
+        db.hset(queueKey, "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES", "0");
+        db.hset(queueKey, "SAI_QUEUE_STAT_PACKETS", "0");
+        db.hset(queueKey, "SAI_QUEUE_ATTR_PAUSE_STATUS", "false");
+        db.hset(queueKey, "PFC_WD_DETECTION_TIME", "200000");
+        db.hset(queueKey, "PFC_WD_RESTORATION_TIME", "200000");
+        db.hset(queueKey, "PFC_WD_ACTION", "drop");
+        db.hset(queueKey, "PFC_WD_STATUS", "operational");
+
+        db.hset(portKey, pfc + "_RX_PKTS", "0");
+        db.hset(portKey, pfc + "_ON2OFF_RX_PKTS", "0");
+        db.hset(portKey, pfc + "_RX_PAUSE_DURATION", "0");
+        db.hset(portKey, pfc + "_RX_PAUSE_DURATION_US", "0");
+
+        db.hset(COUNTERS_QUEUE_INDEX_MAP, queue.queueId, to_string(queue.index));
+        db.hset(COUNTERS_QUEUE_PORT_MAP, queue.queueId, queue.portId);
+    }
+}
+
+void removeCounters(DBConnector & db, const vector<BenchQueue> & queues)
+{
+    for (const auto & queue : queues)
+    {
+        db.del(string(COUNTERS_TABLE) + ":" + queue.queueId);
+        db.del(string(COUNTERS_TABLE) + ":" + queue.portId);
+        db.hdel(COUNTERS_QUEUE_INDEX_MAP, queue.queueId);
+        db.hdel(COUNTERS_QUEUE_PORT_MAP, queue.queueId);
+    }
+}
+
+///
+/// Run the plugin on all queues, the way syncd does on every poll
+///
+void runPlugin(DBConnector & db, const string & sha, const vector<BenchQueue> & queues, int pollTime)
+{
+    vector<string> args = { "EVALSHA", sha, to_string(queues.size()) };
+    for (const auto & queue : queues)
+    {
+        args.push_back(queue.queueId);
+    }
+    args.push_back(to_string(db.getDbId()));
+    args.push_back(COUNTERS_TABLE);
+    args.push_back(to_string(pollTime));
+
+    vector<const char *> argv;
+    for (const auto & arg : args)
+    {
+        argv.push_back(arg.c_str());
+    }
+
+    redisReply *reply = static_cast<redisReply *>(
+            redisCommandArgv(db.getContext(), (int)argv.size(), argv.data(), nullptr));
+    if (reply == nullptr || reply->type == REDIS_REPLY_ERROR)
+    {
+        string error = reply ? reply->str : db.getContext()->errstr;
+        freeReplyObject(reply);
+        throw runtime_error("Plugin failed: " + error);
+    }
+    freeReplyObject(reply);
+}
+
+int main(int argc, char ** argv)
+{
+    int queueCount = argc > 1 ? atoi(argv[1]) : 256;
+    int iterations = argc > 2 ? atoi(argv[2]) : 1000;
+    string platform = argc > 3 ? argv[3] : "broadcom";
+    string luaDir = argc > 4 ? argv[4] : "/usr/share/swss";
+
+    if (queueCount <= 0 || iterations <= 0)
+    {
+        cerr << "Usage: pfcwd_bench [queues] [iterations] [platform] [lua directory]" << endl;
+        return -1;
+    }
+
+    PfcWdStormCriteria criteria = PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION;
+    string pfcRxPauseStat = "RX_PAUSE_DURATION";
+    if (platform == "broadcom")
+    {
+        criteria = PfcWdStormCriteria::PFC_WD_STORM_PAUSE_STATUS;
+        pfcRxPauseStat = "ON2OFF_RX_PKTS";
+    }
+    else if (platform == "mellanox")
+    {
+        pfcRxPauseStat = "RX_PAUSE_DURATION_US";
+    }
+    else if (platform == "innovium")
+    {
+        criteria = PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION_RX;
+    }
+
+    const int pollTime = 200000;
+    vector<BenchQueue> queues;
+    for (int i = 0; i < queueCount; i++)
+    {
+        char queueId[32], portId[32];
+        snprintf(queueId, sizeof(queueId), "oid:0x15fff00000%04x", i);
+        snprintf(portId, sizeof(portId), "oid:0x1fff00000%04x", i / QUEUES_PER_PORT);
+        queues.push_back({ queueId, portId, (uint8_t)(i % QUEUES_PER_PORT) });
+    }
+
+    DBConnector db("COUNTERS_DB", 0);
+    populateCounters(db, queues);
+
+    try
+    {
+        string detectSha = loadRedisScript(&db, readScript(luaDir + "/pfc_detect_" + platform + ".lua"));
+        string restoreSha = loadRedisScript(&db, readScript(luaDir + "/pfc_restore.lua"));
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            runPlugin(db, detectSha, queues, pollTime);
+            runPlugin(db, restoreSha, queues, pollTime);
+        }
+        double luaUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / iterations;
+
+        PfcWdDetector detector(criteria);
+        PfcWdCounterReader reader(&db, criteria, pfcRxPauseStat);
+        for (const auto & queue : queues)
+        {
+            uint32_t slot = detector.addQueue(pollTime, pollTime, false);
+            reader.setQueue(slot, queue.queueId, queue.portId, queue.index);
+        }
+
+        vector<PfcWdQueueCounters> counters;
+        vector<PfcWdDetectorEvent> events;
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            reader.read(counters);
+            events.clear();
+            detector.poll(counters, pollTime, events);
+        }
+        double nativeUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / iterations;
+
+        cout << "Platform: " << platform << ", queues: " << queueCount << endl;
+        cout << "Lua:    " << luaUs << " us per poll" << endl;
+        cout << "Native: " << nativeUs << " us per poll" << endl;
+        cout << "Speedup: " << luaUs / nativeUs << "x" << endl;
+    }
+    catch (const exception & e)
+    {
+        cerr << e.what() << endl;
+        removeCounters(db, queues);
+        return -1;
+    }
+
+    removeCounters(db, queues);
+    return 0;
+}
@@ -0,0 +1,376 @@
+#include <stdlib.h>
+#include "schema.h"
+#include "pfcwddetector.h"
+#include "counters_db_reply.h"
+
+using namespace std;
+using namespace swss;
+
+#define PFC_WD_QUEUE_OCCUPANCY_BYTES    "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES"
+#define PFC_WD_QUEUE_PACKETS            "SAI_QUEUE_STAT_PACKETS"
+#define PFC_WD_QUEUE_PAUSE_STATUS       "SAI_QUEUE_ATTR_PAUSE_STATUS"
+#define PFC_WD_QUEUE_DEBUG_STORM        "DEBUG_STORM"
+#define PFC_WD_PORT_STAT_PFC_PREFIX     "SAI_PORT_STAT_PFC_"
+
+PfcWdDetector::PfcWdDetector(PfcWdStormCriteria criteria):
+    m_criteria(criteria)
+{
+}
+
+uint32_t PfcWdDetector::addQueue(uint32_t detectionTime, uint32_t restorationTime, bool alert)
+{
+    uint32_t queue = (uint32_t)m_slots.allocate();
+    if (queue == m_queues.size())
+    {
+        m_queues.emplace_back();
+    }
+    m_samples.reset(queue);
+
+    QueueState &state = m_queues[queue];
+    state = QueueState();
+    state.detectionTime = detectionTime;
+    state.restorationTime = restorationTime;
+    state.detectionTimeLeft = detectionTime;
+    state.restorationTimeLeft = restorationTime;
+    state.alert = alert;
+
+    return queue;
+}
+
+void PfcWdDetector::removeQueue(uint32_t queue)
+{
+    m_slots.release(queue);
+}
+
+void PfcWdDetector::setStormed(uint32_t queue, bool stormed)
+{
+    if (queue < m_queues.size())
+    {
+        m_queues[queue].stormed = stormed;
+    }
+}
+
+bool PfcWdDetector::isStorm(const QueueState &state, const PfcWdQueueCounters &counters, uint32_t pollTime) const
+{
+    if (counters.debugStorm)
+    {
+        return true;
+    }
+
+    bool pfcRx = counters.pfcRxPackets > state.pfcRxPacketsLast;
+    bool noTx = counters.packets == state.packetsLast;
+
+    switch (m_criteria)
+    {
+        case PfcWdStormCriteria::PFC_WD_STORM_PAUSE_STATUS:
+            return pfcRx && counters.pfcRxPause == state.pfcRxPauseLast &&
+                state.pauseStatusLast && counters.pauseStatus;
+        case PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION:
+        case PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION_RX:
+        {
+            bool paused = counters.pfcRxPause > state.pfcRxPauseLast &&
+                (double)(counters.pfcRxPause - state.pfcRxPauseLast) > pollTime * 0.8;
+            if (counters.occupancyBytes > 0)
+            {
+                return noTx && pfcRx;
+            }
+            if (m_criteria == PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION_RX)
+            {
+                return pfcRx && paused;
+            }
+            return noTx && paused;
+        }
+    }
+
+    return false;
+}
+
+void PfcWdDetector::detect(uint32_t queue, const PfcWdQueueCounters &counters, uint32_t pollTime,
+        vector<PfcWdDetectorEvent> &events)
+{
+    QueueState &state = m_queues[queue];
+    bool deadlock = false;
+
+    // If this is not a first run, then we have last values available
+    if (state.hasLast && state.hasPfcRxPacketsLast && state.hasPfcRxPauseLast)
+    {
+        if (isStorm(state, counters, pollTime))
+        {
+            if (state.detectionTimeLeft <= pollTime)
+            {
+                events.push_back({ queue, true });
+                deadlock = true;
+                state.detectionTimeLeft = state.detectionTime;
+            }
+            else
+            {
+                state.detectionTimeLeft -= pollTime;
+            }
+        }
+        else
+        {
+            if (state.alert && state.stormed)
+            {
+                events.push_back({ queue, false });
+            }
+            state.detectionTimeLeft = state.detectionTime;
+        }
+    }
+
+    // Save values for next run
+    state.packetsLast = counters.packets;
+    state.pauseStatusLast = counters.pauseStatus;
+    state.hasLast = true;
+
+    if (!deadlock || m_criteria == PfcWdStormCriteria::PFC_WD_STORM_PAUSE_STATUS)
+    {
+        state.pfcRxPacketsLast = counters.pfcRxPackets;
+        state.pfcRxPauseLast = counters.pfcRxPause;
+        state.hasPfcRxPacketsLast = true;
+        state.hasPfcRxPauseLast = true;
+    }
+    else if (m_criteria == PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION)
+    {
+        // PFC counters are compared from scratch once the storm is detected
+        state.hasPfcRxPacketsLast = false;
+        state.hasPfcRxPauseLast = false;
+    }
+}
+
+void PfcWdDetector::restore(uint32_t queue, const PfcWdQueueCounters &counters, uint32_t pollTime,
+        vector<PfcWdDetectorEvent> &events)
+{
+    QueueState &state = m_queues[queue];
+
+    if (state.hasPfcRxPacketsLast)
+    {
+        // Check actual condition of queue being restored from PFC storm
+        if (counters.pfcRxPackets == state.pfcRxPacketsLast && !counters.debugStorm)
+        {
+            if (state.restorationTimeLeft <= pollTime)
+            {
+                events.push_back({ queue, false });
+                state.restorationTimeLeft = state.restorationTime;
+            }
+            else
+            {
+                state.restorationTimeLeft -= pollTime;
+            }
+        }
+        else
+        {
+            state.restorationTimeLeft = state.restorationTime;
+        }
+    }
+
+    // Save values for next run
+    state.pfcRxPacketsLast = counters.pfcRxPackets;
+    state.hasPfcRxPacketsLast = true;
+}
+
+/*
+ * Returns true if the counters are to be processed, accounting pollTime in
+ * the time elapsed since the last processed sample.
+ */
+bool PfcWdDetector::isNewSample(uint32_t queue, const PfcWdQueueCounters &counters, uint32_t pollTime)
+{
+    QueueState &state = m_queues[queue];
+    const PfcWdQueueCounters &sample = state.sample;
+
+    state.elapsedTime += pollTime;
+
+    bool unchanged = sample.valid && !counters.debugStorm &&
+        counters.occupancyBytes == sample.occupancyBytes &&
+        counters.packets == sample.packets &&
+        counters.pfcRxPackets == sample.pfcRxPackets &&
+        counters.pfcRxPause == sample.pfcRxPause &&
+        counters.pauseStatus == sample.pauseStatus;
+    if (!m_samples.take(queue, unchanged))
+    {
+        return false;
+    }
+
+    state.sample = counters;
+    return true;
+}
+
+/*
+ * Run detection and then restoration on all queues, in the same order as
+ * syncd runs the plugins. Storm and restore events are appended to events,
+ * the caller applies them and updates the stormed state of the queues.
+ */
+void PfcWdDetector::poll(const vector<PfcWdQueueCounters> &counters, uint32_t pollTime,
+        vector<PfcWdDetectorEvent> &events)
+{
+    size_t count = min(counters.size(), m_queues.size());
+
+    for (uint32_t queue = 0; queue < count; queue++)
+    {
+        QueueState &state = m_queues[queue];
+        const PfcWdQueueCounters &queueCounters = counters[queue];
+
+        if (!m_slots.used(queue) || !queueCounters.valid || !isNewSample(queue, queueCounters, pollTime))
+        {
+            continue;
+        }
+
+        uint32_t elapsedTime = state.elapsedTime;
+        state.elapsedTime = 0;
+
+        if (!state.stormed || state.alert)
+        {
+            detect(queue, queueCounters, elapsedTime, events);
+        }
+
+        if (state.stormed && !state.alert && state.restorationTime != 0)
+        {
+            restore(queue, queueCounters, elapsedTime, events);
+        }
+    }
+}
+
+PfcWdCounterReader::PfcWdCounterReader(DBConnector *countersDb, PfcWdStormCriteria criteria, const string &pfcRxPauseStat):
+    m_countersDb(countersDb),
+    m_criteria(criteria),
+    m_pfcRxPauseStat(pfcRxPauseStat)
+{
+    if (isCounterSnapshotEnabled("QUEUE"))
+    {
+        m_queueSnapshot.reset(new CounterSnapshotReader(getCounterSnapshotName("QUEUE")));
+    }
+
+    if (isCounterSnapshotEnabled("PORT"))
+    {
+        m_portSnapshot.reset(new CounterSnapshotReader(getCounterSnapshotName("PORT")));
+    }
+}
+
+void PfcWdCounterReader::setQueue(uint32_t queue, const string &queueId, const string &portId, uint8_t index)
+{
+    if (queue >= m_queues.size())
+    {
+        m_queues.resize(queue + 1);
+    }
+
+    QueueKeys &keys = m_queues[queue];
+    keys.queueId = queueId;
+    keys.portId = portId;
+    keys.queueKey = string(COUNTERS_TABLE) + ":" + queueId;
+    keys.portKey = string(COUNTERS_TABLE) + ":" + portId;
+    keys.portFields = {
+        PFC_WD_PORT_STAT_PFC_PREFIX + to_string(index) + "_RX_PKTS",
+        PFC_WD_PORT_STAT_PFC_PREFIX + to_string(index) + "_" + m_pfcRxPauseStat
+    };
+    keys.used = true;
+}
+
+void PfcWdCounterReader::removeQueue(uint32_t queue)
+{
+    if (queue < m_queues.size())
+    {
+        m_queues[queue] = QueueKeys();
+    }
+}
+
+/*
+ * Read the counters of all queues in one round trip. counters is indexed
+ * by queue slot, queues with missing counters are left invalid.
+ */
+void PfcWdCounterReader::read(vector<PfcWdQueueCounters> &counters)
+{
+    static const vector<string> queueFields = { PFC_WD_QUEUE_OCCUPANCY_BYTES, PFC_WD_QUEUE_PACKETS };
+
+    counters.assign(m_queues.size(), PfcWdQueueCounters());
+
+    redisContext *ctx = m_countersDb->getContext();
+
+    for (auto snapshot : { m_queueSnapshot.get(), m_portSnapshot.get() })
+    {
+        if (snapshot)
+        {
+            snapshot->refresh();
+        }
+    }
+
+    vector<uint8_t> queueFromSnapshot(m_queues.size());
+    vector<uint8_t> portFromSnapshot(m_queues.size());
+    uint64_t values[2];
+
+    for (size_t queue = 0; queue < m_queues.size(); queue++)
+    {
+        const QueueKeys &keys = m_queues[queue];
+        if (!keys.used)
+        {
+            continue;
+        }
+
+        PfcWdQueueCounters &queueCounters = counters[queue];
+
+        if (m_queueSnapshot && m_queueSnapshot->read(keys.queueId, queueFields, values))
+        {
+            queueFromSnapshot[queue] = 1;
+            queueCounters.occupancyBytes = values[0];
+            queueCounters.packets = values[1];
+            redisAppendCommand(ctx, "HMGET %s %s %s", keys.queueKey.c_str(),
+                    PFC_WD_QUEUE_PAUSE_STATUS, PFC_WD_QUEUE_DEBUG_STORM);
+        }
+        else
+        {
+            redisAppendCommand(ctx, "HMGET %s %s %s %s %s", keys.queueKey.c_str(),
+                    PFC_WD_QUEUE_OCCUPANCY_BYTES, PFC_WD_QUEUE_PACKETS,
+                    PFC_WD_QUEUE_PAUSE_STATUS, PFC_WD_QUEUE_DEBUG_STORM);
+        }
+
+        if (m_portSnapshot && m_portSnapshot->read(keys.portId, keys.portFields, values))
+        {
+            portFromSnapshot[queue] = 1;
+            queueCounters.pfcRxPackets = values[0];
+            queueCounters.pfcRxPause = values[1];
+        }
+        else
+        {
+            redisAppendCommand(ctx, "HMGET %s %s %s", keys.portKey.c_str(),
+                    keys.portFields[0].c_str(), keys.portFields[1].c_str());
+        }
+    }
+
+    for (size_t queue = 0; queue < m_queues.size(); queue++)
+    {
+        if (!m_queues[queue].used)
+        {
+            continue;
+        }
+
+        CountersDbReplyPtr queueReply = getCountersDbReply(ctx);
+        PfcWdQueueCounters &queueCounters = counters[queue];
+        bool valid = true;
+
+        /* The pause status and DEBUG_STORM follow the counters in the queue reply */
+        size_t statusIndex = 0;
+        if (!queueFromSnapshot[queue])
+        {
+            valid = getCountersDbCounter(queueReply.get(), 0, queueCounters.occupancyBytes) &&
+                getCountersDbCounter(queueReply.get(), 1, queueCounters.packets);
+            statusIndex = 2;
+        }
+
+        if (!portFromSnapshot[queue])
+        {
+            CountersDbReplyPtr portReply = getCountersDbReply(ctx);
+            valid = getCountersDbCounter(portReply.get(), 0, queueCounters.pfcRxPackets) &&
+                getCountersDbCounter(portReply.get(), 1, queueCounters.pfcRxPause) && valid;
+        }
+
+        const char *pauseStatus = getCountersDbField(queueReply.get(), statusIndex);
+        if (m_criteria == PfcWdStormCriteria::PFC_WD_STORM_PAUSE_STATUS && pauseStatus == nullptr)
+        {
+            valid = false;
+        }
+        queueCounters.pauseStatus = pauseStatus != nullptr && string(pauseStatus) == "true";
+
+        const char *debugStorm = getCountersDbField(queueReply.get(), statusIndex + 1);
+        queueCounters.debugStorm = debugStorm != nullptr && string(debugStorm) == "enabled";
+
+        queueCounters.valid = valid;
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef SWSS_PFCWDDETECTOR_H
+#define SWSS_PFCWDDETECTOR_H
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dbconnector.h"
+#include "counter_slots.h"
+#include "counter_snapshot.h"
+
+/*
+ * PFC storm criteria of the pfc_detect_<platform>.lua plugins
+ */
+enum class PfcWdStormCriteria
+{
+    /* broadcom: PFC frames received without XON, queue paused on both polls */
+    PFC_WD_STORM_PAUSE_STATUS,
+    /* mellanox, barefoot, nephos: no TX while PFC frames are received,
+     * or empty queue paused for most of the poll */
+    PFC_WD_STORM_PAUSE_DURATION,
+    /* innovium: as above, empty queue also requires PFC frames received */
+    PFC_WD_STORM_PAUSE_DURATION_RX,
+};
+
+struct PfcWdQueueCounters
+{
+    uint64_t occupancyBytes = 0;
+    uint64_t packets = 0;
+    uint64_t pfcRxPackets = 0;
+    uint64_t pfcRxPause = 0;        // ON2OFF_RX_PKTS or RX_PAUSE_DURATION, by the criteria
+    bool pauseStatus = false;
+    bool debugStorm = false;
+    bool valid = false;             // all counters used by the criteria were read
+};
+
+struct PfcWdDetectorEvent
+{
+    uint32_t queue;                 // queue slot
+    bool storm;                     // storm or restore
+};
+
+/*
+ * In-process PFC storm detection and restoration, equivalent to the
+ * pfc_detect_<platform>.lua and pfc_restore.lua plugins run by syncd.
+ * Per queue state lives in a slot array instead of COUNTERS_DB fields.
+ * Times are in microseconds.
+ *
+ * The plugins run right after each syncd poll while the detector is polled
+ * on its own timer, at the same interval. Samples unchanged since the last
+ * one of a queue are skipped once by a SampleFilter, and the time elapsed
+ * since the last sample is applied when the next sample is processed.
+ */
+class PfcWdDetector
+{
+public:
+    PfcWdDetector(PfcWdStormCriteria criteria);
+
+    uint32_t addQueue(uint32_t detectionTime, uint32_t restorationTime, bool alert);
+    void removeQueue(uint32_t queue);
+    void setStormed(uint32_t queue, bool stormed);
+
+    /* Number of slots, the size of the counters passed to poll() */
+    size_t size() const
+    {
+        return m_queues.size();
+    }
+
+    void poll(const std::vector<PfcWdQueueCounters> &counters, uint32_t pollTime,
+            std::vector<PfcWdDetectorEvent> &events);
+
+private:
+    struct QueueState
+    {
+        uint64_t packetsLast;
+        uint64_t pfcRxPacketsLast;
+        uint64_t pfcRxPauseLast;
+        uint32_t detectionTime;
+        uint32_t restorationTime;
+        uint32_t detectionTimeLeft;
+        uint32_t restorationTimeLeft;
+        uint32_t elapsedTime;
+        PfcWdQueueCounters sample;
+        bool alert;
+        bool stormed;
+        bool pauseStatusLast;
+        bool hasLast;
+        bool hasPfcRxPacketsLast;
+        bool hasPfcRxPauseLast;
+    };
+
+    bool isNewSample(uint32_t queue, const PfcWdQueueCounters &counters, uint32_t pollTime);
+    bool isStorm(const QueueState &state, const PfcWdQueueCounters &counters, uint32_t pollTime) const;
+    void detect(uint32_t queue, const PfcWdQueueCounters &counters, uint32_t pollTime,
+            std::vector<PfcWdDetectorEvent> &events);
+    void restore(uint32_t queue, const PfcWdQueueCounters &counters, uint32_t pollTime,
+            std::vector<PfcWdDetectorEvent> &events);
+
+    PfcWdStormCriteria m_criteria;
+    CounterSlots m_slots;
+    SampleFilter m_samples;
+    std::vector<QueueState> m_queues;
+};
+
+/*
+ * Reads the counters used by PfcWdDetector from COUNTERS_DB, pipelining one
+ * HMGET per queue and one per port priority, with no writes back. The
+ * counters found in the PORT and QUEUE counter snapshots, when enabled, are
+ * not requested: only the queue pause status and DEBUG_STORM, which are not
+ * counters, are always read from COUNTERS_DB.
+ */
+class PfcWdCounterReader
+{
+public:
+    PfcWdCounterReader(swss::DBConnector *countersDb, PfcWdStormCriteria criteria, const std::string &pfcRxPauseStat);
+
+    void setQueue(uint32_t queue, const std::string &queueId, const std::string &portId, uint8_t index);
+    void removeQueue(uint32_t queue);
+
+    void read(std::vector<PfcWdQueueCounters> &counters);
+
+private:
+    struct QueueKeys
+    {
+        std::string queueId;
+        std::string portId;
+        std::string queueKey;
+        std::string portKey;
+        // PFC_<index>_RX_PKTS and the pause stat of the queue priority
+        std::vector<std::string> portFields;
+        bool used = false;
+    };
+
+    swss::DBConnector *m_countersDb;
+    PfcWdStormCriteria m_criteria;
+    std::string m_pfcRxPauseStat;
+    std::vector<QueueKeys> m_queues;
+    std::unique_ptr<CounterSnapshotReader> m_queueSnapshot;
+    std::unique_ptr<CounterSnapshotReader> m_portSnapshot;
+};
+
+#endif /* SWSS_PFCWDDETECTOR_H */
@@ -17,6 +17,8 @@
 #define PFC_WD_RESTORATION_TIME         "restoration_time"
 #define BIG_RED_SWITCH_FIELD            "BIG_RED_SWITCH"
 #define PFC_WD_IN_STORM                 "storm"
+#define PFC_WD_DETECTION_MODE           "DETECTION_MODE"
+#define PFC_WD_DETECTION_MODE_NATIVE    "native"
 
 #define PFC_WD_DETECTION_TIME_MAX       (5 * 1000)
 #define PFC_WD_DETECTION_TIME_MIN       100
@@ -301,6 +303,22 @@ task_process_status PfcWdSwOrch<DropHandler, ForwardHandler>::createEntry(const
                 vector<FieldValueTuple> fieldValues;
                 fieldValues.emplace_back(POLL_INTERVAL_FIELD, value);
                 m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+
+                if (m_detectionTimer != nullptr)
+                {
+                    int pollInterval = atoi(value.c_str());
+                    if (pollInterval <= 0)
+                    {
+                        SWSS_LOG_ERROR("Invalid PFC watchdog poll interval %s", value.c_str());
+                        return task_process_status::task_invalid_entry;
+                    }
+
+                    // Detection works in the intervals of the counter polling
+                    m_pollInterval = pollInterval;
+                    auto interv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+                    m_detectionTimer->setInterval(interv);
+                    m_detectionTimer->reset();
+                }
             }
             else if (field == BIG_RED_SWITCH_FIELD)
             {
@@ -412,15 +430,19 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::enableBigRedSwitchMode()
     }
 
     // Disable pfcwdaction handler on each queue if exists.
+    vector<shared_ptr<PfcWdActionHandler>> handlers;
     for (auto & entry: m_entryMap)
     {
         if (entry.second.handler != nullptr)
         {
-            entry.second.handler->commitCounters();
+            handlers.push_back(entry.second.handler);
             entry.second.handler = nullptr;
         }
     }
 
+    PfcWdActionHandler::commitCounters(this->getCountersDb().get(), handlers);
+    handlers.clear();
+
     // Create pfcwdaction handler on all the ports.
     for (auto & it: allPorts)
     {
@@ -546,7 +568,12 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
         }
 
         // Create internal entry
-        m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias));
+        auto entry = m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias)).first;
+
+        if (m_detector)
+        {
+            addToNativeDetection(port, i, detectionTime * 1000, restorationTime * 1000, entry->second.action);
+        }
 
         string key = getFlexCounterTableKey(queueIdStr);
         m_flexCounterTable->set(key, queueFieldValues);
@@ -629,6 +656,11 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
 
         m_entryMap.erase(queueId);
 
+        if (m_detector)
+        {
+            removeFromNativeDetection(queueId);
+        }
+
         // Clean up
         string countersKey = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator() + sai_serialize_object_id(queueId);
         this->getCountersDb()->hdel(countersKey, {"PFC_WD_DETECTION_TIME", "PFC_WD_RESTORATION_TIME", "PFC_WD_ACTION", "PFC_WD_STATUS"});
@@ -664,31 +696,45 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
         return;
     }
 
-    string detectSha, restoreSha;
-    string detectPluginName = "pfc_detect_" + platform + ".lua";
-    string restorePluginName = "pfc_restore.lua";
+    string detectionMode;
+    Table(db, CFG_PFC_WD_TABLE_NAME).hget(PFC_WD_GLOBAL, PFC_WD_DETECTION_MODE, detectionMode);
 
-    try
+    if (detectionMode == PFC_WD_DETECTION_MODE_NATIVE && initNativeDetection(platform))
     {
-        string detectLuaScript = swss::loadLuaScript(detectPluginName);
-        detectSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                detectLuaScript);
-
-        string restoreLuaScript = swss::loadLuaScript(restorePluginName);
-        restoreSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                restoreLuaScript);
-
+        // Queues are still polled by syncd, but no plugins are run on them
         vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
         m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
     }
-    catch (...)
+    else
     {
-        SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        string detectSha, restoreSha;
+        string detectPluginName = "pfc_detect_" + platform + ".lua";
+        string restorePluginName = "pfc_restore.lua";
+
+        try
+        {
+            string detectLuaScript = swss::loadLuaScript(detectPluginName);
+            detectSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    detectLuaScript);
+
+            string restoreLuaScript = swss::loadLuaScript(restorePluginName);
+            restoreSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    restoreLuaScript);
+
+            vector<FieldValueTuple> fieldValues;
+            fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
+            fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
+            fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
+            m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+        }
+        catch (...)
+        {
+            SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        }
     }
 
     auto consumer = new swss::NotificationConsumer(
@@ -882,14 +928,131 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_detectionTimer)
+    {
+        pollNativeDetection();
+        return;
+    }
+
+    vector<shared_ptr<PfcWdActionHandler>> handlers;
     for (auto& handlerPair : m_entryMap)
     {
         if (handlerPair.second.handler != nullptr)
         {
-            handlerPair.second.handler->commitCounters(true);
+            handlers.push_back(handlerPair.second.handler);
         }
     }
 
+    PfcWdActionHandler::commitCounters(this->getCountersDb().get(), handlers, true);
+}
+
+template <typename DropHandler, typename ForwardHandler>
+bool PfcWdSwOrch<DropHandler, ForwardHandler>::initNativeDetection(const string &platform)
+{
+    SWSS_LOG_ENTER();
+
+    // Storm criteria and PFC pause counter of the platform detect plugin
+    static const map<string, pair<PfcWdStormCriteria, string>> platformCriteria =
+    {
+        { BRCM_PLATFORM_SUBSTRING, { PfcWdStormCriteria::PFC_WD_STORM_PAUSE_STATUS, "ON2OFF_RX_PKTS" } },
+        { MLNX_PLATFORM_SUBSTRING, { PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION, "RX_PAUSE_DURATION_US" } },
+        { BFN_PLATFORM_SUBSTRING, { PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION, "RX_PAUSE_DURATION" } },
+        { NPS_PLATFORM_SUBSTRING, { PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION, "RX_PAUSE_DURATION" } },
+        { INVM_PLATFORM_SUBSTRING, { PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION_RX, "RX_PAUSE_DURATION" } },
+    };
+
+    auto criteria = platformCriteria.find(platform);
+    if (criteria == platformCriteria.end())
+    {
+        SWSS_LOG_WARN("Native PFC watchdog detection is not supported on platform %s, using plugins", platform.c_str());
+        return false;
+    }
+
+    m_detector.reset(new PfcWdDetector(criteria->second.first));
+    m_detectorCountersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
+    m_counterReader.reset(new PfcWdCounterReader(m_detectorCountersDb.get(), criteria->second.first, criteria->second.second));
+
+    auto interv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+    m_detectionTimer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(m_detectionTimer, this, "PFC_WD_DETECTION_POLL");
+    Orch::addExecutor(executor);
+    m_detectionTimer->start();
+
+    SWSS_LOG_NOTICE("PFC watchdog storm detection runs in orchagent");
+    return true;
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::addToNativeDetection(const Port& port, uint8_t index,
+        uint32_t detectionTime, uint32_t restorationTime, PfcWdAction action)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t queueId = port.m_queue_ids[index];
+
+    // Configuration update restarts detection on the queue
+    removeFromNativeDetection(queueId);
+
+    uint32_t slot = m_detector->addQueue(detectionTime, restorationTime, action == PfcWdAction::PFC_WD_ACTION_ALERT);
+    m_counterReader->setQueue(slot, sai_serialize_object_id(queueId), sai_serialize_object_id(port.m_port_id), index);
+
+    if (slot >= m_detectorQueueIds.size())
+    {
+        m_detectorQueueIds.resize(slot + 1, SAI_NULL_OBJECT_ID);
+    }
+    m_detectorQueueIds[slot] = queueId;
+    m_detectorQueueSlots[queueId] = slot;
+
+    auto entry = m_entryMap.find(queueId);
+    if (entry != m_entryMap.end() && entry->second.handler != nullptr)
+    {
+        m_detector->setStormed(slot, true);
+    }
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::removeFromNativeDetection(sai_object_id_t queueId)
+{
+    SWSS_LOG_ENTER();
+
+    auto slot = m_detectorQueueSlots.find(queueId);
+    if (slot == m_detectorQueueSlots.end())
+    {
+        return;
+    }
+
+    m_detector->removeQueue(slot->second);
+    m_counterReader->removeQueue(slot->second);
+    m_detectorQueueIds[slot->second] = SAI_NULL_OBJECT_ID;
+    m_detectorQueueSlots.erase(slot);
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::pollNativeDetection(void)
+{
+    SWSS_LOG_ENTER();
+
+    // Plugins skip the queues in BIG_RED_SWITCH mode
+    if (m_bigRedSwitchFlag)
+    {
+        return;
+    }
+
+    m_counterReader->read(m_detectorCounters);
+
+    m_detectorEvents.clear();
+    m_detector->poll(m_detectorCounters, (uint32_t)m_pollInterval * 1000, m_detectorEvents);
+
+    for (const auto &event : m_detectorEvents)
+    {
+        sai_object_id_t queueId = m_detectorQueueIds[event.queue];
+        string eventName = event.storm ? PFC_WD_IN_STORM : "restore";
+
+        if (!startWdActionOnQueue(eventName, queueId))
+        {
+            SWSS_LOG_ERROR("Failed to start PFC watchdog %s event action on queue 0x%" PRIx64, eventName.c_str(), queueId);
+        }
+    }
 }
 
 template <typename DropHandler, typename ForwardHandler>
@@ -1006,6 +1169,13 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string
         return false;
     }
 
+    // Plugins read the queue status from PFC_WD_STATUS set by the handlers
+    auto slot = m_detectorQueueSlots.find(queueId);
+    if (slot != m_detectorQueueSlots.end())
+    {
+        m_detector->setStormed(slot->second, entry->second.handler != nullptr);
+    }
+
     return true;
 }
 
@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "port.h"
 #include "pfcactionhandler.h"
+#include "pfcwddetector.h"
 #include "producertable.h"
 #include "notificationconsumer.h"
 #include "timer.h"
@@ -117,6 +118,12 @@ private:
     void enableBigRedSwitchMode();
     void setBigRedSwitchMode(string value);
 
+    bool initNativeDetection(const string &platform);
+    void addToNativeDetection(const Port& port, uint8_t index,
+            uint32_t detectionTime, uint32_t restorationTime, PfcWdAction action);
+    void removeFromNativeDetection(sai_object_id_t queueId);
+    void pollNativeDetection(void);
+
     map<sai_object_id_t, PfcWdQueueEntry> m_entryMap;
     map<sai_object_id_t, PfcWdQueueEntry> m_brsEntryMap;
 
@@ -131,6 +138,16 @@ private:
     bool m_bigRedSwitchFlag = false;
     int m_pollInterval;
 
+    // In-process storm detection instead of the Lua plugins
+    unique_ptr<PfcWdDetector> m_detector = nullptr;
+    unique_ptr<PfcWdCounterReader> m_counterReader = nullptr;
+    shared_ptr<DBConnector> m_detectorCountersDb = nullptr;
+    SelectableTimer *m_detectionTimer = nullptr;
+    map<sai_object_id_t, uint32_t> m_detectorQueueSlots;
+    vector<sai_object_id_t> m_detectorQueueIds;
+    vector<PfcWdQueueCounters> m_detectorCounters;
+    vector<PfcWdDetectorEvent> m_detectorEvents;
+
     shared_ptr<DBConnector> m_applDb = nullptr;
     // Track queues in storm
     shared_ptr<Table> m_applTable = nullptr;
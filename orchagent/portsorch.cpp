@@ -5,6 +5,7 @@
 #include "gearboxutils.h"
 #include "vxlanorch.h"
 #include "directory.h"
+#include "watermarkaggregator.h"
 
 #include <inttypes.h>
 #include <cassert>
@@ -62,8 +63,6 @@ extern string gMyAsicName;
 #define PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS     1000
 #define PORT_BUFFER_DROP_STAT_POLLING_INTERVAL_MS     60000
 #define QUEUE_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS   10000
-#define QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS "10000"
-#define PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS    "10000"
 #define PG_DROP_FLEX_STAT_COUNTER_POLL_MSECS         "10000"
 #define PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS   "1000"
 
@@ -335,32 +334,54 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     string queueWmPluginName = "watermark_queue.lua";
     string pgWmPluginName = "watermark_pg.lua";
     string portRatePluginName = "port_rates.lua";
+    bool nativePortRates = isNativeRatesMode("PORT_RATES");
+    bool nativeQueueWm = isNativeWatermarkMode("QUEUE_WATERMARK");
+    bool nativePgWm = isNativeWatermarkMode("PG_WATERMARK");
 
     try
     {
-        string queueLuaScript = swss::loadLuaScript(queueWmPluginName);
-        queueWmSha = swss::loadRedisScript(m_counter_db.get(), queueLuaScript);
+        if (!nativeQueueWm)
+        {
+            string queueLuaScript = swss::loadLuaScript(queueWmPluginName);
+            queueWmSha = swss::loadRedisScript(m_counter_db.get(), queueLuaScript);
+        }
 
-        string pgLuaScript = swss::loadLuaScript(pgWmPluginName);
-        pgWmSha = swss::loadRedisScript(m_counter_db.get(), pgLuaScript);
+        if (!nativePgWm)
+        {
+            string pgLuaScript = swss::loadLuaScript(pgWmPluginName);
+            pgWmSha = swss::loadRedisScript(m_counter_db.get(), pgLuaScript);
+        }
 
-        string portRateLuaScript = swss::loadLuaScript(portRatePluginName);
-        string portRateSha = swss::loadRedisScript(m_counter_db.get(), portRateLuaScript);
+        string portRateSha;
+        if (!nativePortRates)
+        {
+            string portRateLuaScript = swss::loadLuaScript(portRatePluginName);
+            portRateSha = swss::loadRedisScript(m_counter_db.get(), portRateLuaScript);
+        }
 
         vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, queueWmSha);
+        if (!nativeQueueWm)
+        {
+            fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, queueWmSha);
+        }
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ_AND_CLEAR);
         m_flexCounterGroupTable->set(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
 
         fieldValues.clear();
-        fieldValues.emplace_back(PG_PLUGIN_FIELD, pgWmSha);
+        if (!nativePgWm)
+        {
+            fieldValues.emplace_back(PG_PLUGIN_FIELD, pgWmSha);
+        }
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ_AND_CLEAR);
         m_flexCounterGroupTable->set(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
 
         fieldValues.clear();
-        fieldValues.emplace_back(PORT_PLUGIN_FIELD, portRateSha);
+        if (!nativePortRates)
+        {
+            fieldValues.emplace_back(PORT_PLUGIN_FIELD, portRateSha);
+        }
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS);
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
         m_flexCounterGroupTable->set(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
@@ -375,6 +396,26 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         SWSS_LOG_ERROR("Port flex counter groups were not set successfully: %s", e.what());
     }
 
+    if (nativePortRates)
+    {
+        const vector<CounterRates::Rate> portRates =
+        {
+            { "RX_BPS", { "SAI_PORT_STAT_IF_IN_OCTETS" } },
+            { "RX_PPS", { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS" } },
+            { "TX_BPS", { "SAI_PORT_STAT_IF_OUT_OCTETS" } },
+            { "TX_PPS", { "SAI_PORT_STAT_IF_OUT_UCAST_PKTS", "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS" } },
+        };
+        m_portRates = unique_ptr<CounterRates>(new CounterRates(m_counter_db.get(), "PORT", portRates));
+
+        int interval = stoi(PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS);
+        auto intervT = timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 };
+        m_portRatesTimer = new SelectableTimer(intervT);
+        auto executorT = new ExecutableTimer(m_portRatesTimer, this, "PORT_RATES_TIMER");
+        Orch::addExecutor(executorT);
+        m_portRatesTimer->start();
+        SWSS_LOG_NOTICE("Port rates are computed in orchagent");
+    }
+
     uint32_t i, j;
     sai_status_t status;
     sai_attribute_t attr;
@@ -1143,6 +1184,7 @@ bool PortsOrch::setPortPfc(sai_object_id_t portId, uint8_t pfc_bitmask)
     {
         p.m_pfc_bitmask = pfc_bitmask;
         m_portList[p.m_alias] = p;
+        CounterCheckOrch::getInstance().invalidatePfcMask(portId);
     }
 
     return true;
@@ -2333,6 +2375,10 @@ bool PortsOrch::initPort(const string &alias, const string &role, const int inde
                 {
                     auto port_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP);
                     port_stat_manager.setCounterIdList(p.m_port_id, CounterType::PORT, port_counter_stats);
+                    if (m_portRates)
+                    {
+                        m_portRates->addObject(sai_serialize_object_id(p.m_port_id));
+                    }
                 }
                 if (flex_counters_orch->getPortBufferDropCountersState())
                 {
@@ -2380,10 +2426,16 @@ void PortsOrch::deInitPort(string alias, sai_object_id_t port_id)
     if ((flex_counters_orch->getPortCountersState()))
     {
         port_stat_manager.clearCounterIdList(p.m_port_id);
+        if (m_portRates)
+        {
+            m_portRates->removeObject(sai_serialize_object_id(p.m_port_id));
+        }
     }
     /* remove port name map from counter table */
     m_counter_db->hdel(COUNTERS_PORT_NAME_MAP, alias);
 
+    CounterCheckOrch::getInstance().removePort(p);
+
     /* Remove the associated port serdes attribute */
     removePortSerdesAttribute(p.m_port_id);
 
@@ -2755,6 +2807,10 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
+                /* Counters of the ports initialized below are registered in one batch */
+                port_stat_manager.setDeferredMode(true);
+                port_buffer_drop_stat_manager.setDeferredMode(true);
+
                 for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
                 {
                     if (m_portListLaneMap.find(it->first) == m_portListLaneMap.end())
@@ -2774,6 +2830,9 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     it++;
                 }
 
+                port_stat_manager.setDeferredMode(false);
+                port_buffer_drop_stat_manager.setDeferredMode(false);
+
                 m_portConfigState = PORT_CONFIG_DONE;
             }
 
@@ -5022,6 +5081,14 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
     vector<FieldValueTuple> queueIndexVector;
     vector<FieldValueTuple> queueTypeVector;
 
+    // Install a flex counter for the queues of the port to track stats
+    std::unordered_set<string> counter_stats;
+    for (const auto& it: queue_stat_ids)
+    {
+        counter_stats.emplace(sai_serialize_queue_stat(it));
+    }
+    queue_stat_manager.setCounterIdList(port.m_queue_ids, CounterType::QUEUE, counter_stats);
+
     for (size_t queueIndex = 0; queueIndex < port.m_queue_ids.size(); ++queueIndex)
     {
         std::ostringstream name;
@@ -5040,14 +5107,6 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
             queueIndexVector.emplace_back(id, to_string(queueRealIndex));
         }
 
-        // Install a flex counter for this queue to track stats
-        std::unordered_set<string> counter_stats;
-        for (const auto& it: queue_stat_ids)
-        {
-            counter_stats.emplace(sai_serialize_queue_stat(it));
-        }
-        queue_stat_manager.setCounterIdList(port.m_queue_ids[queueIndex], CounterType::QUEUE, counter_stats);
-
         /* add watermark queue counters */
         string key = getQueueWatermarkFlexCounterTableKey(id);
 
@@ -5157,6 +5216,7 @@ void PortsOrch::generatePortCounterMap()
     }
 
     auto port_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP);
+    vector<sai_object_id_t> port_ids;
     for (const auto& it: m_portList)
     {
         // Set counter stats only for PHY ports to ensure syncd will not try to query the counter statistics from the HW for non-PHY ports.
@@ -5164,8 +5224,13 @@ void PortsOrch::generatePortCounterMap()
         {
             continue;
         }
-        port_stat_manager.setCounterIdList(it.second.m_port_id, CounterType::PORT, port_counter_stats);
+        port_ids.push_back(it.second.m_port_id);
+        if (m_portRates)
+        {
+            m_portRates->addObject(sai_serialize_object_id(it.second.m_port_id));
+        }
     }
+    port_stat_manager.setCounterIdList(port_ids, CounterType::PORT, port_counter_stats);
 
     m_isPortCounterMapGenerated = true;
 }
@@ -5178,6 +5243,7 @@ void PortsOrch::generatePortBufferDropCounterMap()
     }
 
     auto port_buffer_drop_stats = generateCounterStats(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP);
+    vector<sai_object_id_t> port_ids;
     for (const auto& it: m_portList)
     {
         // Set counter stats only for PHY ports to ensure syncd will not try to query the counter statistics from the HW for non-PHY ports.
@@ -5185,8 +5251,9 @@ void PortsOrch::generatePortBufferDropCounterMap()
         {
             continue;
         }
-        port_buffer_drop_stat_manager.setCounterIdList(it.second.m_port_id, CounterType::PORT, port_buffer_drop_stats);
+        port_ids.push_back(it.second.m_port_id);
     }
+    port_buffer_drop_stat_manager.setCounterIdList(port_ids, CounterType::PORT, port_buffer_drop_stats);
 
     m_isPortBufferDropCounterMapGenerated = true;
 }
@@ -5253,6 +5320,16 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
     }
 }
 
+void PortsOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (&timer == m_portRatesTimer)
+    {
+        m_portRates->poll();
+    }
+}
+
 void PortsOrch::updatePortOperStatus(Port &port, sai_port_oper_status_t status)
 {
     SWSS_LOG_NOTICE("Port %s oper state set from %s to %s",
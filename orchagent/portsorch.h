@@ -10,6 +10,7 @@
 #include "macaddress.h"
 #include "producertable.h"
 #include "flex_counter_manager.h"
+#include "counter_rates.h"
 #include "gearboxutils.h"
 #include "saihelper.h"
 #include "lagid.h"
@@ -25,6 +26,8 @@
 #define QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP "QUEUE_WATERMARK_STAT_COUNTER"
 #define PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP "PG_WATERMARK_STAT_COUNTER"
 #define PG_DROP_STAT_COUNTER_FLEX_COUNTER_GROUP "PG_DROP_STAT_COUNTER"
+#define QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS "10000"
+#define PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS    "10000"
 
 typedef std::vector<sai_uint32_t> PortSupportedSpeeds;
 
@@ -179,6 +182,8 @@ private:
     shared_ptr<DBConnector> m_state_db;
 
     FlexCounterManager port_stat_manager;
+    unique_ptr<CounterRates> m_portRates;
+    SelectableTimer *m_portRatesTimer = nullptr;
     FlexCounterManager port_buffer_drop_stat_manager;
     FlexCounterManager queue_stat_manager;
 
@@ -231,6 +236,7 @@ private:
     void doLagMemberTask(Consumer &consumer);
 
     void doTask(NotificationConsumer &consumer);
+    void doTask(SelectableTimer &timer);
 
     void removePortFromLanesMap(string alias);
     void removePortFromPortListMap(sai_object_id_t port_id);
@@ -6,6 +6,7 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <string>
@@ -24,6 +25,7 @@ extern sai_acl_api_t* sai_acl_api;
 extern PortsOrch *gPortsOrch;
 extern sai_object_id_t gSwitchId;
 extern CrmOrch *gCrmOrch;
+extern size_t gMaxBulkSize;
 
 map<string, sai_ecn_mark_mode_t> ecn_map = {
     {"ecn_none", SAI_ECN_MARK_MODE_NONE},
@@ -71,6 +73,90 @@ type_map QosOrch::m_qos_maps = {
     {CFG_PFC_PRIORITY_TO_QUEUE_MAP_TABLE_NAME, new object_reference_map()}
 };
 
+unordered_map<string, sai_object_id_t> QosMapHandler::m_shared_qos_objects;
+unordered_map<sai_object_id_t, QosMapHandler::SharedQosItem> QosMapHandler::m_shared_qos_items;
+unordered_set<string> QosMapHandler::m_unshared_qos_tables;
+vector<pair<string, sai_object_id_t>> QosMapHandler::m_replaced_qos_items;
+
+string QosMapHandler::getContentKey(const string &qos_map_type_name, const KeyOpFieldsValuesTuple &tuple)
+{
+    vector<string> fields;
+    for (const auto &fv : kfvFieldsValues(tuple))
+    {
+        fields.push_back(fvField(fv) + "=" + fvValue(fv));
+    }
+    sort(fields.begin(), fields.end());
+
+    string content_key = qos_map_type_name;
+    for (const auto &field : fields)
+    {
+        content_key += "|" + field;
+    }
+    return content_key;
+}
+
+void QosMapHandler::registerQosItem(sai_object_id_t sai_object, const string &content_key, const KeyOpFieldsValuesTuple &tuple)
+{
+    // Another map with this content may own an object of its own, after sharing was refused
+    if (m_shared_qos_objects.find(content_key) != m_shared_qos_objects.end())
+    {
+        return;
+    }
+    m_shared_qos_objects[content_key] = sai_object;
+    m_shared_qos_items[sai_object] = { content_key, kfvFieldsValues(tuple), 1 };
+}
+
+void QosMapHandler::unregisterQosItem(sai_object_id_t sai_object)
+{
+    auto it = m_shared_qos_items.find(sai_object);
+    if (it == m_shared_qos_items.end())
+    {
+        return;
+    }
+    m_shared_qos_objects.erase(it->second.content_key);
+    m_shared_qos_items.erase(it);
+}
+
+bool QosMapHandler::unshareQosItems(const string &qos_map_type_name, sai_object_id_t sai_object, vector<FieldValueTuple> &field_values)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_shared_qos_items.find(sai_object);
+    if (it == m_shared_qos_items.end() || it->second.ref_count <= 1)
+    {
+        return false;
+    }
+
+    if (m_unshared_qos_tables.insert(qos_map_type_name).second)
+    {
+        SWSS_LOG_WARN("Maps of %s are no longer shared", qos_map_type_name.c_str());
+    }
+    field_values = it->second.field_values;
+    return true;
+}
+
+vector<pair<string, sai_object_id_t>> QosMapHandler::takeReplacedQosItems()
+{
+    vector<pair<string, sai_object_id_t>> replaced;
+    replaced.swap(m_replaced_qos_items);
+    return replaced;
+}
+
+/*
+ * Drop the reference of a replaced map to the object it left. Returns true
+ * if no map uses the object anymore, the caller removes it.
+ */
+bool QosMapHandler::releaseQosItem(sai_object_id_t sai_object)
+{
+    auto it = m_shared_qos_items.find(sai_object);
+    if (it == m_shared_qos_items.end() || --it->second.ref_count > 0)
+    {
+        return false;
+    }
+    unregisterQosItem(sai_object);
+    return true;
+}
+
 task_process_status QosMapHandler::processWorkItem(Consumer& consumer)
 {
     SWSS_LOG_ENTER();
@@ -86,36 +172,82 @@ task_process_status QosMapHandler::processWorkItem(Consumer& consumer)
     {
         sai_object = (*(QosOrch::getTypeMap()[qos_map_type_name]))[qos_object_name].m_saiObjectId;
     }
+    auto shared_it = m_shared_qos_items.find(sai_object);
+    bool is_shared = shared_it != m_shared_qos_items.end() && shared_it->second.ref_count > 1;
+
     if (op == SET_COMMAND)
     {
-        vector<sai_attribute_t> attributes;
-        if (!convertFieldValuesToAttributes(tuple, attributes))
+        string content_key = getContentKey(qos_map_type_name, tuple);
+        bool can_share = m_unshared_qos_tables.find(qos_map_type_name) == m_unshared_qos_tables.end();
+
+        if (shared_it != m_shared_qos_items.end() && shared_it->second.content_key == content_key && (can_share || !is_shared))
         {
-            return task_process_status::task_invalid_entry;
+            SWSS_LOG_INFO("[%s:%s] is unchanged", qos_map_type_name.c_str(), qos_object_name.c_str());
+            return task_process_status::task_success;
         }
-        if (SAI_NULL_OBJECT_ID != sai_object)
+
+        vector<sai_attribute_t> attributes;
+        if (SAI_NULL_OBJECT_ID != sai_object && !is_shared)
         {
+            if (!convertFieldValuesToAttributes(tuple, attributes))
+            {
+                return task_process_status::task_invalid_entry;
+            }
             if (!modifyQosItem(sai_object, attributes))
             {
                 SWSS_LOG_ERROR("Failed to set [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
                 freeAttribResources(attributes);
                 return task_process_status::task_failed;
             }
+            freeAttribResources(attributes);
+
+            unregisterQosItem(sai_object);
+            if (can_share)
+            {
+                registerQosItem(sai_object, content_key, tuple);
+            }
             SWSS_LOG_NOTICE("Set [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
+            return task_process_status::task_success;
+        }
+
+        /*
+         * A new map, or a map leaving the object it shares with other maps:
+         * use the object of an identical map if there is one.
+         */
+        sai_object_id_t new_object = SAI_NULL_OBJECT_ID;
+        auto object_it = m_shared_qos_objects.find(content_key);
+        if (can_share && object_it != m_shared_qos_objects.end() && object_it->second != sai_object)
+        {
+            new_object = object_it->second;
+            m_shared_qos_items[new_object].ref_count++;
+            SWSS_LOG_NOTICE("Shared [%s:%s] object:%" PRIx64, qos_map_type_name.c_str(), qos_object_name.c_str(), new_object);
         }
         else
         {
-            sai_object = addQosItem(attributes);
-            if (sai_object == SAI_NULL_OBJECT_ID)
+            if (!convertFieldValuesToAttributes(tuple, attributes))
+            {
+                return task_process_status::task_invalid_entry;
+            }
+            new_object = addQosItem(attributes);
+            freeAttribResources(attributes);
+            if (new_object == SAI_NULL_OBJECT_ID)
             {
                 SWSS_LOG_ERROR("Failed to create [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
-                freeAttribResources(attributes);
                 return task_process_status::task_failed;
             }
-            (*(QosOrch::getTypeMap()[qos_map_type_name]))[qos_object_name].m_saiObjectId = sai_object;
+            if (can_share)
+            {
+                registerQosItem(new_object, content_key, tuple);
+            }
             SWSS_LOG_NOTICE("Created [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
         }
-        freeAttribResources(attributes);
+
+        if (SAI_NULL_OBJECT_ID != sai_object)
+        {
+            // The other maps still use the old object, the ports and queues of this one are moved by QosOrch
+            m_replaced_qos_items.emplace_back(qos_map_type_name + delimiter + qos_object_name, sai_object);
+        }
+        (*(QosOrch::getTypeMap()[qos_map_type_name]))[qos_object_name].m_saiObjectId = new_object;
     }
     else if (op == DEL_COMMAND)
     {
@@ -124,10 +256,18 @@ task_process_status QosMapHandler::processWorkItem(Consumer& consumer)
             SWSS_LOG_ERROR("Object with name:%s not found.", qos_object_name.c_str());
             return task_process_status::task_invalid_entry;
         }
-        if (!removeQosItem(sai_object))
+        if (is_shared)
         {
-            SWSS_LOG_ERROR("Failed to remove dscp_to_tc map. db name:%s sai object:%" PRIx64, qos_object_name.c_str(), sai_object);
-            return task_process_status::task_failed;
+            shared_it->second.ref_count--;
+        }
+        else
+        {
+            if (!removeQosItem(sai_object))
+            {
+                SWSS_LOG_ERROR("Failed to remove dscp_to_tc map. db name:%s sai object:%" PRIx64, qos_object_name.c_str(), sai_object);
+                return task_process_status::task_failed;
+            }
+            unregisterQosItem(sai_object);
         }
         auto it_to_delete = (QosOrch::getTypeMap()[qos_map_type_name])->find(qos_object_name);
         (QosOrch::getTypeMap()[qos_map_type_name])->erase(it_to_delete);
@@ -731,7 +871,9 @@ task_process_status QosOrch::handlePfcToQueueTable(Consumer& consumer)
     return pfc_to_queue_handler.processWorkItem(consumer);
 }
 
-QosOrch::QosOrch(DBConnector *db, vector<string> &tableNames) : Orch(db, tableNames)
+QosOrch::QosOrch(DBConnector *db, vector<string> &tableNames) :
+    Orch(db, tableNames),
+    m_portBulker(sai_port_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -1194,9 +1336,14 @@ task_process_status QosOrch::handleQueueTable(Consumer& consumer)
                 }
                 if (!result)
                 {
+                    if (op == SET_COMMAND && unshareQosMap(wred_profile_name))
+                    {
+                        return task_process_status::task_need_retry;
+                    }
                     SWSS_LOG_ERROR("Failed setting field:%s to port:%s, queue:%zd, line:%d", wred_profile_field_name.c_str(), port.m_alias.c_str(), queue_ind, __LINE__);
                     return task_process_status::task_failed;
                 }
+                bindQosMap(port.m_queue_ids[queue_ind], SAI_QUEUE_ATTR_WRED_PROFILE_ID, op == SET_COMMAND ? wred_profile_name : "");
                 SWSS_LOG_DEBUG("Applied wred profile to port:%s", port_name.c_str());
             }
             else if (resolve_result != ref_resolve_status::field_not_found)
@@ -1212,6 +1359,7 @@ task_process_status QosOrch::handleQueueTable(Consumer& consumer)
                         SWSS_LOG_ERROR("Failed unbinding field:%s from port:%s, queue:%zd, line:%d", wred_profile_field_name.c_str(), port.m_alias.c_str(), queue_ind, __LINE__);
                         return task_process_status::task_failed;
                     }
+                    bindQosMap(port.m_queue_ids[queue_ind], SAI_QUEUE_ATTR_WRED_PROFILE_ID, "");
                 }
                 else if (ref_resolve_status::not_resolved == resolve_result)
                 {
@@ -1311,6 +1459,7 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
 
     sai_uint8_t pfc_enable = 0;
     map<sai_port_attr_t, pair<string, sai_object_id_t>> update_list;
+    map<sai_port_attr_t, string> object_names;
     for (auto it = kfvFieldsValues(tuple).begin(); it != kfvFieldsValues(tuple).end(); it++)
     {
         /* Check all map instances are created before applying to ports */
@@ -1328,6 +1477,7 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
             }
 
             update_list[qos_to_attr_map[map_type_name]] = make_pair(map_name, id);
+            object_names[qos_to_attr_map[map_type_name]] = object_name;
         }
 
         if (fvField(*it) == pfc_enable_name)
@@ -1342,6 +1492,9 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
         }
     }
 
+    m_portQosMapSets.push_back({ tuple, {} });
+    auto &port_sets = m_portQosMapSets.back().sets;
+
     vector<string> port_names = tokenize(key, list_item_delimiter);
     for (string port_name : port_names)
     {
@@ -1354,25 +1507,15 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
             continue;
         }
 
-        /* Apply a list of attributes to be applied */
+        /* Queue the attributes to be applied, they are set by flushPortQosMapSets */
         for (auto it = update_list.begin(); it != update_list.end(); it++)
         {
             sai_attribute_t attr;
             attr.id = it->first;
             attr.value.oid = it->second.second;
 
-            sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to apply %s to port %s, rv:%d",
-                               it->second.first.c_str(), port_name.c_str(), status);
-                task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, status);
-                if (handle_status != task_process_status::task_success)
-                {
-                    return task_process_status::task_invalid_entry;
-                }
-            }
-            SWSS_LOG_INFO("Applied %s to port %s", it->second.first.c_str(), port_name.c_str());
+            port_sets.push_back({ port_name, port.m_port_id, it->first, object_names[it->first], SAI_STATUS_NOT_EXECUTED });
+            m_portBulker.set_entry_attribute(&port_sets.back().status, port.m_port_id, &attr);
         }
 
         if (pfc_enable)
@@ -1390,17 +1533,209 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer)
     return task_process_status::task_success;
 }
 
+void QosOrch::flushPortQosMapSets(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_portQosMapSets.empty())
+    {
+        return;
+    }
+
+    m_portBulker.flush();
+
+    for (auto &port_qos_map_sets : m_portQosMapSets)
+    {
+        bool retry = false;
+        for (const auto &set : port_qos_map_sets.sets)
+        {
+            if (set.status == SAI_STATUS_SUCCESS)
+            {
+                bindQosMap(set.port_id, set.attr_id, set.qos_map_name);
+                SWSS_LOG_INFO("Applied %s to port %s", set.qos_map_name.c_str(), set.port_name.c_str());
+                continue;
+            }
+
+            SWSS_LOG_ERROR("Failed to apply %s to port %s, rv:%d",
+                           set.qos_map_name.c_str(), set.port_name.c_str(), set.status);
+            if (unshareQosMap(set.qos_map_name))
+            {
+                retry = true;
+                continue;
+            }
+            task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, set.status);
+            if (handle_status == task_process_status::task_need_retry)
+            {
+                retry = true;
+            }
+        }
+
+        // The entry is applied again once the map has an object of its own or
+        // when the failure calls for a retry, unless a newer update replaces it
+        const string key = kfvKey(port_qos_map_sets.tuple);
+        if (retry && consumer.m_toSync.find(key) == consumer.m_toSync.end())
+        {
+            consumer.addToSync(port_qos_map_sets.tuple);
+        }
+    }
+    m_portQosMapSets.clear();
+}
+
+void QosOrch::bindQosMap(sai_object_id_t object_id, sai_attr_id_t attr_id, const string &qos_map_name)
+{
+    SWSS_LOG_ENTER();
+
+    auto binding = make_pair(object_id, attr_id);
+    auto it = m_bound_qos_maps.find(binding);
+    if (it != m_bound_qos_maps.end())
+    {
+        if (it->second == qos_map_name)
+        {
+            return;
+        }
+        m_qos_map_bindings[it->second].erase(binding);
+        if (m_qos_map_bindings[it->second].empty())
+        {
+            m_qos_map_bindings.erase(it->second);
+        }
+        m_bound_qos_maps.erase(it);
+    }
+
+    if (!qos_map_name.empty())
+    {
+        m_bound_qos_maps[binding] = qos_map_name;
+        m_qos_map_bindings[qos_map_name].insert(binding);
+    }
+}
+
+/*
+ * Apply the maps moved to another SAI object again to the ports and queues
+ * using them. A map keeps its reference to the object it left until all of
+ * them are moved, the failed ones are tried again on the next pass.
+ */
+void QosOrch::rebindReplacedQosMaps()
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &replaced : QosMapHandler::takeReplacedQosItems())
+    {
+        auto bindings = m_qos_map_bindings.find(replaced.first);
+        m_replaced_qos_maps.push_back({ replaced.first, replaced.second,
+                bindings != m_qos_map_bindings.end() ? bindings->second : set<pair<sai_object_id_t, sai_attr_id_t>>() });
+    }
+
+    auto it = m_replaced_qos_maps.begin();
+    while (it != m_replaced_qos_maps.end())
+    {
+        const string &qos_map_name = it->qos_map_name;
+        vector<string> tokens = tokenize(qos_map_name, delimiter, 1);
+        auto obj = m_qos_maps[tokens[0]]->find(tokens[1]);
+
+        auto binding = it->bindings.begin();
+        while (binding != it->bindings.end())
+        {
+            // Removed maps, and ports and queues now using another map, no longer need this one
+            auto bound = m_bound_qos_maps.find(*binding);
+            if (obj == m_qos_maps[tokens[0]]->end() || bound == m_bound_qos_maps.end() || bound->second != qos_map_name)
+            {
+                binding = it->bindings.erase(binding);
+                continue;
+            }
+
+            sai_attribute_t attr;
+            attr.id = binding->second;
+            attr.value.oid = obj->second.m_saiObjectId;
+
+            sai_status_t status;
+            if (tokens[0] == CFG_WRED_PROFILE_TABLE_NAME)
+            {
+                status = sai_queue_api->set_queue_attribute(binding->first, &attr);
+            }
+            else
+            {
+                status = sai_port_api->set_port_attribute(binding->first, &attr);
+            }
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to apply %s to object:%" PRIx64 ", rv:%d",
+                               qos_map_name.c_str(), binding->first, status);
+                binding++;
+                continue;
+            }
+            SWSS_LOG_INFO("Applied %s to object:%" PRIx64, qos_map_name.c_str(), binding->first);
+            binding = it->bindings.erase(binding);
+        }
+
+        if (!it->bindings.empty())
+        {
+            it++;
+            continue;
+        }
+
+        if (QosMapHandler::releaseQosItem(it->old_object))
+        {
+            sai_status_t status;
+            if (tokens[0] == CFG_WRED_PROFILE_TABLE_NAME)
+            {
+                status = sai_wred_api->remove_wred(it->old_object);
+            }
+            else
+            {
+                status = sai_qos_map_api->remove_qos_map(it->old_object);
+            }
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove object:%" PRIx64 " left by %s, rv:%d",
+                               it->old_object, qos_map_name.c_str(), status);
+            }
+        }
+        it = m_replaced_qos_maps.erase(it);
+    }
+}
+
+/*
+ * Give the maps sharing the object of qos_map_name objects of their own,
+ * after the SAI refused to apply the shared object. Returns false if the
+ * object is not shared.
+ */
+bool QosOrch::unshareQosMap(const string &qos_map_name)
+{
+    SWSS_LOG_ENTER();
+
+    vector<string> tokens = tokenize(qos_map_name, delimiter, 1);
+    if (tokens.size() != 2 || m_qos_maps.find(tokens[0]) == m_qos_maps.end())
+    {
+        return false;
+    }
+
+    auto obj = m_qos_maps[tokens[0]]->find(tokens[1]);
+    auto consumer = dynamic_cast<Consumer *>(getExecutor(tokens[0]));
+    vector<FieldValueTuple> field_values;
+    if (obj == m_qos_maps[tokens[0]]->end() || consumer == nullptr ||
+        !QosMapHandler::unshareQosItems(tokens[0], obj->second.m_saiObjectId, field_values))
+    {
+        return false;
+    }
+
+    // Maps are drained before QUEUE and PORT_QOS_MAP, the caller retries once this one has its own object
+    consumer->addToSync(KeyOpFieldsValuesTuple(tokens[1], SET_COMMAND, field_values));
+    SWSS_LOG_NOTICE("Creating a distinct object for %s", qos_map_name.c_str());
+    return true;
+}
+
 void QosOrch::doTask()
 {
     SWSS_LOG_ENTER();
 
+    auto *queue_cfg_exec = getExecutor(CFG_QUEUE_TABLE_NAME);
     auto *port_qos_map_cfg_exec = getExecutor(CFG_PORT_QOS_MAP_TABLE_NAME);
 
+    /* Maps and profiles first, so that QUEUE and PORT_QOS_MAP find them */
     for (const auto &it : m_consumerMap)
     {
         auto *exec = it.second.get();
 
-        if (exec == port_qos_map_cfg_exec)
+        if (exec == queue_cfg_exec || exec == port_qos_map_cfg_exec)
         {
             continue;
         }
@@ -1408,7 +1743,14 @@ void QosOrch::doTask()
         exec->drain();
     }
 
+    queue_cfg_exec->drain();
     port_qos_map_cfg_exec->drain();
+
+    /* Ports and queues a replaced map failed to move to are tried again without new tasks */
+    if (!m_replaced_qos_maps.empty())
+    {
+        rebindReplacedQosMaps();
+    }
 }
 
 void QosOrch::doTask(Consumer &consumer)
@@ -1433,6 +1775,7 @@ void QosOrch::doTask(Consumer &consumer)
         }
 
         auto task_status = (this->*(m_qos_handler_map[qos_map_type_name]))(consumer);
+        rebindReplacedQosMaps();
         switch(task_status)
         {
             case task_process_status::task_success :
@@ -1445,6 +1788,7 @@ void QosOrch::doTask(Consumer &consumer)
             case task_process_status::task_failed :
                 SWSS_LOG_ERROR("Failed to process QOS task, drop it");
                 it = consumer.m_toSync.erase(it);
+                flushPortQosMapSets(consumer);
                 return;
             case task_process_status::task_need_retry :
                 SWSS_LOG_INFO("Failed to process QOS task, retry it");
@@ -1456,4 +1800,6 @@ void QosOrch::doTask(Consumer &consumer)
                 break;
         }
     }
+
+    flushPortQosMapSets(consumer);
 }
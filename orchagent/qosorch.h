@@ -2,10 +2,13 @@
 #define SWSS_QOSORCH_H
 
 #include <map>
+#include <deque>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include "orch.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 const string dscp_to_tc_field_name              = "dscp_to_tc_map";
 const string dot1p_to_tc_field_name             = "dot1p_to_tc_map";
@@ -61,6 +64,37 @@ public:
     virtual bool modifyQosItem(sai_object_id_t, vector<sai_attribute_t> &attributes);
     virtual sai_object_id_t addQosItem(const vector<sai_attribute_t> &attributes) = 0;//different for sub-classes
     virtual bool removeQosItem(sai_object_id_t sai_object);
+
+    static bool unshareQosItems(const string &qos_map_type_name, sai_object_id_t sai_object, vector<FieldValueTuple> &field_values);
+    static vector<pair<string, sai_object_id_t>> takeReplacedQosItems();
+    static bool releaseQosItem(sai_object_id_t sai_object);
+
+private:
+    /*
+     * Maps of a table with the same content share one SAI object. The object
+     * is removed with the last map using it.
+     */
+    struct SharedQosItem
+    {
+        string content_key;
+        vector<FieldValueTuple> field_values;
+        uint32_t ref_count;
+    };
+
+    static string getContentKey(const string &qos_map_type_name, const KeyOpFieldsValuesTuple &tuple);
+    static void registerQosItem(sai_object_id_t sai_object, const string &content_key, const KeyOpFieldsValuesTuple &tuple);
+    static void unregisterQosItem(sai_object_id_t sai_object);
+
+    static unordered_map<string, sai_object_id_t> m_shared_qos_objects;
+    static unordered_map<sai_object_id_t, SharedQosItem> m_shared_qos_items;
+    /* Tables whose maps get distinct objects, after the SAI refused a shared one */
+    static unordered_set<string> m_unshared_qos_tables;
+    /*
+     * Maps moved to another object, to apply again where they are used, with
+     * the object they left. The reference of the map to that object is kept
+     * until it is released once no port or queue uses it for the map.
+     */
+    static vector<pair<string, sai_object_id_t>> m_replaced_qos_items;
 };
 
 class DscpToTcMapHandler : public QosMapHandler
@@ -155,6 +189,11 @@ private:
     task_process_status ResolveMapAndApplyToPort(Port &port,sai_port_attr_t port_attr,
                                                  string field_name, KeyOpFieldsValuesTuple &tuple, string op);
 
+    void bindQosMap(sai_object_id_t object_id, sai_attr_id_t attr_id, const string &qos_map_name);
+    void rebindReplacedQosMaps();
+    bool unshareQosMap(const string &qos_map_name);
+    void flushPortQosMapSets(Consumer &consumer);
+
 private:
     qos_table_handler_map m_qos_handler_map;
 
@@ -165,5 +204,41 @@ private:
     };
 
     std::unordered_map<sai_object_id_t, SchedulerGroupPortInfo_t> m_scheduler_group_port_info;
+
+    /* Ports and queues each map is applied to, by referenced map name (table:name) */
+    std::map<string, std::set<std::pair<sai_object_id_t, sai_attr_id_t>>> m_qos_map_bindings;
+    std::map<std::pair<sai_object_id_t, sai_attr_id_t>, string> m_bound_qos_maps;
+
+    /* Maps moved to another object, with the ports and queues still to apply them to */
+    struct ReplacedQosMap
+    {
+        string qos_map_name;
+        sai_object_id_t old_object;
+        std::set<std::pair<sai_object_id_t, sai_attr_id_t>> bindings;
+    };
+    std::deque<ReplacedQosMap> m_replaced_qos_maps;
+
+    /*
+     * QoS maps of ports are set at the end of each doTask pass, one SAI call
+     * per port and map, then the statuses are checked to bind, retry or report
+     * the PORT_QOS_MAP entry they came from.
+     */
+    struct PortQosMapSet
+    {
+        string port_name;
+        sai_object_id_t port_id;
+        sai_attr_id_t attr_id;
+        string qos_map_name;
+        sai_status_t status;
+    };
+
+    struct PortQosMapSets
+    {
+        KeyOpFieldsValuesTuple tuple;
+        std::deque<PortQosMapSet> sets;
+    };
+
+    ObjectBulker<sai_port_api_t> m_portBulker;
+    std::deque<PortQosMapSets> m_portQosMapSets;
 };
 #endif /* SWSS_QOSORCH_H */
@@ -20,6 +20,7 @@ extern CrmOrch *gCrmOrch;
 extern Directory<Orch*> gDirectory;
 
 extern size_t gMaxBulkSize;
+extern size_t gNextHopGroupPoolSize;
 
 /* Default maximum number of next hop groups */
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
@@ -36,7 +37,8 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
         m_vrfOrch(vrfOrch),
         m_fgNhgOrch(fgNhgOrch),
         m_nextHopGroupCount(0),
-        m_resync(false)
+        m_resync(false),
+        m_bulkNhgCreation(false)
 {
     SWSS_LOG_ENTER();
 
@@ -427,6 +429,7 @@ void RouteOrch::doTask(Consumer& consumer)
         >                                       toBulk;
 
         // Add or remove routes with a route bulker
+        m_bulkNhgCreation = true;
         while (it != consumer.m_toSync.end())
         {
             KeyOpFieldsValuesTuple t = it->second;
@@ -700,7 +703,8 @@ void RouteOrch::doTask(Consumer& consumer)
 
                 // If already exhaust the nexthop groups, and there are pending removing routes in bulker,
                 // flush the bulker and possibly collect some released nexthop groups
-                if (m_nextHopGroupCount >= m_maxNextHopGroupCount && gRouteBulker.removing_entries_count() > 0)
+                if (m_nextHopGroupCount + (int)m_bulkNhgsToCreate.size() >= m_maxNextHopGroupCount &&
+                    gRouteBulker.removing_entries_count() > 0)
                 {
                     break;
                 }
@@ -719,6 +723,25 @@ void RouteOrch::doTask(Consumer& consumer)
             }
         }
 
+        m_bulkNhgCreation = false;
+
+        // Create the next hop groups deferred above at once, and add the routes using them
+        if (!m_bulkNhgsToCreate.empty())
+        {
+            addNextHopGroups(m_bulkNhgsToCreate);
+            m_bulkNhgsToCreate.clear();
+
+            for (auto& it_bulk : toBulk)
+            {
+                auto& ctx = it_bulk.second;
+                if (ctx.nhg_deferred)
+                {
+                    ctx.nhg_deferred = false;
+                    addRoute(ctx, ctx.nhg);
+                }
+            }
+        }
+
         // Flush the route bulker, so routes will be written to syncd and ASIC
         gRouteBulker.flush();
 
@@ -806,6 +829,8 @@ void RouteOrch::doTask(Consumer& consumer)
             }
         }
     }
+
+    refillNextHopGroupPool();
 }
 
 void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPrefix &prefix, const NextHopGroupKey &nexthops, bool add)
@@ -1013,161 +1038,333 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
 {
     SWSS_LOG_ENTER();
 
-    assert(!hasNextHopGroup(nexthops));
+    return addNextHopGroups({ nexthops });
+}
 
-    if (m_nextHopGroupCount >= m_maxNextHopGroupCount)
+/*
+ * Create a batch of next hop groups. Group objects are taken from the pool
+ * or created one by one, since SAI has no bulk API for them, and then the
+ * members of all groups are created with a single bulk call.
+ * Return false if any of the groups is not created and needs a retry.
+ */
+bool RouteOrch::addNextHopGroups(const std::set<NextHopGroupKey> &nhgs)
+{
+    SWSS_LOG_ENTER();
+
+    struct NextHopGroupCreateContext
     {
-        SWSS_LOG_DEBUG("Failed to create new next hop group. \
-                        Reaching maximum number of next hop groups.");
-        return false;
-    }
+        NextHopGroupKey                                 nexthops;
+        vector<sai_object_id_t>                         next_hop_ids;
+        std::map<sai_object_id_t, NextHopKey>           nhopgroup_members_set;
+        std::map<sai_object_id_t, set<NextHopKey>>      nhopgroup_shared_set;
+        sai_object_id_t                                 next_hop_group_id;
+        vector<sai_object_id_t>                         nhgm_ids;
+    };
 
-    vector<sai_object_id_t> next_hop_ids;
-    set<NextHopKey> next_hop_set = nexthops.getNextHops();
-    std::map<sai_object_id_t, NextHopKey> nhopgroup_members_set;
-    std::map<sai_object_id_t, set<NextHopKey>> nhopgroup_shared_set;
+    bool success = true;
+    std::deque<NextHopGroupCreateContext> nhg_ctxs;
 
-    /* Assert each IP address exists in m_syncdNextHops table,
-     * and add the corresponding next_hop_id to next_hop_ids. */
-    for (auto it : next_hop_set)
+    for (const auto &nexthops : nhgs)
     {
-        sai_object_id_t next_hop_id;
-        if (m_neighOrch->hasNextHop(it))
-        {
-            next_hop_id = m_neighOrch->getNextHopId(it);
-        }
-        /* See if there is an IP neighbor NH for MPLS NH*/
-        else if (it.isMplsNextHop() &&
-                 m_neighOrch->hasNextHop(NextHopKey(it.ip_address, it.alias)))
+        assert(!hasNextHopGroup(nexthops));
+
+        if (m_nextHopGroupCount >= m_maxNextHopGroupCount)
         {
-            m_neighOrch->addNextHop(it);
-            next_hop_id = m_neighOrch->getNextHopId(it);
+            SWSS_LOG_DEBUG("Failed to create new next hop group. \
+                            Reaching maximum number of next hop groups.");
+            success = false;
+            break;
         }
-        else
+
+        nhg_ctxs.emplace_back();
+        auto &nhg_ctx = nhg_ctxs.back();
+        nhg_ctx.nexthops = nexthops;
+
+        set<NextHopKey> next_hop_set = nexthops.getNextHops();
+        bool resolved = true;
+
+        /* Assert each IP address exists in m_syncdNextHops table,
+         * and add the corresponding next_hop_id to next_hop_ids. */
+        for (auto it : next_hop_set)
         {
-            SWSS_LOG_INFO("Failed to get next hop %s in %s",
-                    it.to_string().c_str(), nexthops.to_string().c_str());
-            return false;
+            sai_object_id_t next_hop_id;
+            if (m_neighOrch->hasNextHop(it))
+            {
+                next_hop_id = m_neighOrch->getNextHopId(it);
+            }
+            /* See if there is an IP neighbor NH for MPLS NH*/
+            else if (it.isMplsNextHop() &&
+                     m_neighOrch->hasNextHop(NextHopKey(it.ip_address, it.alias)))
+            {
+                m_neighOrch->addNextHop(it);
+                next_hop_id = m_neighOrch->getNextHopId(it);
+            }
+            else
+            {
+                SWSS_LOG_INFO("Failed to get next hop %s in %s",
+                        it.to_string().c_str(), nexthops.to_string().c_str());
+                resolved = false;
+                break;
+            }
+
+            // skip next hop group member create for neighbor from down port
+            if (m_neighOrch->isNextHopFlagSet(it, NHFLAGS_IFDOWN))
+            {
+                continue;
+            }
+
+            nhg_ctx.next_hop_ids.push_back(next_hop_id);
+            if (nhg_ctx.nhopgroup_members_set.find(next_hop_id) == nhg_ctx.nhopgroup_members_set.end())
+            {
+                nhg_ctx.nhopgroup_members_set[next_hop_id] = it;
+            }
+            else
+            {
+                nhg_ctx.nhopgroup_shared_set[next_hop_id].insert(it);
+            }
         }
 
-        // skip next hop group member create for neighbor from down port
-        if (m_neighOrch->isNextHopFlagSet(it, NHFLAGS_IFDOWN))
+        if (!resolved)
         {
+            nhg_ctxs.pop_back();
+            success = false;
             continue;
         }
 
-        next_hop_ids.push_back(next_hop_id);
-        if (nhopgroup_members_set.find(next_hop_id) == nhopgroup_members_set.end())
+        sai_status_t status = allocNextHopGroupId(nhg_ctx.next_hop_group_id);
+        if (status != SAI_STATUS_SUCCESS)
         {
-            nhopgroup_members_set[next_hop_id] = it;
+            SWSS_LOG_ERROR("Failed to create next hop group %s, rv:%d",
+                           nexthops.to_string().c_str(), status);
+            nhg_ctxs.pop_back();
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
+            if (handle_status != task_success)
+            {
+                success &= parseHandleSaiStatusFailure(handle_status);
+            }
+            continue;
         }
-        else
+
+        m_nextHopGroupCount ++;
+        SWSS_LOG_NOTICE("Create next hop group %s", nexthops.to_string().c_str());
+
+        size_t npid_count = nhg_ctx.next_hop_ids.size();
+        nhg_ctx.nhgm_ids.resize(npid_count);
+        for (size_t i = 0; i < npid_count; i++)
         {
-            nhopgroup_shared_set[next_hop_id].insert(it);
-        }
-    }
+            auto nhid = nhg_ctx.next_hop_ids[i];
 
-    sai_attribute_t nhg_attr;
-    vector<sai_attribute_t> nhg_attrs;
+            // Create a next hop group member
+            vector<sai_attribute_t> nhgm_attrs;
 
-    nhg_attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
-    nhg_attr.value.s32 = SAI_NEXT_HOP_GROUP_TYPE_ECMP;
-    nhg_attrs.push_back(nhg_attr);
+            sai_attribute_t nhgm_attr;
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+            nhgm_attr.value.oid = nhg_ctx.next_hop_group_id;
+            nhgm_attrs.push_back(nhgm_attr);
 
-    sai_object_id_t next_hop_group_id;
-    sai_status_t status = sai_next_hop_group_api->create_next_hop_group(&next_hop_group_id,
-                                                                        gSwitchId,
-                                                                        (uint32_t)nhg_attrs.size(),
-                                                                        nhg_attrs.data());
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+            nhgm_attr.value.oid = nhid;
+            nhgm_attrs.push_back(nhgm_attr);
 
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to create next hop group %s, rv:%d",
-                       nexthops.to_string().c_str(), status);
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
-        if (handle_status != task_success)
-        {
-            return parseHandleSaiStatusFailure(handle_status);
+            gNextHopGroupMemberBulker.create_entry(&nhg_ctx.nhgm_ids[i],
+                                                     (uint32_t)nhgm_attrs.size(),
+                                                     nhgm_attrs.data());
         }
     }
 
-    m_nextHopGroupCount ++;
-    SWSS_LOG_NOTICE("Create next hop group %s", nexthops.to_string().c_str());
-
-    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+    /* Members of all the groups are created at once */
+    gNextHopGroupMemberBulker.flush();
 
-    NextHopGroupEntry next_hop_group_entry;
-    next_hop_group_entry.next_hop_group_id = next_hop_group_id;
+    vector<sai_object_id_t> failed_nhgm_ids;
+    vector<sai_object_id_t> failed_nhg_ids;
 
-    size_t npid_count = next_hop_ids.size();
-    vector<sai_object_id_t> nhgm_ids(npid_count);
-    for (size_t i = 0; i < npid_count; i++)
+    for (auto &nhg_ctx : nhg_ctxs)
     {
-        auto nhid = next_hop_ids[i];
+        const NextHopGroupKey &nexthops = nhg_ctx.nexthops;
+        NextHopGroupEntry next_hop_group_entry;
+        next_hop_group_entry.next_hop_group_id = nhg_ctx.next_hop_group_id;
 
-        // Create a next hop group member
-        vector<sai_attribute_t> nhgm_attrs;
+        bool members_created = true;
+        for (size_t i = 0; i < nhg_ctx.nhgm_ids.size(); i++)
+        {
+            if (nhg_ctx.nhgm_ids[i] == SAI_NULL_OBJECT_ID)
+            {
+                SWSS_LOG_ERROR("Failed to create next hop group %" PRIx64 " member for next hop %" PRIx64,
+                               nhg_ctx.next_hop_group_id, nhg_ctx.next_hop_ids[i]);
+                members_created = false;
+            }
+        }
 
-        sai_attribute_t nhgm_attr;
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
+        if (!members_created)
+        {
+            /* Clean up the members created and the group itself, the group is retried */
+            for (auto nhgm_id : nhg_ctx.nhgm_ids)
+            {
+                if (nhgm_id != SAI_NULL_OBJECT_ID)
+                {
+                    failed_nhgm_ids.push_back(nhgm_id);
+                }
+            }
+            failed_nhg_ids.push_back(nhg_ctx.next_hop_group_id);
+            success = false;
+            continue;
+        }
 
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = nhid;
-        nhgm_attrs.push_back(nhgm_attr);
+        for (size_t i = 0; i < nhg_ctx.nhgm_ids.size(); i++)
+        {
+            auto nhid = nhg_ctx.next_hop_ids[i];
+            auto nhgm_id = nhg_ctx.nhgm_ids[i];
+
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
 
-        gNextHopGroupMemberBulker.create_entry(&nhgm_ids[i],
-                                                 (uint32_t)nhgm_attrs.size(),
-                                                 nhgm_attrs.data());
+            // Save the membership into next hop structure
+            auto &nhopgroup_shared_set = nhg_ctx.nhopgroup_shared_set;
+            if (nhopgroup_shared_set.find(nhid) != nhopgroup_shared_set.end())
+            {
+                auto it = nhopgroup_shared_set[nhid].begin();
+                next_hop_group_entry.nhopgroup_members[*it] = nhgm_id;
+                nhopgroup_shared_set[nhid].erase(it);
+                if (nhopgroup_shared_set[nhid].empty())
+                {
+                    nhopgroup_shared_set.erase(nhid);
+                }
+            }
+            else
+            {
+                next_hop_group_entry.nhopgroup_members[nhg_ctx.nhopgroup_members_set.find(nhid)->second] = nhgm_id;
+            }
+        }
+
+        /* Increment the ref_count for the next hops used by the next hop group. */
+        for (auto it : nexthops.getNextHops())
+            m_neighOrch->increaseNextHopRefCount(it);
+
+        /*
+         * Initialize the next hop group structure with ref_count as 0. This
+         * count will increase once the route is successfully syncd.
+         */
+        next_hop_group_entry.ref_count = 0;
+        m_syncdNextHopGroups[nexthops] = next_hop_group_entry;
     }
 
-    gNextHopGroupMemberBulker.flush();
-    for (size_t i = 0; i < npid_count; i++)
+    if (!failed_nhg_ids.empty())
     {
-        auto nhid = next_hop_ids[i];
-        auto nhgm_id = nhgm_ids[i];
-        if (nhgm_id == SAI_NULL_OBJECT_ID)
+        vector<sai_status_t> statuses(failed_nhgm_ids.size());
+        for (size_t i = 0; i < failed_nhgm_ids.size(); i++)
         {
-            // TODO: do we need to clean up?
-            SWSS_LOG_ERROR("Failed to create next hop group %" PRIx64 " member %" PRIx64 ": %d\n",
-                           next_hop_group_id, nhgm_ids[i], status);
-            return false;
+            gNextHopGroupMemberBulker.remove_entry(&statuses[i], failed_nhgm_ids[i]);
         }
-
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-
-        // Save the membership into next hop structure
-        if (nhopgroup_shared_set.find(nhid) != nhopgroup_shared_set.end())
+        gNextHopGroupMemberBulker.flush();
+        for (size_t i = 0; i < failed_nhgm_ids.size(); i++)
         {
-            auto it = nhopgroup_shared_set[nhid].begin();
-            next_hop_group_entry.nhopgroup_members[*it] = nhgm_id;
-            nhopgroup_shared_set[nhid].erase(it);
-            if (nhopgroup_shared_set[nhid].empty())
+            if (statuses[i] != SAI_STATUS_SUCCESS)
             {
-                nhopgroup_shared_set.erase(nhid);
+                SWSS_LOG_ERROR("Failed to remove next hop group member %" PRIx64 ", rv:%d",
+                               failed_nhgm_ids[i], statuses[i]);
             }
         }
-        else
+
+        for (auto next_hop_group_id : failed_nhg_ids)
         {
-            next_hop_group_entry.nhopgroup_members[nhopgroup_members_set.find(nhid)->second] = nhgm_id;
+            sai_status_t status = releaseNextHopGroupId(next_hop_group_id);
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove next hop group %" PRIx64 ", rv:%d", next_hop_group_id, status);
+            }
+            m_nextHopGroupCount --;
         }
     }
 
-    /* Increment the ref_count for the next hops used by the next hop group. */
-    for (auto it : next_hop_set)
-        m_neighOrch->increaseNextHopRefCount(it);
+    return success;
+}
 
-    /*
-     * Initialize the next hop group structure with ref_count as 0. This
-     * count will increase once the route is successfully syncd.
-     */
-    next_hop_group_entry.ref_count = 0;
-    m_syncdNextHopGroups[nexthops] = next_hop_group_entry;
+/* Check if all next hops of the group can be used to create its members */
+bool RouteOrch::hasResolvedNextHops(const NextHopGroupKey &nexthops)
+{
+    for (const auto &nh : nexthops.getNextHops())
+    {
+        if (!m_neighOrch->hasNextHop(nh) &&
+            !(nh.isMplsNextHop() && m_neighOrch->hasNextHop(NextHopKey(nh.ip_address, nh.alias))))
+        {
+            return false;
+        }
+    }
 
     return true;
 }
 
+/* Take a next hop group object from the pool, or create a new one */
+sai_status_t RouteOrch::allocNextHopGroupId(sai_object_id_t &next_hop_group_id)
+{
+    if (!m_nextHopGroupPool.empty())
+    {
+        next_hop_group_id = m_nextHopGroupPool.back();
+        m_nextHopGroupPool.pop_back();
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_attribute_t nhg_attr;
+    nhg_attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+    nhg_attr.value.s32 = SAI_NEXT_HOP_GROUP_TYPE_ECMP;
+
+    sai_status_t status = sai_next_hop_group_api->create_next_hop_group(&next_hop_group_id,
+                                                                        gSwitchId, 1, &nhg_attr);
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+    }
+
+    return status;
+}
+
+/* Return a next hop group object without members to the pool, or remove it */
+sai_status_t RouteOrch::releaseNextHopGroupId(sai_object_id_t next_hop_group_id)
+{
+    if (m_nextHopGroupPool.size() < gNextHopGroupPoolSize)
+    {
+        m_nextHopGroupPool.push_back(next_hop_group_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+    }
+
+    return status;
+}
+
+/*
+ * Pre-create empty next hop groups up to the configured pool size, so new
+ * ECMP groups don't wait for the group object creation. Pooled groups are
+ * ASIC resources, so they are left out of the space for new groups.
+ */
+void RouteOrch::refillNextHopGroupPool()
+{
+    SWSS_LOG_ENTER();
+
+    while (m_nextHopGroupPool.size() < gNextHopGroupPoolSize &&
+           m_nextHopGroupCount + (int)m_nextHopGroupPool.size() < m_maxNextHopGroupCount)
+    {
+        sai_attribute_t nhg_attr;
+        nhg_attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+        nhg_attr.value.s32 = SAI_NEXT_HOP_GROUP_TYPE_ECMP;
+
+        sai_object_id_t next_hop_group_id;
+        sai_status_t status = sai_next_hop_group_api->create_next_hop_group(&next_hop_group_id,
+                                                                            gSwitchId, 1, &nhg_attr);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_WARN("Failed to pre-create next hop group, rv:%d", status);
+            break;
+        }
+
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
+        m_nextHopGroupPool.push_back(next_hop_group_id);
+    }
+}
+
 bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
 {
     SWSS_LOG_ENTER();
@@ -1226,7 +1423,7 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
     }
 
-    status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
+    status = releaseNextHopGroupId(next_hop_group_id);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to remove next hop group %" PRIx64 ", rv:%d", next_hop_group_id, status);
@@ -1238,7 +1435,6 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
     }
 
     m_nextHopGroupCount --;
-    gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
 
     set<NextHopKey> next_hop_set = nexthops.getNextHops();
     for (auto it : next_hop_set)
@@ -1476,6 +1672,17 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
         /* Check if there is already an existing next hop group */
         if (!hasNextHopGroup(nextHops))
         {
+            /* Defer the new next hop group to be created with the others of this bulk */
+            if (m_bulkNhgCreation && !overlay_nh &&
+                (m_bulkNhgsToCreate.find(nextHops) != m_bulkNhgsToCreate.end() ||
+                 (m_nextHopGroupCount + (int)m_bulkNhgsToCreate.size() < m_maxNextHopGroupCount &&
+                  hasResolvedNextHops(nextHops))))
+            {
+                m_bulkNhgsToCreate.insert(nextHops);
+                ctx.nhg_deferred = true;
+                return false;
+            }
+
             /* Try to create a new next hop group */
             if (!addNextHopGroup(nextHops))
             {
@@ -71,9 +71,10 @@ struct RouteBulkContext
     sai_object_id_t                     vrf_id;
     IpPrefix                            ip_prefix;
     bool                                excp_intfs_flag;
+    bool                                nhg_deferred;       // Waiting for the bulk creation of its next hop group
 
     RouteBulkContext()
-        : excp_intfs_flag(false)
+        : excp_intfs_flag(false), nhg_deferred(false)
     {
     }
 
@@ -87,6 +88,7 @@ struct RouteBulkContext
         tmp_next_hop.clear();
         nhg.clear();
         excp_intfs_flag = false;
+        nhg_deferred = false;
         vrf_id = SAI_NULL_OBJECT_ID;
     }
 };
@@ -136,6 +138,7 @@ public:
     bool isRefCounterZero(const NextHopGroupKey&) const;
 
     bool addNextHopGroup(const NextHopGroupKey&);
+    bool addNextHopGroups(const std::set<NextHopGroupKey>&);
     bool removeNextHopGroup(const NextHopGroupKey&);
 
     bool updateNextHopRoutes(const NextHopKey&, uint32_t&);
@@ -170,6 +173,13 @@ private:
     std::set<std::pair<NextHopGroupKey, sai_object_id_t>> m_bulkNhgReducedRefCnt;
     /* m_bulkNhgReducedRefCnt: nexthop, vrf_id */
 
+    bool m_bulkNhgCreation;
+    std::set<NextHopGroupKey> m_bulkNhgsToCreate;
+    /* m_bulkNhgsToCreate: next hop groups deferred by routes of the current bulk */
+
+    std::vector<sai_object_id_t> m_nextHopGroupPool;
+    /* m_nextHopGroupPool: pre-created next hop groups without members */
+
     NextHopObserverTable m_nextHopObservers;
 
     EntityBulker<sai_route_api_t>           gRouteBulker;
@@ -188,6 +198,11 @@ private:
     bool addLabelRoutePost(const LabelRouteBulkContext& ctx, const NextHopGroupKey &nextHops);
     bool removeLabelRoutePost(const LabelRouteBulkContext& ctx);
 
+    bool hasResolvedNextHops(const NextHopGroupKey&);
+    sai_status_t allocNextHopGroupId(sai_object_id_t &next_hop_group_id);
+    sai_status_t releaseNextHopGroupId(sai_object_id_t next_hop_group_id);
+    void refillNextHopGroupPool();
+
     std::string getLinkLocalEui64Addr(void);
     void        addLinkLocalRouteToMe(sai_object_id_t vrf_id, IpPrefix linklocal_prefix);
 
@@ -0,0 +1,349 @@
+#include <stdlib.h>
+#include <algorithm>
+#include <unordered_set>
+#include "schema.h"
+#include "logger.h"
+#include "watermarkaggregator.h"
+#include "counters_db_reply.h"
+#include "flex_counter_config.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+bool isNativeWatermarkMode(const string &flexCounterKey)
+{
+    SWSS_LOG_ENTER();
+
+    string mode;
+    return getFlexCounterField(flexCounterKey, WATERMARK_MODE_FIELD, mode) && mode == WATERMARK_MODE_NATIVE;
+}
+
+WatermarkAggregator::WatermarkAggregator(DBConnector *countersDb, const string &flexCounterKey,
+        const vector<string> &stats, uint32_t pollInterval):
+    m_countersDb(countersDb),
+    m_stats(stats),
+    m_pollInterval(pollInterval),
+    m_counters(stats.size()),
+    m_counterValid(stats.size()),
+    m_watermarks(WM_TABLE_COUNT, vector<Watermarks>(stats.size()))
+{
+    m_tableNames.resize(WM_TABLE_COUNT);
+    m_tableNames[WM_USER] = USER_WATERMARKS_TABLE;
+    m_tableNames[WM_PERSISTENT] = PERSISTENT_WATERMARKS_TABLE;
+    m_tableNames[WM_PERIODIC] = PERIODIC_WATERMARKS_TABLE;
+
+    setPollInterval(pollInterval);
+
+    if (isCounterSnapshotEnabled(flexCounterKey))
+    {
+        m_snapshot.reset(new CounterSnapshotReader(getCounterSnapshotName(flexCounterKey)));
+    }
+}
+
+void WatermarkAggregator::setPollInterval(uint32_t pollInterval)
+{
+    m_pollInterval = milliseconds(pollInterval);
+
+    for (auto &tableWatermarks : m_watermarks)
+    {
+        for (auto &watermarks : tableWatermarks)
+        {
+            watermarks.clearSamples.setHold(m_pollInterval);
+        }
+    }
+}
+
+void WatermarkAggregator::setObjects(const vector<string> &objectIds)
+{
+    unordered_set<string> ids(objectIds.begin(), objectIds.end());
+
+    for (size_t slot = 0; slot < m_slots.size(); slot++)
+    {
+        if (m_slots.used(slot) && ids.find(m_slots.objectId(slot)) == ids.end())
+        {
+            removeObject(string(m_slots.objectId(slot)));
+        }
+    }
+
+    for (const auto &objectId : objectIds)
+    {
+        addObject(objectId);
+    }
+}
+
+void WatermarkAggregator::addObject(const string &objectId)
+{
+    size_t slot;
+    if (!m_slots.add(objectId, slot))
+    {
+        return;
+    }
+
+    if (slot == m_seeded.size())
+    {
+        m_seeded.push_back(0);
+        for (size_t s = 0; s < m_stats.size(); s++)
+        {
+            m_counters[s].push_back(0);
+            m_counterValid[s].push_back(0);
+            for (auto &watermarks : m_watermarks)
+            {
+                watermarks[s].value.push_back(0);
+                watermarks[s].published.push_back(0);
+                watermarks[s].cleared.push_back(0);
+                watermarks[s].clearedCounter.push_back(0);
+            }
+        }
+    }
+
+    // The last watermarks are read from the tables on the next poll
+    m_seeded[slot] = 0;
+    for (auto &watermarks : m_watermarks)
+    {
+        for (auto &statWatermarks : watermarks)
+        {
+            statWatermarks.cleared[slot] = 0;
+        }
+    }
+}
+
+void WatermarkAggregator::removeObject(const string &objectId)
+{
+    size_t slot;
+    if (!m_slots.remove(objectId, slot))
+    {
+        return;
+    }
+
+    for (size_t s = 0; s < m_stats.size(); s++)
+    {
+        m_counterValid[s][slot] = 0;
+    }
+}
+
+void WatermarkAggregator::clear(const string &tableName, const string &stat, const vector<string> &objectIds)
+{
+    auto table = find(m_tableNames.begin(), m_tableNames.end(), tableName);
+    auto statIt = find(m_stats.begin(), m_stats.end(), stat);
+    if (table == m_tableNames.end() || statIt == m_stats.end())
+    {
+        return;
+    }
+
+    // The samples read so far predate the clear, fold them into the other tables first
+    poll();
+
+    size_t s = statIt - m_stats.begin();
+    Watermarks &watermarks = m_watermarks[table - m_tableNames.begin()][s];
+    auto now = steady_clock::now();
+    for (const auto &objectId : objectIds)
+    {
+        size_t slot;
+        if (m_slots.find(objectId, slot))
+        {
+            // The caller writes the zero to the table
+            watermarks.value[slot] = 0;
+            watermarks.published[slot] = 1;
+            watermarks.cleared[slot] = 1;
+            watermarks.clearedCounter[slot] = m_counters[s][slot];
+            watermarks.clearSamples.skip(slot, now);
+        }
+    }
+}
+
+void WatermarkAggregator::poll()
+{
+    if (m_slots.count() == 0)
+    {
+        return;
+    }
+
+    read();
+    reduce(steady_clock::now());
+    write();
+}
+
+/*
+ * Read the new watermarks of all objects in one round trip, along with the
+ * last watermarks of the objects added since the previous poll. The new
+ * watermarks found in the snapshot are not requested.
+ */
+void WatermarkAggregator::read()
+{
+    redisContext *ctx = m_countersDb->getContext();
+
+    vector<const char *> argv = { "HMGET", nullptr };
+    for (const auto &stat : m_stats)
+    {
+        argv.push_back(stat.c_str());
+    }
+
+    if (m_snapshot)
+    {
+        m_snapshot->refresh();
+    }
+
+    vector<uint64_t> values(m_stats.size());
+    vector<uint8_t> pending(m_slots.size());
+    string key;
+    for (size_t slot = 0; slot < m_slots.size(); slot++)
+    {
+        if (!m_slots.used(slot))
+        {
+            continue;
+        }
+
+        if (m_snapshot && m_snapshot->read(m_slots.objectId(slot), m_stats, values.data()))
+        {
+            for (size_t s = 0; s < m_stats.size(); s++)
+            {
+                m_counters[s][slot] = values[s];
+                m_counterValid[s][slot] = 1;
+            }
+        }
+        else
+        {
+            pending[slot] = 1;
+            key = string(COUNTERS_TABLE) + ":" + m_slots.objectId(slot);
+            argv[1] = key.c_str();
+            redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr);
+        }
+
+        for (size_t t = 0; !m_seeded[slot] && t < WM_TABLE_COUNT; t++)
+        {
+            key = m_tableNames[t] + ":" + m_slots.objectId(slot);
+            argv[1] = key.c_str();
+            redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr);
+        }
+    }
+
+    for (size_t slot = 0; slot < m_slots.size(); slot++)
+    {
+        if (!m_slots.used(slot))
+        {
+            continue;
+        }
+
+        if (pending[slot])
+        {
+            CountersDbReplyPtr reply = getCountersDbReply(ctx);
+            for (size_t s = 0; s < m_stats.size(); s++)
+            {
+                m_counterValid[s][slot] = getCountersDbCounter(reply.get(), s, m_counters[s][slot]);
+            }
+        }
+
+        if (m_seeded[slot])
+        {
+            continue;
+        }
+
+        for (size_t t = 0; t < WM_TABLE_COUNT; t++)
+        {
+            CountersDbReplyPtr last = getCountersDbReply(ctx);
+            for (size_t s = 0; s < m_stats.size(); s++)
+            {
+                Watermarks &watermarks = m_watermarks[t][s];
+                uint64_t value = 0;
+                // Missing watermarks are written once the counter is available
+                watermarks.published[slot] = getCountersDbCounter(last.get(), s, value);
+                watermarks.value[slot] = value;
+            }
+        }
+        m_seeded[slot] = 1;
+    }
+}
+
+// Fold the new watermarks into the three tables, for all objects at once
+void WatermarkAggregator::reduce(steady_clock::time_point now)
+{
+    size_t count = m_slots.size();
+    vector<uint8_t> fold(count);
+
+    for (size_t s = 0; s < m_stats.size(); s++)
+    {
+        const uint64_t *counter = m_counters[s].data();
+        const uint8_t *valid = m_counterValid[s].data();
+
+        for (auto &tableWatermarks : m_watermarks)
+        {
+            Watermarks &watermarks = tableWatermarks[s];
+            uint64_t *value = watermarks.value.data();
+            uint8_t *published = watermarks.published.data();
+
+            for (size_t slot = 0; slot < count; slot++)
+            {
+                fold[slot] = valid[slot];
+                if (watermarks.cleared[slot] && valid[slot])
+                {
+                    fold[slot] = watermarks.clearSamples.take(slot, counter[slot] == watermarks.clearedCounter[slot], now);
+                    watermarks.cleared[slot] = !fold[slot];
+                }
+            }
+
+            for (size_t slot = 0; slot < count; slot++)
+            {
+                uint64_t max = fold[slot] ? std::max(value[slot], counter[slot]) : value[slot];
+                published[slot] = published[slot] & (max == value[slot]);
+                value[slot] = max;
+            }
+        }
+    }
+}
+
+// Write the watermarks that changed in one pipelined batch
+void WatermarkAggregator::write()
+{
+    redisContext *ctx = m_countersDb->getContext();
+
+    vector<string> args;
+    vector<const char *> argv;
+    size_t pending = 0;
+
+    for (size_t t = 0; t < WM_TABLE_COUNT; t++)
+    {
+        for (size_t slot = 0; slot < m_slots.size(); slot++)
+        {
+            if (!m_slots.used(slot))
+            {
+                continue;
+            }
+
+            args.clear();
+            for (size_t s = 0; s < m_stats.size(); s++)
+            {
+                Watermarks &watermarks = m_watermarks[t][s];
+                if (watermarks.published[slot] || !m_counterValid[s][slot])
+                {
+                    continue;
+                }
+
+                args.push_back(m_stats[s]);
+                args.push_back(to_string(watermarks.value[slot]));
+                watermarks.published[slot] = 1;
+            }
+
+            if (args.empty())
+            {
+                continue;
+            }
+
+            args.insert(args.begin(), { "HMSET", m_tableNames[t] + ":" + m_slots.objectId(slot) });
+
+            argv.clear();
+            for (const auto &arg : args)
+            {
+                argv.push_back(arg.c_str());
+            }
+
+            redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr);
+            pending++;
+        }
+    }
+
+    while (pending--)
+    {
+        getCountersDbReply(ctx);
+    }
+}
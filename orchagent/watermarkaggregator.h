@@ -0,0 +1,108 @@
+#ifndef WATERMARKAGGREGATOR_H
+#define WATERMARKAGGREGATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "dbconnector.h"
+#include "counter_slots.h"
+#include "counter_snapshot.h"
+
+// FLEX_COUNTER|QUEUE_WATERMARK, PG_WATERMARK and BUFFER_POOL_WATERMARK field
+// selecting how the watermark tables are updated, read when orchagent starts
+#define WATERMARK_MODE_FIELD    "WATERMARK_MODE"
+#define WATERMARK_MODE_PLUGIN   "plugin"
+#define WATERMARK_MODE_NATIVE   "native"
+
+// Returns true if the watermarks of the flex counter key are aggregated in
+// orchagent instead of the watermark_*.lua plugins.
+bool isNativeWatermarkMode(const std::string &flexCounterKey);
+
+/*
+ * WatermarkAggregator updates the user, persistent and periodic watermarks
+ * of a watermark group in process, as the watermark_*.lua plugins do server
+ * side after every flex counter poll.
+ *
+ * The three watermarks of each object and stat are kept in contiguous
+ * arrays. Each poll reads the COUNTERS of all objects from the counter
+ * snapshot of the group if it is enabled, and the others in one pipelined
+ * round trip, applies the max reduction to all objects at once and writes
+ * the watermarks that changed in one pipelined batch.
+ *
+ * A cleared watermark ignores the COUNTERS read at the clear, by a
+ * SampleFilter holding them for one poll interval of the group.
+ */
+class WatermarkAggregator
+{
+public:
+    // flexCounterKey is the watermark group, e.g. QUEUE_WATERMARK
+    WatermarkAggregator(swss::DBConnector *countersDb, const std::string &flexCounterKey,
+            const std::vector<std::string> &stats, uint32_t pollInterval);
+
+    WatermarkAggregator(const WatermarkAggregator&) = delete;
+    WatermarkAggregator& operator=(const WatermarkAggregator&) = delete;
+
+    // Adds the objects not aggregated yet and removes the ones not in objectIds
+    void setObjects(const std::vector<std::string> &objectIds);
+    size_t size() const
+    {
+        return m_slots.count();
+    }
+
+    void poll();
+
+    // Flex counter poll interval of the group, in milliseconds
+    void setPollInterval(uint32_t pollInterval);
+
+    // Zeroes a watermark of the objects in memory, the caller clears the table
+    // once it returns
+    void clear(const std::string &tableName, const std::string &stat, const std::vector<std::string> &objectIds);
+
+private:
+    enum WatermarkTable
+    {
+        WM_USER,
+        WM_PERSISTENT,
+        WM_PERIODIC,
+        WM_TABLE_COUNT
+    };
+
+    struct Watermarks
+    {
+        // Indexed by slot
+        std::vector<uint64_t> value;
+        std::vector<uint8_t> published;
+        // COUNTERS when the watermark was cleared, not folded in again
+        std::vector<uint8_t> cleared;
+        std::vector<uint64_t> clearedCounter;
+        SampleFilter clearSamples;
+    };
+
+    void addObject(const std::string &objectId);
+    void removeObject(const std::string &objectId);
+
+    void read();
+    void reduce(std::chrono::steady_clock::time_point now);
+    void write();
+
+    swss::DBConnector *m_countersDb;
+    std::vector<std::string> m_stats;
+    std::vector<std::string> m_tableNames;
+    std::chrono::milliseconds m_pollInterval;
+    std::unique_ptr<CounterSnapshotReader> m_snapshot;
+
+    // Objects, indexed by slot
+    CounterSlots m_slots;
+    std::vector<uint8_t> m_seeded;
+
+    // Per stat arrays, indexed by slot
+    std::vector<std::vector<uint64_t>> m_counters;
+    std::vector<std::vector<uint8_t>> m_counterValid;
+
+    // Indexed by table and stat
+    std::vector<std::vector<Watermarks>> m_watermarks;
+};
+
+#endif // WATERMARKAGGREGATOR_H
@@ -31,6 +31,7 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_periodicWatermarkTable = make_shared<Table>(m_countersDb.get(), PERIODIC_WATERMARKS_TABLE);
     m_persistentWatermarkTable = make_shared<Table>(m_countersDb.get(), PERSISTENT_WATERMARKS_TABLE);
     m_userWatermarkTable = make_shared<Table>(m_countersDb.get(), USER_WATERMARKS_TABLE);
+    m_countersPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_countersDb.get()));
 
     m_clearNotificationConsumer = new swss::NotificationConsumer(
             m_appDb.get(),
@@ -42,6 +43,41 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_telemetryTimer = new SelectableTimer(intervT);
     auto executorT = new ExecutableTimer(m_telemetryTimer, this, "WM_TELEMETRY_TIMER");
     Orch::addExecutor(executorT);
+
+    if (isNativeWatermarkMode("QUEUE_WATERMARK"))
+    {
+        uint32_t pollInterval = to_uint<uint32_t>(QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
+        m_queueWmAggregator = unique_ptr<WatermarkAggregator>(new WatermarkAggregator(m_countersDb.get(), "QUEUE_WATERMARK",
+                { "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES" }, pollInterval));
+        m_nativeWmPollIntervals["QUEUE_WATERMARK"] = pollInterval;
+    }
+
+    if (isNativeWatermarkMode("PG_WATERMARK"))
+    {
+        uint32_t pollInterval = to_uint<uint32_t>(PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
+        m_pgWmAggregator = unique_ptr<WatermarkAggregator>(new WatermarkAggregator(m_countersDb.get(), "PG_WATERMARK",
+                { "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
+                  "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES" }, pollInterval));
+        m_nativeWmPollIntervals["PG_WATERMARK"] = pollInterval;
+    }
+
+    if (isNativeWatermarkMode("BUFFER_POOL_WATERMARK"))
+    {
+        uint32_t pollInterval = to_uint<uint32_t>(BUFFER_POOL_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
+        m_bufferPoolWmAggregator = unique_ptr<WatermarkAggregator>(new WatermarkAggregator(m_countersDb.get(), "BUFFER_POOL_WATERMARK",
+                { "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
+                  "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES" }, pollInterval));
+        m_nativeWmPollIntervals["BUFFER_POOL_WATERMARK"] = pollInterval;
+    }
+
+    if (!m_nativeWmPollIntervals.empty())
+    {
+        m_wmAggregationTimer = new SelectableTimer(getAggregationInterval());
+        auto aggregationExecutorT = new ExecutableTimer(m_wmAggregationTimer, this, "WM_AGGREGATION_TIMER");
+        Orch::addExecutor(aggregationExecutorT);
+        m_wmAggregationTimer->start();
+        SWSS_LOG_NOTICE("Watermarks of %zu flex counter groups are aggregated in orchagent", m_nativeWmPollIntervals.size());
+    }
 }
 
 WatermarkOrch::~WatermarkOrch()
@@ -117,6 +153,22 @@ void WatermarkOrch::handleFcConfigUpdate(const std::string &key, const std::vect
 {
     SWSS_LOG_ENTER();
     uint8_t prevStatus = m_wmStatus;
+
+    auto nativeIt = m_nativeWmPollIntervals.find(key);
+    if (nativeIt != m_nativeWmPollIntervals.end())
+    {
+        for (const auto &i: fvt)
+        {
+            if (i.first == POLL_INTERVAL_FIELD)
+            {
+                nativeIt->second = to_uint<uint32_t>(i.second);
+                getWmAggregator(key)->setPollInterval(nativeIt->second);
+                m_wmAggregationTimer->setInterval(getAggregationInterval());
+                m_wmAggregationTimer->reset();
+            }
+        }
+    }
+
     if (key == "QUEUE_WATERMARK" || key == "PG_WATERMARK")
     {
         for (std::pair<std::basic_string<char>, std::basic_string<char> > i: fvt)
@@ -234,6 +286,12 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_wmAggregationTimer)
+    {
+        pollNativeWatermarks();
+        return;
+    }
+
     if (m_pg_ids.empty())
     {
         init_pg_ids();
@@ -326,12 +384,13 @@ void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_objec
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), obj_ids.size());
 
-    vector<FieldValueTuple> vfvt = {{wm_name, "0"}};
-
+    vector<string> ids;
     for (sai_object_id_t id: obj_ids)
     {
-        table->set(sai_serialize_object_id(id), vfvt);
+        ids.push_back(sai_serialize_object_id(id));
     }
+
+    clearWm(table, wm_name, ids);
 }
 
 void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const object_reference_map &nameOidMap)
@@ -339,10 +398,131 @@ void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const object_ref
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), nameOidMap.size());
 
-    vector<FieldValueTuple> fvTuples = {{wm_name, "0"}};
-
+    vector<string> ids;
     for (const auto &it : nameOidMap)
     {
-        table->set(sai_serialize_object_id(it.second.m_saiObjectId), fvTuples);
+        ids.push_back(sai_serialize_object_id(it.second.m_saiObjectId));
+    }
+
+    clearWm(table, wm_name, ids);
+}
+
+void WatermarkOrch::clearWm(Table *table, const string &wm_name, const vector<string> &obj_ids)
+{
+    SWSS_LOG_ENTER();
+
+    /* The aggregators publish their pending watermarks before the table is cleared */
+    for (auto aggregator: { m_queueWmAggregator.get(), m_pgWmAggregator.get(), m_bufferPoolWmAggregator.get() })
+    {
+        if (aggregator)
+        {
+            aggregator->clear(table->getTableName(), wm_name, obj_ids);
+        }
+    }
+
+    /* Clear all objects with one pipelined batch */
+    Table pipelinedTable(m_countersPipeline.get(), table->getTableName(), true);
+    vector<FieldValueTuple> vfvt = {{wm_name, "0"}};
+
+    for (const auto &id: obj_ids)
+    {
+        pipelinedTable.set(id, vfvt);
+    }
+    pipelinedTable.flush();
+}
+
+WatermarkAggregator *WatermarkOrch::getWmAggregator(const string &flexCounterKey) const
+{
+    if (flexCounterKey == "QUEUE_WATERMARK")
+    {
+        return m_queueWmAggregator.get();
+    }
+    if (flexCounterKey == "PG_WATERMARK")
+    {
+        return m_pgWmAggregator.get();
+    }
+    return m_bufferPoolWmAggregator.get();
+}
+
+timespec WatermarkOrch::getAggregationInterval() const
+{
+    /*
+     * Flex counters overwrite the new watermarks in COUNTERS on every poll,
+     * they are read twice per poll interval of the fastest group to not miss any
+     */
+    uint32_t interval = UINT32_MAX;
+    for (const auto &it: m_nativeWmPollIntervals)
+    {
+        interval = min(interval, it.second);
+    }
+    interval = max(interval / 2, 1u);
+
+    return timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 };
+}
+
+void WatermarkOrch::pollNativeWatermarks()
+{
+    SWSS_LOG_ENTER();
+
+    if (!gPortsOrch->allPortsReady())
+    {
+        return;
+    }
+
+    if (m_queueWmAggregator)
+    {
+        if (m_multicast_queue_ids.empty() and m_unicast_queue_ids.empty() and m_all_queue_ids.empty())
+        {
+            init_queue_ids();
+        }
+
+        size_t count = m_unicast_queue_ids.size() + m_multicast_queue_ids.size() + m_all_queue_ids.size();
+        if (m_queueWmAggregator->size() != count)
+        {
+            vector<string> ids;
+            for (const auto queue_ids: { &m_unicast_queue_ids, &m_multicast_queue_ids, &m_all_queue_ids })
+            {
+                for (sai_object_id_t id: *queue_ids)
+                {
+                    ids.push_back(sai_serialize_object_id(id));
+                }
+            }
+            m_queueWmAggregator->setObjects(ids);
+        }
+
+        m_queueWmAggregator->poll();
+    }
+
+    if (m_pgWmAggregator)
+    {
+        if (m_pg_ids.empty())
+        {
+            init_pg_ids();
+        }
+
+        if (m_pgWmAggregator->size() != m_pg_ids.size())
+        {
+            vector<string> ids;
+            for (sai_object_id_t id: m_pg_ids)
+            {
+                ids.push_back(sai_serialize_object_id(id));
+            }
+            m_pgWmAggregator->setObjects(ids);
+        }
+
+        m_pgWmAggregator->poll();
+    }
+
+    if (m_bufferPoolWmAggregator)
+    {
+        /* Buffer pools come and go with the buffer configuration */
+        vector<string> ids;
+        for (const auto &it : gBufferOrch->getBufferPoolNameOidMap())
+        {
+            ids.push_back(sai_serialize_object_id(it.second.m_saiObjectId));
+        }
+        m_bufferPoolWmAggregator->setObjects(ids);
+
+        m_bufferPoolWmAggregator->poll();
     }
 }
@@ -2,9 +2,11 @@
 #define WATERMARKORCH_H
 
 #include <map>
+#include <memory>
 
 #include "orch.h"
 #include "port.h"
+#include "watermarkaggregator.h"
 
 #include "notificationconsumer.h"
 #include "timer.h"
@@ -37,6 +39,8 @@ public:
     void clearSingleWm(swss::Table *table, std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
     void clearSingleWm(swss::Table *table, std::string wm_name, const object_reference_map &nameOidMap);
 
+    void pollNativeWatermarks();
+
     std::shared_ptr<swss::Table> getCountersTable(void)
     {
         return m_countersTable;
@@ -48,6 +52,10 @@ public:
     }
 
 private:
+    void clearWm(swss::Table *table, const std::string &wm_name, const std::vector<std::string> &obj_ids);
+    WatermarkAggregator *getWmAggregator(const std::string &flexCounterKey) const;
+    timespec getAggregationInterval() const;
+
     /*
     [7-2] - unused
     [1] - pg wm status
@@ -62,6 +70,7 @@ private:
     std::shared_ptr<swss::Table> m_periodicWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_persistentWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_userWatermarkTable = nullptr;
+    std::unique_ptr<swss::RedisPipeline> m_countersPipeline;
 
     swss::NotificationConsumer* m_clearNotificationConsumer = nullptr;
     swss::SelectableTimer* m_telemetryTimer = nullptr;
@@ -70,6 +79,13 @@ private:
     std::vector<sai_object_id_t> m_multicast_queue_ids;
     std::vector<sai_object_id_t> m_all_queue_ids;
     std::vector<sai_object_id_t> m_pg_ids;
+
+    /* Watermark groups aggregated in orchagent instead of the lua plugins */
+    std::unique_ptr<WatermarkAggregator> m_queueWmAggregator;
+    std::unique_ptr<WatermarkAggregator> m_pgWmAggregator;
+    std::unique_ptr<WatermarkAggregator> m_bufferPoolWmAggregator;
+    std::map<std::string, uint32_t> m_nativeWmPollIntervals;
+    swss::SelectableTimer* m_wmAggregationTimer = nullptr;
 };
 
 #endif // WATERMARKORCH_H
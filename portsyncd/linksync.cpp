@@ -4,22 +4,21 @@
 #include <sys/socket.h>
 #include <linux/if.h>
 #include <netlink/route/link.h>
+#include <netlink/msg.h>
+#include <algorithm>
 #include "logger.h"
 #include "netmsg.h"
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "tokenize.h"
-#include "exec.h"
 
 #include "linkcache.h"
 #include "portsyncd/linksync.h"
 #include "warm_restart.h"
-#include "shellcmd.h"
 
 #include <iostream>
 #include <set>
 #include <sstream>
-#include <iomanip>
 
 using namespace std;
 using namespace swss;
@@ -34,67 +33,89 @@ const string LAG_PREFIX = "PortChannel";
 extern set<string> g_portSet;
 extern bool g_init;
 
-struct if_nameindex
-{
-    unsigned int if_index;
-    char *if_name;
-};
-extern "C" { extern struct if_nameindex *if_nameindex (void) __THROW; }
+/* Number of RTM_SETLINK requests sent before their acks are collected */
+#define SETLINK_BATCH_SIZE 64
 
 LinkSync::LinkSync(DBConnector *appl_db, DBConnector *state_db) :
     m_portTableProducer(appl_db, APP_PORT_TABLE_NAME),
     m_portTable(appl_db, APP_PORT_TABLE_NAME),
-    m_statePortTable(state_db, STATE_PORT_TABLE_NAME),
-    m_stateMgmtPortTable(state_db, STATE_MGMT_PORT_TABLE_NAME)
+    m_statePipeline(state_db),
+    m_statePortTable(&m_statePipeline, STATE_PORT_TABLE_NAME, true),
+    m_stateMgmtPortTable(&m_statePipeline, STATE_MGMT_PORT_TABLE_NAME, true)
 {
-    struct if_nameindex *if_ni, *idx_p;
-    if_ni = if_nameindex();
+    struct nl_sock *sock = nl_socket_alloc();
+    struct nl_cache *linkCache = NULL;
+    vector<pair<int, string>> oldIntfs;
+    int err;
+
+    if (!sock)
+    {
+        throw system_error(make_error_code(errc::not_enough_memory), "Unable to allocate netlink socket");
+    }
+
+    if ((err = nl_connect(sock, NETLINK_ROUTE)) < 0)
+    {
+        nl_socket_free(sock);
+        throw system_error(make_error_code(errc::address_not_available),
+                string("Unable to connect netlink socket: ") + nl_geterror(err));
+    }
 
-    for (idx_p = if_ni;
-            idx_p != NULL && idx_p->if_index != 0 && idx_p->if_name != NULL;
-            idx_p++)
+    /* A single RTM_GETLINK dump returns all kernel interfaces */
+    if ((err = rtnl_link_alloc_cache(sock, AF_UNSPEC, &linkCache)) < 0)
     {
-        string key = idx_p->if_name;
+        nl_socket_free(sock);
+        throw system_error(make_error_code(errc::address_not_available),
+                string("Unable to dump kernel interfaces: ") + nl_geterror(err));
+    }
+
+    for (struct nl_object *obj = nl_cache_get_first(linkCache); obj; obj = nl_cache_get_next(obj))
+    {
+        struct rtnl_link *link = (struct rtnl_link *)obj;
+        const char *name = rtnl_link_get_name(link);
+        if (!name)
+        {
+            continue;
+        }
+        string key = name;
 
         /* Explicitly store management ports oper status into the state database.
          * This piece of information is used by SNMP. */
         if (!key.compare(0, MGMT_PREFIX.length(), MGMT_PREFIX))
         {
-            ostringstream cmd;
-            string res;
-            cmd << "cat /sys/class/net/" << shellquote(key) << "/operstate";
-            try
-            {
-                EXEC_WITH_ERROR_THROW(cmd.str(), res);
-            }
-            catch (...)
-            {
-                SWSS_LOG_WARN("Failed to get %s oper status", key.c_str());
-                continue;
-            }
+            char operStr[32] = {0};
+            string res = rtnl_link_operstate2str(rtnl_link_get_operstate(link), operStr, sizeof(operStr));
 
-            /* Remove the trailing newline */
-            if (res.length() >= 1 && res.at(res.length() - 1) == '\n')
+            /* The value of operstate will be either up or down */
+            if (res != "up" && res != "down")
             {
-                res.erase(res.length() - 1);
-                /* The value of operstate will be either up or down */
-                if (res != "up" && res != "down")
-                {
-                    SWSS_LOG_WARN("Unknown %s oper status %s",
-                            key.c_str(), res.c_str());
-                }
-                FieldValueTuple fv("oper_status", res);
-                vector<FieldValueTuple> fvs;
-                fvs.push_back(fv);
-
-                m_stateMgmtPortTable.set(key, fvs);
-                SWSS_LOG_INFO("Store %s oper status %s to state DB",
+                SWSS_LOG_WARN("Unknown %s oper status %s",
                         key.c_str(), res.c_str());
             }
+            FieldValueTuple fv("oper_status", res);
+            vector<FieldValueTuple> fvs;
+            fvs.push_back(fv);
+
+            m_stateMgmtPortTable.set(key, fvs);
+            SWSS_LOG_INFO("Store %s oper status %s to state DB",
+                    key.c_str(), res.c_str());
             continue;
         }
+
+        /* Collect the existing front panel kernel interfaces */
+        if (!key.compare(0, INTFS_PREFIX.length(), INTFS_PREFIX))
+        {
+            int ifindex = rtnl_link_get_ifindex(link);
+
+            m_ifindexOldNameMap[ifindex] = key;
+            if (rtnl_link_get_flags(link) & IFF_UP)
+            {
+                oldIntfs.emplace_back(ifindex, key);
+            }
+        }
     }
 
+    nl_cache_free(linkCache);
+
     if (!WarmStart::isWarmStart())
     {
         /* See the comments for g_portSet in portsyncd.cpp */
@@ -121,36 +142,76 @@ LinkSync::LinkSync(DBConnector *appl_db, DBConnector *state_db) :
             }
         }
 
-        for (idx_p = if_ni;
-                idx_p != NULL && idx_p->if_index != 0 && idx_p->if_name != NULL;
-                idx_p++)
+        /* Bring down the existing kernel interfaces */
+        bringDownInterfaces(sock, oldIntfs);
+    }
+    else
+    {
+        m_ifindexOldNameMap.clear();
+    }
+
+    nl_socket_free(sock);
+
+    m_statePipeline.flush();
+}
+
+/*
+ * Clear IFF_UP on the interfaces with RTM_SETLINK requests. The requests are
+ * sent back to back and their acks are collected per batch, instead of one
+ * "ip link set down" process per interface.
+ */
+void LinkSync::bringDownInterfaces(struct nl_sock *sock, const vector<pair<int, string>> &intfs)
+{
+    /* Acks are matched to the requests by their order */
+    nl_socket_disable_seq_check(sock);
+
+    for (size_t start = 0; start < intfs.size(); start += SETLINK_BATCH_SIZE)
+    {
+        size_t end = min(intfs.size(), start + SETLINK_BATCH_SIZE);
+        vector<size_t> sent;
+
+        for (size_t i = start; i < end; i++)
         {
-            string key = idx_p->if_name;
+            struct ifinfomsg ifi;
+            memset(&ifi, 0, sizeof(ifi));
+            ifi.ifi_family = AF_UNSPEC;
+            ifi.ifi_index = intfs[i].first;
+            ifi.ifi_change = IFF_UP;
+            ifi.ifi_flags = 0;
+
+            SWSS_LOG_INFO("Bring down old interface %s(%d)", intfs[i].second.c_str(), intfs[i].first);
 
-            /* Skip all non-frontpanel ports */
-            if (key.compare(0, INTFS_PREFIX.length(), INTFS_PREFIX))
+            struct nl_msg *msg = nlmsg_alloc_simple(RTM_SETLINK, NLM_F_REQUEST | NLM_F_ACK);
+            if (!msg || nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO) < 0 || nl_send_auto(sock, msg) < 0)
             {
-                continue;
+                /* Ignore error in this flow ; */
+                SWSS_LOG_WARN("Failed to bring down old interface %s(%d)", intfs[i].second.c_str(), intfs[i].first);
             }
-
-            m_ifindexOldNameMap[idx_p->if_index] = key;
-
-            ostringstream cmd;
-            string res;
-            /* Bring down the existing kernel interfaces */
-            SWSS_LOG_INFO("Bring down old interface %s(%d)", key.c_str(), idx_p->if_index);
-            cmd << "ip link set " << quoted(key) << " down";
-            try
+            else
             {
-                swss::exec(cmd.str(), res);
+                sent.push_back(i);
             }
-            catch (...)
+            nlmsg_free(msg);
+        }
+
+        for (auto i : sent)
+        {
+            int err = nl_wait_for_ack(sock);
+            if (err < 0)
             {
                 /* Ignore error in this flow ; */
-                SWSS_LOG_WARN("Failed to bring down old interface %s(%d)", key.c_str(), idx_p->if_index);
+                SWSS_LOG_WARN("Failed to bring down old interface %s(%d): %s",
+                        intfs[i].second.c_str(), intfs[i].first, nl_geterror(err));
             }
         }
     }
+
+    SWSS_LOG_NOTICE("Brought down %zu old interfaces", intfs.size());
+}
+
+void LinkSync::flush()
+{
+    m_statePipeline.flush();
 }
 
 void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
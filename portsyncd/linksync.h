@@ -6,6 +6,8 @@
 #include "netmsg.h"
 
 #include <map>
+#include <string>
+#include <vector>
 
 namespace swss {
 
@@ -18,9 +20,17 @@ public:
 
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
+    /* Write the buffered STATE_DB updates */
+    void flush();
+
 private:
+    void bringDownInterfaces(struct nl_sock *sock, const std::vector<std::pair<int, std::string>> &intfs);
+
     ProducerStateTable m_portTableProducer;
-    Table m_portTable, m_statePortTable, m_stateMgmtPortTable;
+    Table m_portTable;
+    RedisPipeline m_statePipeline;
+    /* Buffered on m_statePipeline */
+    Table m_statePortTable, m_stateMgmtPortTable;
 
     std::map<unsigned int, std::string> m_ifindexNameMap;
     std::map<unsigned int, std::string> m_ifindexOldNameMap;
@@ -124,6 +124,9 @@ int main(int argc, char **argv)
 
             if (temps == static_cast<Selectable*>(&netlink))
             {
+                /* Write the port states of this batch of netlink messages */
+                sync.flush();
+
                 /* on netlink message, check if PortInitDone should be sent out */
                 if (!g_init && g_portSet.empty())
                 {
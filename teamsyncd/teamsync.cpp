@@ -5,6 +5,8 @@
 #include <linux/if.h>
 #include <netlink/route/link.h>
 #include <chrono>
+#include <algorithm>
+#include <inttypes.h>
 #include "logger.h"
 #include "netmsg.h"
 #include "dbconnector.h"
@@ -23,9 +25,12 @@ using namespace swss;
 
 TeamSync::TeamSync(DBConnector *db, DBConnector *stateDb, Select *select) :
     m_select(select),
-    m_lagTable(db, APP_LAG_TABLE_NAME),
-    m_lagMemberTable(db, APP_LAG_MEMBER_TABLE_NAME),
-    m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME)
+    m_appPipeline(db),
+    m_lagTable(&m_appPipeline, APP_LAG_TABLE_NAME, true),
+    m_lagMemberTable(&m_appPipeline, APP_LAG_MEMBER_TABLE_NAME, true),
+    m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME),
+    m_stateLagSyncStatsTable(stateDb, STATE_LAG_SYNC_STATS_TABLE_NAME),
+    m_lagSyncStatsTime(steady_clock::now())
 {
     WarmStart::initialize(TEAMSYNCD_APP_NAME, "teamd");
     WarmStart::checkWarmStart(TEAMSYNCD_APP_NAME, "teamd");
@@ -57,6 +62,70 @@ void TeamSync::periodic()
     }
 
     doSelectableTask();
+    doLagMemberTask();
+    writeLagSyncStats();
+}
+
+void TeamSync::doLagMemberTask()
+{
+    vector<string> updatedLags;
+
+    for (const auto &it : m_teamSelectables)
+    {
+        if (!it.second->hasPendingChanges())
+            continue;
+
+        if (it.second->syncMembers() > 0)
+            updatedLags.push_back(it.first);
+    }
+
+    /* Write LAG and LAG member updates of this iteration at once */
+    m_lagMemberTable.flush();
+
+    auto now = steady_clock::now();
+    for (const auto &lagName : updatedLags)
+    {
+        auto latency = (uint64_t)duration_cast<microseconds>(
+                now - m_teamSelectables[lagName]->getChangeTime()).count();
+        auto &stats = m_lagSyncStats[lagName];
+
+        stats.updates++;
+        stats.lastLatencyUs = latency;
+        stats.maxLatencyUs = max(stats.maxLatencyUs, latency);
+        stats.totalLatencyUs += latency;
+        m_lagSyncStatsToWrite.insert(lagName);
+
+        SWSS_LOG_INFO("LAG %s members updated in %" PRIu64 " us", lagName.c_str(), latency);
+    }
+}
+
+void TeamSync::writeLagSyncStats()
+{
+    if (m_lagSyncStatsToWrite.empty())
+        return;
+
+    auto now = steady_clock::now();
+    if (duration_cast<seconds>(now - m_lagSyncStatsTime).count() < LAG_SYNC_STATS_INTERVAL)
+        return;
+
+    m_lagSyncStatsTime = now;
+
+    for (const auto &lagName : m_lagSyncStatsToWrite)
+    {
+        auto it = m_lagSyncStats.find(lagName);
+        if (it == m_lagSyncStats.end())
+            continue;
+
+        const auto &stats = it->second;
+        vector<FieldValueTuple> fvVector;
+        fvVector.emplace_back("updates", to_string(stats.updates));
+        fvVector.emplace_back("last_latency_us", to_string(stats.lastLatencyUs));
+        fvVector.emplace_back("max_latency_us", to_string(stats.maxLatencyUs));
+        fvVector.emplace_back("avg_latency_us", to_string(stats.totalLatencyUs / stats.updates));
+        m_stateLagSyncStatsTable.set(lagName, fvVector);
+    }
+
+    m_lagSyncStatsToWrite.clear();
 }
 
 void TeamSync::doSelectableTask()
@@ -85,6 +154,7 @@ void TeamSync::applyState()
 
     m_lagTable.apply_temp_view();
     m_lagMemberTable.apply_temp_view();
+    m_lagTable.flush();
 
     for(auto &it: m_stateLagTablePreserved)
     {
@@ -152,10 +222,17 @@ void TeamSync::addLag(const string &lagName, int ifindex, bool admin_state,
     fvVector.push_back(a);
     fvVector.push_back(o);
     fvVector.push_back(m);
-    m_lagTable.set(lagName, fvVector);
 
-    SWSS_LOG_INFO("Add %s admin_status:%s oper_status:%s, mtu: %d",
-                   lagName.c_str(), admin_state ? "up" : "down", oper_state ? "up" : "down", mtu);
+    /* The kernel notifies the team device on every member change, skip unchanged LAGs */
+    auto state = m_lagStates.find(lagName);
+    if (state == m_lagStates.end() || state->second != fvVector)
+    {
+        m_lagTable.set(lagName, fvVector);
+        m_lagStates[lagName] = fvVector;
+
+        SWSS_LOG_INFO("Add %s admin_status:%s oper_status:%s, mtu: %d",
+                       lagName.c_str(), admin_state ? "up" : "down", oper_state ? "up" : "down", mtu);
+    }
 
     /* Return when the team instance has already been tracked */
     if (m_teamSelectables.find(lagName) != m_teamSelectables.end())
@@ -193,6 +270,7 @@ void TeamSync::removeLag(const string &lagName)
 
     /* Delete the LAG */
     m_lagTable.del(lagName);
+    m_lagStates.erase(lagName);
 
     SWSS_LOG_INFO("Remove LAG %s", lagName.c_str());
 
@@ -209,6 +287,10 @@ void TeamSync::removeLag(const string &lagName)
         m_stateLagTable.del(lagName);
     }
 
+    m_stateLagSyncStatsTable.del(lagName);
+    m_lagSyncStats.erase(lagName);
+    m_lagSyncStatsToWrite.erase(lagName);
+
     m_selectablesToRemove.insert(lagName);
 }
 
@@ -222,6 +304,7 @@ void TeamSync::cleanTeamSync()
         /* Cleanup LAG */
         removeLag(it.first);
     }
+    m_lagTable.flush();
     return;
 }
 
@@ -234,7 +317,8 @@ TeamSync::TeamPortSync::TeamPortSync(const string &lagName, int ifindex,
                                      ProducerStateTable *lagMemberTable) :
     m_lagMemberTable(lagMemberTable),
     m_lagName(lagName),
-    m_ifindex(ifindex)
+    m_ifindex(ifindex),
+    m_pending(false)
 {
     int count = 0;
     int max_retries = 3;
@@ -287,7 +371,7 @@ TeamSync::TeamPortSync::TeamPortSync(const string &lagName, int ifindex,
     }
 
     /* Sync LAG at first */
-    onChange();
+    syncMembers();
 }
 
 TeamSync::TeamPortSync::~TeamPortSync()
@@ -299,10 +383,27 @@ TeamSync::TeamPortSync::~TeamPortSync()
     }
 }
 
+/*
+ * libteam may call the handler several times while processing one batch
+ * of events, the members are compared once per select iteration instead.
+ */
 int TeamSync::TeamPortSync::onChange()
+{
+    if (!m_pending)
+    {
+        m_pending = true;
+        m_changeTime = steady_clock::now();
+    }
+    return 0;
+}
+
+int TeamSync::TeamPortSync::syncMembers()
 {
     struct team_port *port;
     map<string, bool> tmp_lag_members;
+    int updates = 0;
+
+    m_pending = false;
 
     /* Check each port  */
     team_for_each_port(port, m_team)
@@ -340,6 +441,7 @@ int TeamSync::TeamPortSync::onChange()
             FieldValueTuple l("status", it.second ? "enabled" : "disabled");
             v.push_back(l);
             m_lagMemberTable->set(key, v);
+            updates++;
 
             SWSS_LOG_INFO("Set LAG %s member %s with status %s",
                     m_lagName.c_str(), it.first.c_str(), it.second ? "enabled" : "disabled");
@@ -352,6 +454,7 @@ int TeamSync::TeamPortSync::onChange()
         {
             string key = m_lagName + ":" + it.first;
             m_lagMemberTable->del(key);
+            updates++;
 
             SWSS_LOG_INFO("Remove member %s from LAG %s",
                     it.first.c_str(), m_lagName.c_str());
@@ -359,8 +462,8 @@ int TeamSync::TeamPortSync::onChange()
     }
 
     /* Replace the old LAG members with the new ones */
-    m_lagMembers = tmp_lag_members;
-    return 0;
+    m_lagMembers = std::move(tmp_lag_members);
+    return updates;
 }
 
 int TeamSync::TeamPortSync::teamdHandler(struct team_handle *team, void *arg,
@@ -2,8 +2,10 @@
 #define __TEAMSYNC__
 
 #include <map>
+#include <set>
 #include <string>
 #include <memory>
+#include <chrono>
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "selectable.h"
@@ -14,6 +16,11 @@
 #define TEAMSYNCD_APP_NAME  "teamsyncd"
 // seconds
 const uint32_t DEFAULT_WR_PENDING_TIMEOUT = 70;
+// seconds, minimal interval between writes of the LAG update statistics
+const uint32_t LAG_SYNC_STATS_INTERVAL = 1;
+
+/* STATE_DB table with the per LAG member update statistics */
+#define STATE_LAG_SYNC_STATS_TABLE_NAME "LAG_SYNC_STATS"
 
 using namespace std::chrono;
 
@@ -41,7 +48,25 @@ public:
         int getFd() override;
         uint64_t readData() override;
 
-        /* member_name -> enabled|disabled */
+        /* Team events were received since the last syncMembers() */
+        bool hasPendingChanges() const
+        {
+            return m_pending;
+        }
+
+        /* Time of the first team event since the last syncMembers() */
+        steady_clock::time_point getChangeTime() const
+        {
+            return m_changeTime;
+        }
+
+        /*
+         * Compare the team ports with the last written member states and
+         * write only the differences. Returns the number of written members.
+         */
+        int syncMembers();
+
+        /* member_name -> enabled|disabled, as last written to APP_DB */
         std::map<std::string, bool> m_lagMembers;
     protected:
         int onChange();
@@ -53,6 +78,17 @@ public:
         struct team_handle *m_team;
         std::string m_lagName;
         int m_ifindex;
+        bool m_pending;
+        steady_clock::time_point m_changeTime;
+    };
+
+    /* Latency from a team event to the APP_DB write of the resulting member updates */
+    struct LagSyncStats
+    {
+        uint64_t updates = 0;
+        uint64_t lastLatencyUs = 0;
+        uint64_t maxLatencyUs = 0;
+        uint64_t totalLatencyUs = 0;
     };
 
 protected:
@@ -66,11 +102,26 @@ protected:
     /* Handle all selectables add/removal events */
     void doSelectableTask();
 
+    /* Write member changes of all LAGs with pending team events as one batch */
+    void doLagMemberTask();
+
+    void writeLagSyncStats();
+
 private:
     Select *m_select;
+    RedisPipeline m_appPipeline;
+    /* Both buffered on m_appPipeline, flushed once per select iteration */
     ProducerStateTable m_lagTable;
     ProducerStateTable m_lagMemberTable;
     Table m_stateLagTable;
+    Table m_stateLagSyncStatsTable;
+
+    /* lag_name -> admin_status, oper_status, mtu as last written to APP_DB */
+    std::map<std::string, std::vector<FieldValueTuple>> m_lagStates;
+
+    std::map<std::string, LagSyncStats> m_lagSyncStats;
+    std::set<std::string> m_lagSyncStatsToWrite;
+    steady_clock::time_point m_lagSyncStatsTime;
 
     bool m_warmstart;
     std::unordered_map<std::string, std::vector<FieldValueTuple>> m_stateLagTablePreserved;
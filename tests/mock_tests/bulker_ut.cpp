@@ -106,4 +106,92 @@ namespace bulker_test
         ASSERT_EQ(ia->first.id, SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION);
         ASSERT_EQ(ia->first.value.s32, SAI_PACKET_ACTION_FORWARD);
     }
+
+    vector<pair<sai_object_id_t, sai_attr_id_t>> port_attribute_sets;
+
+    sai_status_t _ut_set_port_attribute(sai_object_id_t port_id, const sai_attribute_t *attr)
+    {
+        port_attribute_sets.emplace_back(port_id, attr->id);
+        return attr->id == SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP ? SAI_STATUS_FAILURE : SAI_STATUS_SUCCESS;
+    }
+
+    TEST_F(BulkerTest, ObjectBulkerSetAttribute)
+    {
+        sai_port_api_t port_api = {};
+        port_api.set_port_attribute = _ut_set_port_attribute;
+        port_attribute_sets.clear();
+
+        ObjectBulker<sai_port_api_t> portBulker(&port_api, 0x0, 1000);
+        deque<sai_status_t> object_statuses;
+
+        sai_attribute_t port_attr;
+        port_attr.id = SAI_PORT_ATTR_QOS_TC_TO_QUEUE_MAP;
+        port_attr.value.oid = SAI_NULL_OBJECT_ID;
+        object_statuses.emplace_back();
+        portBulker.set_entry_attribute(&object_statuses.back(), 0x1, &port_attr);
+
+        port_attr.id = SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP;
+        object_statuses.emplace_back();
+        portBulker.set_entry_attribute(&object_statuses.back(), 0x1, &port_attr);
+
+        // Nothing is set until the flush
+        ASSERT_EQ(portBulker.setting_entries_count(), 1);
+        ASSERT_TRUE(port_attribute_sets.empty());
+        ASSERT_EQ(object_statuses[0], SAI_STATUS_NOT_EXECUTED);
+
+        portBulker.flush();
+
+        // Attributes are set in order, each with its own status
+        ASSERT_EQ(port_attribute_sets.size(), 2);
+        ASSERT_EQ(port_attribute_sets[0].second, SAI_PORT_ATTR_QOS_TC_TO_QUEUE_MAP);
+        ASSERT_EQ(port_attribute_sets[1].second, SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP);
+        ASSERT_EQ(object_statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(object_statuses[1], SAI_STATUS_FAILURE);
+        ASSERT_EQ(portBulker.setting_entries_count(), 0);
+    }
+
+    const sai_object_id_t nhgm_id = 0x1000;
+
+    sai_status_t _ut_create_next_hop_group_members(sai_object_id_t switch_id, uint32_t object_count,
+            const uint32_t *attr_count, const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode,
+            sai_object_id_t *object_id, sai_status_t *object_statuses)
+    {
+        // The second member fails, the ones after it are not executed
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_id[i] = i == 0 ? nhgm_id : SAI_NULL_OBJECT_ID;
+            object_statuses[i] = i == 0 ? SAI_STATUS_SUCCESS :
+                (i == 1 ? SAI_STATUS_INSUFFICIENT_RESOURCES : SAI_STATUS_NOT_EXECUTED);
+        }
+        return SAI_STATUS_FAILURE;
+    }
+
+    TEST_F(BulkerTest, ObjectBulkerCreateStatus)
+    {
+        sai_next_hop_group_api_t nhg_api = {};
+        nhg_api.create_next_hop_group_members = _ut_create_next_hop_group_members;
+
+        ObjectBulker<sai_next_hop_group_api_t> nhgmBulker(&nhg_api, 0x0, 1000);
+        vector<sai_object_id_t> object_ids(3);
+        vector<sai_status_t> object_statuses(2);
+
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = 0x1;
+        nhgmBulker.create_entry(&object_ids[0], &object_statuses[0], 1, &nhgm_attr);
+        nhgmBulker.create_entry(&object_ids[1], &object_statuses[1], 1, &nhgm_attr);
+        // Entries created without a status are still supported
+        nhgmBulker.create_entry(&object_ids[2], 1, &nhgm_attr);
+        ASSERT_EQ(object_statuses[0], SAI_STATUS_NOT_EXECUTED);
+
+        nhgmBulker.flush();
+
+        ASSERT_EQ(object_ids[0], nhgm_id);
+        ASSERT_EQ(object_statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(object_ids[1], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(object_statuses[1], SAI_STATUS_INSUFFICIENT_RESOURCES);
+        ASSERT_EQ(object_ids[2], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhgmBulker.creating_entries_count(), 0);
+        ASSERT_TRUE(nhgmBulker.creating_statuses.empty());
+    }
 }
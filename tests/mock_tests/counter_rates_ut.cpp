@@ -0,0 +1,54 @@
+#include "ut_helper.h"
+
+namespace counter_rates_test
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const string objectId = "oid:0x1";
+
+    TEST(CounterRatesTest, SmoothedRates)
+    {
+        CounterRates rates(nullptr, "PORT", {
+            { "RX_BPS", { "SAI_PORT_STAT_IF_IN_OCTETS" } },
+            { "RX_PPS", { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS" } },
+        });
+        rates.addObject(objectId);
+
+        const double alpha = 0.5;
+        auto start = steady_clock::now();
+        auto sample = [&](int second, const vector<uint64_t> &counters)
+        {
+            Portal::CounterRatesInternal::sample(rates, objectId, counters, alpha, start + seconds(second));
+        };
+        auto bps = [&]() { return Portal::CounterRatesInternal::getRate(rates, objectId, 0); };
+        auto pps = [&]() { return Portal::CounterRatesInternal::getRate(rates, objectId, 1); };
+
+        // First sample only saves the counters, the first rates are not smoothed
+        sample(0, { 0, 0, 0 });
+        sample(1, { 1000, 10, 10 });
+        ASSERT_DOUBLE_EQ(bps(), 1);
+        ASSERT_DOUBLE_EQ(pps(), 0.02);
+
+        // A sample not refreshed by syncd is skipped once
+        sample(2, { 1000, 10, 10 });
+        ASSERT_DOUBLE_EQ(bps(), 1);
+
+        // Rates are per millisecond over the time since the last sample, as in port_rates.lua
+        sample(3, { 4000, 30, 30 });
+        ASSERT_DOUBLE_EQ(bps(), 1.25);
+        ASSERT_DOUBLE_EQ(pps(), 0.02);
+
+        // Counters unchanged on the next sample give a zero rate
+        sample(4, { 4000, 30, 30 });
+        ASSERT_DOUBLE_EQ(bps(), 1.25);
+        sample(5, { 4000, 30, 30 });
+        ASSERT_DOUBLE_EQ(bps(), 0.625);
+        ASSERT_DOUBLE_EQ(pps(), 0.01);
+
+        // Cleared counters give a zero rate
+        sample(6, { 0, 0, 0 });
+        ASSERT_DOUBLE_EQ(bps(), 0.3125);
+        ASSERT_DOUBLE_EQ(pps(), 0.005);
+    }
+}
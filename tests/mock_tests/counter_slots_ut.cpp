@@ -0,0 +1,51 @@
+#include "ut_helper.h"
+
+namespace counter_slots_test
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    TEST(CounterSlotsTest, ReuseSlots)
+    {
+        CounterSlots slots;
+        size_t slot1, slot2, slot;
+
+        ASSERT_TRUE(slots.add("oid:0x1", slot1));
+        ASSERT_TRUE(slots.add("oid:0x2", slot2));
+        ASSERT_FALSE(slots.add("oid:0x1", slot));
+        ASSERT_EQ(slot, slot1);
+        ASSERT_EQ(slots.count(), 2);
+
+        ASSERT_TRUE(slots.remove("oid:0x1", slot));
+        ASSERT_EQ(slot, slot1);
+        ASSERT_FALSE(slots.used(slot1));
+        ASSERT_TRUE(slots.objectId(slot1).empty());
+        ASSERT_FALSE(slots.remove("oid:0x1", slot));
+
+        // Removed slots are reused before the arrays grow
+        ASSERT_EQ(slots.allocate(), slot1);
+        ASSERT_EQ(slots.size(), 2);
+        ASSERT_TRUE(slots.find("oid:0x2", slot));
+        ASSERT_EQ(slot, slot2);
+        ASSERT_FALSE(slots.find("oid:0x1", slot));
+    }
+
+    TEST(CounterSlotsTest, SkipUnchangedSample)
+    {
+        SampleFilter samples;
+
+        ASSERT_TRUE(samples.take(0, false));
+        // Skipped once, then taken
+        ASSERT_FALSE(samples.take(0, true));
+        ASSERT_TRUE(samples.take(0, true));
+        ASSERT_FALSE(samples.take(0, true));
+        ASSERT_TRUE(samples.take(0, false));
+
+        // Held from the skip for the hold
+        auto start = steady_clock::now();
+        samples.setHold(seconds(10));
+        samples.skip(1, start);
+        ASSERT_FALSE(samples.take(1, true, start + seconds(5)));
+        ASSERT_TRUE(samples.take(1, true, start + seconds(10)));
+    }
+}
@@ -0,0 +1,95 @@
+#include "ut_helper.h"
+#include "counter_snapshot.h"
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+namespace counter_snapshot_test
+{
+    using namespace std;
+
+    const string snapshotName = "/swss_counters_UT";
+
+    TEST(CounterSnapshotTest, ReadWrittenCounters)
+    {
+        CounterSnapshotReader reader(snapshotName);
+        uint64_t values[2];
+
+        // No producer yet
+        reader.refresh();
+        ASSERT_FALSE(reader.read("oid:0x1", { "A" }, values));
+
+        {
+            CounterSnapshotWriter writer(snapshotName, { "A", "B", "C" }, 2);
+            size_t slot = writer.addObject("oid:0x1");
+
+            // Not attached until the next refresh
+            const uint64_t counters[] = { 1, 2, 3 };
+            writer.write(slot, counters);
+            ASSERT_FALSE(reader.read("oid:0x1", { "A" }, values));
+            reader.refresh();
+
+            ASSERT_TRUE(reader.read("oid:0x1", { "C", "A" }, values));
+            ASSERT_EQ(values[0], 3);
+            ASSERT_EQ(values[1], 1);
+
+            // Unknown objects and counters are read from COUNTERS_DB
+            ASSERT_FALSE(reader.read("oid:0x2", { "A" }, values));
+            ASSERT_FALSE(reader.read("oid:0x1", { "D" }, values));
+        }
+
+        // The producer is gone
+        ASSERT_FALSE(reader.read("oid:0x1", { "A" }, values));
+
+        // A restarted producer is attached again
+        CounterSnapshotWriter writer(snapshotName, { "A" }, 1);
+        size_t slot = writer.addObject("oid:0x1");
+        reader.refresh();
+
+        // Not written yet
+        ASSERT_FALSE(reader.read("oid:0x1", { "A" }, values));
+
+        const uint64_t counter = 7;
+        writer.write(slot, &counter);
+        ASSERT_TRUE(reader.read("oid:0x1", { "A" }, values));
+        ASSERT_EQ(values[0], 7);
+    }
+
+    TEST(CounterSnapshotTest, ProducerExitsWithoutRemovingRegion)
+    {
+        CounterSnapshotReader reader(snapshotName);
+        uint64_t value;
+
+        // The producer exits without running its destructor
+        pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0)
+        {
+            auto writer = new CounterSnapshotWriter(snapshotName, { "A" }, 1);
+            const uint64_t counter = 1;
+            writer->write(writer->addObject("oid:0x1"), &counter);
+            _exit(0);
+        }
+        int status;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+
+        reader.refresh();
+        ASSERT_TRUE(reader.read("oid:0x1", { "A" }, &value));
+        ASSERT_EQ(value, 1);
+
+        // The region of the restarted producer replaces the frozen one
+        {
+            CounterSnapshotWriter writer(snapshotName, { "A" }, 1);
+            const uint64_t counter = 2;
+            writer.write(writer.addObject("oid:0x1"), &counter);
+
+            reader.refresh();
+            ASSERT_TRUE(reader.read("oid:0x1", { "A" }, &value));
+            ASSERT_EQ(value, 2);
+        }
+
+        // The removed region is not read anymore
+        reader.refresh();
+        ASSERT_FALSE(reader.read("oid:0x1", { "A" }, &value));
+    }
+}
@@ -0,0 +1,52 @@
+#include "ut_helper.h"
+
+namespace flex_counter_manager_test
+{
+    using namespace std;
+
+    const unordered_set<string> counter_stats =
+    {
+        "SAI_PORT_STAT_IF_IN_OCTETS",
+        "SAI_PORT_STAT_IF_OUT_OCTETS"
+    };
+
+    TEST(FlexCounterManagerTest, SetCounterIdListBatch)
+    {
+        FlexCounterManager manager("TEST_STAT_COUNTER", StatsMode::READ, 1000, false);
+        vector<sai_object_id_t> object_ids = { 0x1000000000001, 0x1000000000002, 0x1000000000003 };
+
+        // All the objects are installed and written at once
+        manager.setCounterIdList(object_ids, CounterType::PORT, counter_stats);
+        ASSERT_EQ(manager.installed_counters.size(), object_ids.size());
+        ASSERT_EQ(manager.flex_counter_pipeline->size(), 0);
+
+        manager.clearCounterIdList(object_ids[0]);
+        ASSERT_EQ(manager.installed_counters.count(object_ids[0]), 0);
+        ASSERT_EQ(manager.installed_counters.size(), object_ids.size() - 1);
+    }
+
+    TEST(FlexCounterManagerTest, DeferredMode)
+    {
+        FlexCounterManager manager("TEST_STAT_COUNTER", StatsMode::READ, 1000, false);
+        vector<sai_object_id_t> object_ids = { 0x1000000000002, 0x1000000000003 };
+
+        // Counter id lists stay buffered until the mode is left
+        manager.setDeferredMode(true);
+        manager.setCounterIdList(0x1000000000001, CounterType::PORT, counter_stats);
+        manager.setCounterIdList(object_ids, CounterType::PORT, counter_stats);
+        ASSERT_EQ(manager.installed_counters.size(), 3);
+        ASSERT_GT(manager.flex_counter_pipeline->size(), 0);
+
+        manager.setDeferredMode(false);
+        ASSERT_EQ(manager.flex_counter_pipeline->size(), 0);
+
+        // Or until they are flushed
+        manager.setDeferredMode(true);
+        manager.clearCounterIdList(0x1000000000001);
+        ASSERT_GT(manager.flex_counter_pipeline->size(), 0);
+
+        manager.flush();
+        ASSERT_EQ(manager.flex_counter_pipeline->size(), 0);
+        ASSERT_EQ(manager.installed_counters.size(), 2);
+    }
+}
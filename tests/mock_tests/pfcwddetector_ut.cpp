@@ -0,0 +1,119 @@
+#include "ut_helper.h"
+#include "pfcwddetector.h"
+
+namespace pfcwddetector_test
+{
+    using namespace std;
+
+    const uint32_t pollTime = 200000;
+
+    PfcWdQueueCounters counters(uint64_t packets, uint64_t pfcRxPackets, uint64_t pfcRxPause, bool pauseStatus)
+    {
+        PfcWdQueueCounters c;
+        c.occupancyBytes = 100;
+        c.packets = packets;
+        c.pfcRxPackets = pfcRxPackets;
+        c.pfcRxPause = pfcRxPause;
+        c.pauseStatus = pauseStatus;
+        c.valid = true;
+        return c;
+    }
+
+    TEST(PfcWdDetectorTest, StormAndRestore)
+    {
+        PfcWdDetector detector(PfcWdStormCriteria::PFC_WD_STORM_PAUSE_STATUS);
+        uint32_t queue = detector.addQueue(2 * pollTime, 2 * pollTime, false);
+        vector<PfcWdDetectorEvent> events;
+
+        // First run only saves the counters
+        vector<PfcWdQueueCounters> c = { counters(10, 0, 0, true) };
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+
+        // No TX while paused, storm after the detection time
+        c = { counters(10, 10, 0, true) };
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+        c = { counters(10, 20, 0, true) };
+        detector.poll(c, pollTime, events);
+        ASSERT_EQ(events.size(), 1);
+        ASSERT_EQ(events[0].queue, queue);
+        ASSERT_TRUE(events[0].storm);
+        detector.setStormed(queue, true);
+
+        // Restore after no PFC frames during the restoration time
+        events.clear();
+        c = { counters(10, 30, 0, true) };
+        detector.poll(c, pollTime, events);
+        c = { counters(10, 30, 0, false) };
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+        // Unchanged counters are only processed on the next poll
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+        detector.poll(c, pollTime, events);
+        ASSERT_EQ(events.size(), 1);
+        ASSERT_FALSE(events[0].storm);
+    }
+
+    TEST(PfcWdDetectorTest, TrafficResetsDetection)
+    {
+        PfcWdDetector detector(PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION);
+        detector.addQueue(2 * pollTime, 0, false);
+        vector<PfcWdDetectorEvent> events;
+
+        vector<PfcWdQueueCounters> c = { counters(10, 0, 0, false) };
+        detector.poll(c, pollTime, events);
+        c = { counters(10, 10, 0, false) };
+        detector.poll(c, pollTime, events);
+        c = { counters(20, 20, 0, false) };
+        detector.poll(c, pollTime, events);
+        c = { counters(20, 30, 0, false) };
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+
+        // Removed queues are not polled
+        detector.removeQueue(0);
+        c = { counters(20, 40, 0, false) };
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+    }
+
+    TEST(PfcWdDetectorTest, RepeatedSamples)
+    {
+        PfcWdDetector detector(PfcWdStormCriteria::PFC_WD_STORM_PAUSE_DURATION);
+        uint32_t queue = detector.addQueue(2 * pollTime, pollTime, false);
+        vector<PfcWdDetectorEvent> events;
+
+        vector<PfcWdQueueCounters> c = { counters(10, 0, 0, false) };
+        detector.poll(c, pollTime, events);
+        c = { counters(10, 10, 0, false) };
+        detector.poll(c, pollTime, events);
+
+        // Reading the same sample again does not reset detection
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+        c = { counters(10, 20, 0, false) };
+        detector.poll(c, pollTime, events);
+        ASSERT_EQ(events.size(), 1);
+        ASSERT_TRUE(events[0].storm);
+        detector.setStormed(queue, true);
+
+        // Nor counts as an interval without PFC frames
+        events.clear();
+        c = { counters(10, 30, 0, false) };
+        detector.poll(c, pollTime, events);
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+        c = { counters(10, 40, 0, false) };
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+
+        // Counters unchanged over two polls are processed
+        detector.poll(c, pollTime, events);
+        ASSERT_TRUE(events.empty());
+        detector.poll(c, pollTime, events);
+        ASSERT_EQ(events.size(), 1);
+        ASSERT_FALSE(events[0].storm);
+    }
+}
@@ -5,6 +5,8 @@
 
 #include "aclorch.h"
 #include "crmorch.h"
+#include "counter_rates.h"
+#include "watermarkaggregator.h"
 
 #undef protected
 #undef private
@@ -59,4 +61,60 @@ struct Portal
             crmOrch->getResAvailableCounters();
         }
     };
+
+    struct CounterSlotsInternal
+    {
+        static size_t getSlot(const CounterSlots &slots, const std::string &objectId)
+        {
+            size_t slot = 0;
+            if (!slots.find(objectId, slot))
+            {
+                throw std::out_of_range(objectId);
+            }
+            return slot;
+        }
+    };
+
+    struct CounterRatesInternal
+    {
+        static void sample(CounterRates &rates, const std::string &objectId, const std::vector<uint64_t> &counters,
+                double alpha, std::chrono::steady_clock::time_point now)
+        {
+            size_t slot = CounterSlotsInternal::getSlot(rates.slots, objectId);
+            rates.valid[slot] = 1;
+            rates.setCurrent(slot, counters);
+            rates.computeRates(alpha, now);
+        }
+
+        static double getRate(const CounterRates &rates, const std::string &objectId, size_t rate)
+        {
+            size_t slot = CounterSlotsInternal::getSlot(rates.slots, objectId);
+            return rates.values[rate][slot];
+        }
+    };
+
+    struct WatermarkAggregatorInternal
+    {
+        static void sample(WatermarkAggregator &aggregator, const std::string &objectId, size_t stat, uint64_t counter,
+                std::chrono::steady_clock::time_point now)
+        {
+            size_t slot = CounterSlotsInternal::getSlot(aggregator.m_slots, objectId);
+            aggregator.m_seeded[slot] = 1;
+            aggregator.m_counters[stat][slot] = counter;
+            aggregator.m_counterValid[stat][slot] = 1;
+            aggregator.reduce(now);
+        }
+
+        static uint64_t getUserWatermark(const WatermarkAggregator &aggregator, const std::string &objectId, size_t stat)
+        {
+            size_t slot = CounterSlotsInternal::getSlot(aggregator.m_slots, objectId);
+            return aggregator.m_watermarks[WatermarkAggregator::WM_USER][stat].value[slot];
+        }
+
+        static uint64_t getPersistentWatermark(const WatermarkAggregator &aggregator, const std::string &objectId, size_t stat)
+        {
+            size_t slot = CounterSlotsInternal::getSlot(aggregator.m_slots, objectId);
+            return aggregator.m_watermarks[WatermarkAggregator::WM_PERSISTENT][stat].value[slot];
+        }
+    };
 };
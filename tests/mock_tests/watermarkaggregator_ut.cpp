@@ -0,0 +1,47 @@
+#include "ut_helper.h"
+
+namespace watermarkaggregator_test
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const string objectId = "oid:0x1";
+    const string stat = "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES";
+
+    TEST(WatermarkAggregatorTest, ClearThenPoll)
+    {
+        DBConnector countersDb("COUNTERS_DB", 0);
+        WatermarkAggregator aggregator(&countersDb, "QUEUE_WATERMARK", { stat }, 10000);
+        aggregator.setObjects({ objectId });
+
+        auto sample = [&](uint64_t counter, steady_clock::time_point now)
+        {
+            Portal::WatermarkAggregatorInternal::sample(aggregator, objectId, 0, counter, now);
+        };
+        auto user = [&]() { return Portal::WatermarkAggregatorInternal::getUserWatermark(aggregator, objectId, 0); };
+        auto persistent = [&]() { return Portal::WatermarkAggregatorInternal::getPersistentWatermark(aggregator, objectId, 0); };
+
+        sample(100, steady_clock::now());
+        ASSERT_EQ(user(), 100);
+
+        aggregator.clear(USER_WATERMARKS_TABLE, stat, { objectId });
+        ASSERT_EQ(user(), 0);
+        ASSERT_EQ(persistent(), 100);
+
+        // The sample read before the clear is not folded in again
+        sample(100, steady_clock::now() + seconds(5));
+        ASSERT_EQ(user(), 0);
+        ASSERT_EQ(persistent(), 100);
+
+        // A new sample polled by syncd is
+        sample(50, steady_clock::now() + seconds(6));
+        ASSERT_EQ(user(), 50);
+
+        // Nor is an unchanged sample, until syncd polled again
+        aggregator.clear(USER_WATERMARKS_TABLE, stat, { objectId });
+        sample(50, steady_clock::now() + seconds(5));
+        ASSERT_EQ(user(), 0);
+        sample(50, steady_clock::now() + seconds(11));
+        ASSERT_EQ(user(), 50);
+    }
+}
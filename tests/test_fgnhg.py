@@ -708,7 +708,7 @@ class TestFineGrainedNextHopGroup(object):
         '''
         Test route/nh transitions to/from Fine Grained ECMP and Regular ECMP.
         Create multiple prefixes pointing to the Fine Grained nhs and ensure 
-        fine grained ECMP ASIC objects were created for this scenario as expected.
+        the prefixes share one fine grained ECMP group in ASIC as expected.
         '''
         app_db = dvs.get_app_db()
         asic_db = dvs.get_asic_db()
@@ -763,12 +763,14 @@ class TestFineGrainedNextHopGroup(object):
                                 fg_nhg_prefix, nh_memb_exp_count, nh_oid_map, nhgid, bucket_size)
 
         # Add a 2nd prefix associated with the same set of next-hops
+        # It should share the Fine Grained ECMP group of the 1st prefix
         fg_nhg_prefix_2 = "5.5.5.0/16"
         fvs = swsscommon.FieldValuePairs([("nexthop","10.0.0.1,10.0.0.5"),
             ("ifname", "Ethernet0,Ethernet8")])
         ps.set(fg_nhg_prefix_2, fvs)
-        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size*2)
         nhgid_2 = validate_asic_nhg_fine_grained_ecmp(asic_db, fg_nhg_prefix_2, bucket_size)
+        assert nhgid_2 == nhgid
+        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size)
         nh_memb_exp_count = {"10.0.0.1":64,"10.0.0.5":64}
         validate_fine_grained_asic_n_state_db_entries(asic_db, state_db, ip_to_if_map,
                                 fg_nhg_prefix_2, nh_memb_exp_count, nh_oid_map, nhgid_2, bucket_size)
@@ -780,13 +782,14 @@ class TestFineGrainedNextHopGroup(object):
                 ("ifname", "Ethernet0,Ethernet8,Ethernet16")])
         ps.set(fg_nhg_prefix_3, fvs)
         validate_asic_nhg_regular_ecmp(asic_db, fg_nhg_prefix_3)
-        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size*2 + 3)
-        # Remove the 10.0.0.9 next-hop, it should now transition to Fine Grained ECMP
+        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size + 3)
+        # Remove the 10.0.0.9 next-hop, it should now transition to the shared Fine Grained ECMP group
         fvs = swsscommon.FieldValuePairs([("nexthop","10.0.0.1,10.0.0.5"),
             ("ifname", "Ethernet0,Ethernet8")])
         ps.set(fg_nhg_prefix_3, fvs)
         nhgid_3 = validate_asic_nhg_fine_grained_ecmp(asic_db, fg_nhg_prefix_3, bucket_size)
-        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size*3)
+        assert nhgid_3 == nhgid
+        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size)
         nh_memb_exp_count = {"10.0.0.1":64,"10.0.0.5":64}
         validate_fine_grained_asic_n_state_db_entries(asic_db, state_db, ip_to_if_map,
                                 fg_nhg_prefix_3, nh_memb_exp_count, nh_oid_map, nhgid_3, bucket_size)
@@ -795,17 +798,24 @@ class TestFineGrainedNextHopGroup(object):
                 ("ifname", "Ethernet0,Ethernet8,Ethernet16")])
         ps.set(fg_nhg_prefix_3, fvs)
         validate_asic_nhg_regular_ecmp(asic_db, fg_nhg_prefix_3)
-        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size*2 + 3)
+        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size + 3)
         # Delete the prefix
         asic_rt_key = get_asic_route_key(asic_db, fg_nhg_prefix_3)
         ps._del(fg_nhg_prefix_3)
         asic_db.wait_for_deleted_entry(ASIC_ROUTE_TB, asic_rt_key)
-        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size*2)
+        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size)
 
-        # Change FG nhs for one route, ensure that the other route nh is unaffected
+        # Change FG nhs for one route, it should move to its own Fine Grained ECMP group,
+        # ensure that the other route nh is unaffected
+        fvs = swsscommon.FieldValuePairs([("nexthop","10.0.0.1,10.0.0.3,10.0.0.5,10.0.0.7"),
+            ("ifname", "Ethernet0,Ethernet4,Ethernet8,Ethernet12")])
+        ps.set(fg_nhg_prefix, fvs)
+        asic_db.wait_for_n_keys(ASIC_NHG_MEMB, bucket_size*2)
+        nhgid = validate_asic_nhg_fine_grained_ecmp(asic_db, fg_nhg_prefix, bucket_size)
+        assert nhgid != nhgid_2
         nh_memb_exp_count = {"10.0.0.1":32,"10.0.0.3":32,"10.0.0.5":32,"10.0.0.7":32}
-        program_route_and_validate_fine_grained_ecmp(app_db.db_connection, asic_db, state_db, ip_to_if_map,
-                            fg_nhg_prefix, nh_memb_exp_count, nh_oid_map, nhgid, bucket_size)
+        validate_fine_grained_asic_n_state_db_entries(asic_db, state_db, ip_to_if_map,
+                                fg_nhg_prefix, nh_memb_exp_count, nh_oid_map, nhgid, bucket_size)
         nh_memb_exp_count = {"10.0.0.1":64,"10.0.0.5":64}
         validate_fine_grained_asic_n_state_db_entries(asic_db, state_db, ip_to_if_map,
                                 fg_nhg_prefix_2, nh_memb_exp_count, nh_oid_map, nhgid_2, bucket_size)
@@ -8,6 +8,123 @@ import ipaddress
 
 from swsscommon import swsscommon
 
+NHG_POOL_SIZE = 4
+
+
+def config_nhg_intfs(dvs, count, resolve=None):
+    """ Configure Ethernet0, Ethernet4, ... with 10.0.0.0/31, 10.0.0.2/31, ... and their neighbors """
+    if resolve is None:
+        resolve = count
+
+    config_db = dvs.get_config_db()
+    fvs = {"NULL": "NULL"}
+    for i in range(count):
+        port = "Ethernet%d" % (i * 4)
+        config_db.create_entry("INTERFACE", port, fvs)
+        config_db.create_entry("INTERFACE", "%s|10.0.0.%d/31" % (port, i * 2), fvs)
+        dvs.runcmd("config interface startup " + port)
+        if i < resolve:
+            dvs.runcmd("arp -s 10.0.0.%d 00:00:00:00:00:0%d" % (i * 2 + 1, i + 1))
+        assert dvs.servers[i].runcmd("ip link set down dev eth0") == 0
+        assert dvs.servers[i].runcmd("ip link set up dev eth0") == 0
+
+
+def route_nhg_fvs(count):
+    nexthop = ",".join("10.0.0.%d" % (i * 2 + 1) for i in range(count))
+    ifname = ",".join("Ethernet%d" % (i * 4) for i in range(count))
+    return swsscommon.FieldValuePairs([("nexthop", nexthop), ("ifname", ifname)])
+
+
+def get_route_nhg(asic_db, dvs_route, prefix):
+    rtkeys = dvs_route.check_asicdb_route_entries([prefix])
+    fvs = asic_db.get_entry("ASIC_STATE:SAI_OBJECT_TYPE_ROUTE_ENTRY", rtkeys[0])
+    return fvs.get("SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID")
+
+
+def get_nhg_member_count(asic_db, nhgid):
+    count = 0
+    for k in asic_db.get_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER"):
+        fvs = asic_db.get_entry("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", k)
+        if fvs["SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID"] == nhgid:
+            count += 1
+    return count
+
+
+def pause_orchagent(dvs):
+    """ Stop orchagent, so the routes written until resume_orchagent() are handled in one bulk """
+    dvs.runcmd(["sh", "-c", "kill -STOP $(pidof orchagent)"])
+
+
+def resume_orchagent(dvs):
+    dvs.runcmd(["sh", "-c", "kill -CONT $(pidof orchagent)"])
+
+
+def set_orchagent_args(dvs, args):
+    """ Restart orchagent with extra arguments, an empty string restores the default ones """
+    dvs.runcmd(["sh", "-c", "[ -f /usr/bin/orchagent.sh.orig ] || cp /usr/bin/orchagent.sh /usr/bin/orchagent.sh.orig"])
+    dvs.runcmd(["sh", "-c", "cp /usr/bin/orchagent.sh.orig /usr/bin/orchagent.sh"])
+    if args:
+        dvs.runcmd(["sh", "-c", "sed -i 's|^exec /usr/bin/orchagent |exec /usr/bin/orchagent {} |' /usr/bin/orchagent.sh".format(args)])
+
+    dvs.runcmd("supervisorctl restart syncd")
+    dvs.stop_swss()
+    dvs.start_swss()
+
+
+@pytest.fixture(scope="class")
+def nhg_pool(dvs):
+    set_orchagent_args(dvs, "-n {}".format(NHG_POOL_SIZE))
+    yield NHG_POOL_SIZE
+    set_orchagent_args(dvs, "")
+
+
+@pytest.mark.usefixtures("nhg_pool")
+class TestNextHopGroupPool(object):
+    def test_route_nhg_pool(self, dvs, dvs_route, testlog):
+        config_nhg_intfs(dvs, 3)
+
+        app_db = dvs.get_app_db()
+        asic_db = dvs.get_asic_db()
+        ps = swsscommon.ProducerStateTable(app_db.db_connection, "ROUTE_TABLE")
+
+        # The pool is filled after each route bulk
+        ps.set("2.2.2.0/24", route_nhg_fvs(3))
+        nhgid3 = get_route_nhg(asic_db, dvs_route, "2.2.2.0/24")
+        keys = asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", 1 + NHG_POOL_SIZE)
+        pool = set(keys) - {nhgid3}
+        for nhgid in pool:
+            assert get_nhg_member_count(asic_db, nhgid) == 0
+
+        # A new group is taken from the pool, and the pool is refilled
+        ps.set("3.3.3.0/24", route_nhg_fvs(2))
+        nhgid2 = get_route_nhg(asic_db, dvs_route, "3.3.3.0/24")
+        assert nhgid2 in pool
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", 2 + NHG_POOL_SIZE)
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", 5)
+
+        # A group removed in the bulk that took a group from the pool goes back to the pool
+        pause_orchagent(dvs)
+        ps._del("3.3.3.0/24")
+        ps.set("4.4.4.0/24", swsscommon.FieldValuePairs([("nexthop", "10.0.0.3,10.0.0.5"),
+                                                         ("ifname", "Ethernet4,Ethernet8")]))
+        resume_orchagent(dvs)
+
+        dvs_route.check_asicdb_deleted_route_entries(["3.3.3.0/24"])
+        nhgid = get_route_nhg(asic_db, dvs_route, "4.4.4.0/24")
+        assert nhgid != nhgid2
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", 5)
+        keys = asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", 2 + NHG_POOL_SIZE)
+        assert nhgid2 in keys
+        assert get_nhg_member_count(asic_db, nhgid2) == 0
+
+        # Groups released to a full pool are removed
+        ps._del("2.2.2.0/24")
+        ps._del("4.4.4.0/24")
+
+        dvs_route.check_asicdb_deleted_route_entries(["2.2.2.0/24", "4.4.4.0/24"])
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", 0)
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", NHG_POOL_SIZE)
+
 
 class TestNextHopGroup(object):
     def test_route_nhg(self, dvs, dvs_route, testlog):
@@ -108,6 +225,78 @@ class TestNextHopGroup(object):
         # Wait for route 2.2.2.0/24 to be removed
         dvs_route.check_asicdb_deleted_route_entries([rtprefix])
 
+    def test_route_nhg_bulk(self, dvs, dvs_route, testlog):
+        config_nhg_intfs(dvs, 3)
+
+        app_db = dvs.get_app_db()
+        asic_db = dvs.get_asic_db()
+        ps = swsscommon.ProducerStateTable(app_db.db_connection, "ROUTE_TABLE")
+
+        # Routes of one bulk share the next hop groups created for them
+        pause_orchagent(dvs)
+        ps.set("2.2.2.0/24", route_nhg_fvs(3))
+        ps.set("3.3.3.0/24", route_nhg_fvs(3))
+        ps.set("4.4.4.0/24", route_nhg_fvs(2))
+        ps.set("5.5.5.0/24", route_nhg_fvs(2))
+        resume_orchagent(dvs)
+
+        dvs_route.check_asicdb_route_entries(["2.2.2.0/24", "3.3.3.0/24", "4.4.4.0/24", "5.5.5.0/24"])
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", 2)
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", 5)
+
+        nhgid3 = get_route_nhg(asic_db, dvs_route, "2.2.2.0/24")
+        nhgid2 = get_route_nhg(asic_db, dvs_route, "4.4.4.0/24")
+        assert nhgid3 != nhgid2
+        assert get_route_nhg(asic_db, dvs_route, "3.3.3.0/24") == nhgid3
+        assert get_route_nhg(asic_db, dvs_route, "5.5.5.0/24") == nhgid2
+        assert get_nhg_member_count(asic_db, nhgid3) == 3
+        assert get_nhg_member_count(asic_db, nhgid2) == 2
+
+        for prefix in ["2.2.2.0/24", "3.3.3.0/24", "4.4.4.0/24", "5.5.5.0/24"]:
+            ps._del(prefix)
+
+        dvs_route.check_asicdb_deleted_route_entries(["2.2.2.0/24", "3.3.3.0/24", "4.4.4.0/24", "5.5.5.0/24"])
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", 0)
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", 0)
+
+    def test_route_nhg_bulk_retry(self, dvs, dvs_route, testlog):
+        # The neighbor of Ethernet12 is not resolved yet
+        config_nhg_intfs(dvs, 4, resolve=3)
+
+        app_db = dvs.get_app_db()
+        asic_db = dvs.get_asic_db()
+        ps = swsscommon.ProducerStateTable(app_db.db_connection, "ROUTE_TABLE")
+
+        # The group that can't be created doesn't hold back the rest of the bulk
+        pause_orchagent(dvs)
+        ps.set("2.2.2.0/24", route_nhg_fvs(3))
+        ps.set("3.3.3.0/24", route_nhg_fvs(4))
+        resume_orchagent(dvs)
+
+        nhgid3 = get_route_nhg(asic_db, dvs_route, "2.2.2.0/24")
+        assert get_nhg_member_count(asic_db, nhgid3) == 3
+
+        # The other route uses a temporary route to a single next hop meanwhile
+        nhid = get_route_nhg(asic_db, dvs_route, "3.3.3.0/24")
+        assert not asic_db.get_entry("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", nhid)
+        assert len(asic_db.get_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP")) == 1
+
+        # The route is retried and gets its group once the neighbor is resolved
+        dvs.runcmd("arp -s 10.0.0.7 00:00:00:00:00:04")
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", 2)
+        nhgid4 = get_route_nhg(asic_db, dvs_route, "3.3.3.0/24")
+        assert nhgid4 != nhgid3
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", 7)
+        assert get_nhg_member_count(asic_db, nhgid4) == 4
+
+        ps._del("2.2.2.0/24")
+        ps._del("3.3.3.0/24")
+
+        dvs_route.check_asicdb_deleted_route_entries(["2.2.2.0/24", "3.3.3.0/24"])
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP", 0)
+        asic_db.wait_for_n_keys("ASIC_STATE:SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER", 0)
+        dvs.runcmd("arp -d 10.0.0.7")
+
     def test_route_nhg_exhaust(self, dvs, testlog):
         """
         Test the situation of exhausting ECMP group, assume SAI_SWITCH_ATTR_NUMBER_OF_ECMP_GROUPS is 512
@@ -4,6 +4,7 @@ import sys
 import time
 
 from swsscommon import swsscommon
+from dvslib.dvs_common import wait_for_result
 
 CFG_DOT1P_TO_TC_MAP_TABLE_NAME =  "DOT1P_TO_TC_MAP"
 CFG_DOT1P_TO_TC_MAP_KEY = "AZURE"
@@ -22,6 +23,14 @@ CFG_PORT_QOS_MAP_TABLE_NAME =  "PORT_QOS_MAP"
 CFG_PORT_QOS_MAP_FIELD = "dot1p_to_tc_map"
 CFG_PORT_TABLE_NAME = "PORT"
 
+CFG_DSCP_TO_TC_MAP_TABLE_NAME = "DSCP_TO_TC_MAP"
+DSCP_TO_TC_MAP = {
+    "0": "0",
+    "8": "1",
+    "46": "5",
+    "48": "6",
+}
+
 
 class TestDot1p(object):
     def connect_dbs(self, dvs):
@@ -106,6 +115,90 @@ class TestDot1p(object):
         assert port_cnt == cnt
 
 
+class TestQosMapSharing(object):
+    def get_dscp_to_tc_maps(self, asic_db):
+        maps = []
+        for key in asic_db.get_keys("ASIC_STATE:SAI_OBJECT_TYPE_QOS_MAP"):
+            fvs = asic_db.get_entry("ASIC_STATE:SAI_OBJECT_TYPE_QOS_MAP", key)
+            if fvs.get("SAI_QOS_MAP_ATTR_TYPE") == "SAI_QOS_MAP_TYPE_DSCP_TO_TC":
+                maps.append(key)
+        return set(maps)
+
+
+    def wait_for_dscp_to_tc_maps(self, asic_db, num_maps):
+        def _access_function():
+            maps = self.get_dscp_to_tc_maps(asic_db)
+            return (len(maps) == num_maps, maps)
+
+        _, maps = wait_for_result(_access_function, failure_message="DSCP_TO_TC maps not found in ASIC DB")
+        return maps
+
+
+    def get_port_dscp_to_tc_map(self, dvs, asic_db, port):
+        fvs = asic_db.get_entry("ASIC_STATE:SAI_OBJECT_TYPE_PORT", dvs.asicdb.portnamemap[port])
+        return fvs.get("SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP")
+
+
+    def test_identical_maps_share_object(self, dvs):
+        config_db = dvs.get_config_db()
+        asic_db = dvs.get_asic_db()
+        baseline = self.get_dscp_to_tc_maps(asic_db)
+
+        config_db.create_entry(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "SHARED_A", DSCP_TO_TC_MAP)
+        maps = self.wait_for_dscp_to_tc_maps(asic_db, len(baseline) + 1)
+        shared_oid = (maps - baseline).pop()
+
+        # An identical map uses the same object
+        config_db.create_entry(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "SHARED_B", DSCP_TO_TC_MAP)
+        time.sleep(1)
+        assert self.get_dscp_to_tc_maps(asic_db) == maps
+
+        # The object is kept while one of the maps still uses it
+        config_db.delete_entry(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "SHARED_A")
+        time.sleep(1)
+        assert shared_oid in self.get_dscp_to_tc_maps(asic_db)
+
+        config_db.delete_entry(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "SHARED_B")
+        maps = self.wait_for_dscp_to_tc_maps(asic_db, len(baseline))
+        assert maps == baseline
+
+
+    def test_changed_map_moves_only_its_ports(self, dvs):
+        config_db = dvs.get_config_db()
+        asic_db = dvs.get_asic_db()
+        baseline = self.get_dscp_to_tc_maps(asic_db)
+
+        config_db.create_entry(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "SPLIT_A", DSCP_TO_TC_MAP)
+        config_db.create_entry(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "SPLIT_B", DSCP_TO_TC_MAP)
+        maps = self.wait_for_dscp_to_tc_maps(asic_db, len(baseline) + 1)
+        shared_oid = (maps - baseline).pop()
+
+        config_db.create_entry(CFG_PORT_QOS_MAP_TABLE_NAME, "Ethernet0",
+                               {"dscp_to_tc_map": "[" + CFG_DSCP_TO_TC_MAP_TABLE_NAME + "|SPLIT_A]"})
+        config_db.create_entry(CFG_PORT_QOS_MAP_TABLE_NAME, "Ethernet4",
+                               {"dscp_to_tc_map": "[" + CFG_DSCP_TO_TC_MAP_TABLE_NAME + "|SPLIT_B]"})
+        asic_db.wait_for_field_match("ASIC_STATE:SAI_OBJECT_TYPE_PORT", dvs.asicdb.portnamemap["Ethernet0"],
+                                     {"SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP": shared_oid})
+        asic_db.wait_for_field_match("ASIC_STATE:SAI_OBJECT_TYPE_PORT", dvs.asicdb.portnamemap["Ethernet4"],
+                                     {"SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP": shared_oid})
+
+        # Changing one map gives it its own object, the other map keeps the shared one
+        config_db.update_entry(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "SPLIT_B", {"46": "4"})
+        maps = self.wait_for_dscp_to_tc_maps(asic_db, len(baseline) + 2)
+        assert shared_oid in maps
+        split_oid = (maps - baseline - {shared_oid}).pop()
+
+        asic_db.wait_for_field_match("ASIC_STATE:SAI_OBJECT_TYPE_PORT", dvs.asicdb.portnamemap["Ethernet4"],
+                                     {"SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP": split_oid})
+        assert self.get_port_dscp_to_tc_map(dvs, asic_db, "Ethernet0") == shared_oid
+
+        fvs = asic_db.get_entry("ASIC_STATE:SAI_OBJECT_TYPE_QOS_MAP", split_oid)
+        dscp_to_tc_map = json.loads(fvs["SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST"])
+        for dscp2tc in dscp_to_tc_map["list"]:
+            if dscp2tc["key"]["dscp"] == 46:
+                assert dscp2tc["value"]["tc"] == 4
+
+
 # Add Dummy always-pass test at end as workaroud
 # for issue when Flaky fail on final test it invokes module tear-down before retrying
 def test_nonflaky_dummy():
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "warmRestartHelper.h"
+
+using namespace swss;
+
+namespace
+{
+    redisReply *makeString(const std::string &str)
+    {
+        redisReply *reply = new redisReply();
+        reply->type = REDIS_REPLY_STRING;
+        reply->str = const_cast<char *>(str.c_str());
+        reply->len = str.size();
+        return reply;
+    }
+
+    redisReply *makeArray(const std::vector<redisReply *> &elements)
+    {
+        redisReply *reply = new redisReply();
+        reply->type = REDIS_REPLY_ARRAY;
+        reply->elements = elements.size();
+        reply->element = new redisReply *[elements.size()];
+        std::copy(elements.begin(), elements.end(), reply->element);
+        return reply;
+    }
+
+    void freeReply(redisReply *reply)
+    {
+        for (size_t i = 0; reply->type == REDIS_REPLY_ARRAY && i < reply->elements; i++)
+        {
+            freeReply(reply->element[i]);
+        }
+        if (reply->type == REDIS_REPLY_ARRAY)
+        {
+            delete[] reply->element;
+        }
+        delete reply;
+    }
+}
+
+TEST(WarmStartHelper, RestorationPageSkipsDuplicateKeys)
+{
+    const std::string prefix = "ROUTE_TABLE:";
+    const std::string cursor = "0";
+    const std::string key1 = "ROUTE_TABLE:10.0.0.0/24";
+    const std::string key2 = "ROUTE_TABLE:10.0.1.0/24";
+    const std::string field = "nexthop";
+    const std::string value1 = "1.1.1.1";
+    const std::string value2 = "2.2.2.2";
+
+    // SCAN returned key1 in both pages, and twice in the first one
+    redisReply *page1 = makeArray({
+        makeString(cursor),
+        makeString(key1), makeArray({ makeString(field), makeString(value1) }),
+        makeString(key1), makeArray({ makeString(field), makeString(value1) }),
+        makeString(key2), makeArray({ makeString(field), makeString(value2) }),
+    });
+    redisReply *page2 = makeArray({
+        makeString(cursor),
+        makeString(key1), makeArray({ makeString(field), makeString(value1) }),
+    });
+
+    std::unordered_set<std::string> restoredKeys;
+    WarmStartHelper::kfvVector chunk;
+    WarmStartHelper::parseRestorationPage(page1, prefix, restoredKeys, chunk);
+    WarmStartHelper::parseRestorationPage(page2, prefix, restoredKeys, chunk);
+
+    ASSERT_EQ(chunk.size(), 2);
+    EXPECT_EQ(kfvKey(chunk[0]), "10.0.0.0/24");
+    EXPECT_EQ(kfvKey(chunk[1]), "10.0.1.0/24");
+    ASSERT_EQ(kfvFieldsValues(chunk[1]).size(), 1);
+    EXPECT_EQ(fvValue(kfvFieldsValues(chunk[1])[0]), value2);
+
+    freeReply(page1);
+    freeReply(page2);
+}
@@ -0,0 +1,467 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "json_extractor.h"
+
+///
+/// Single pass json parser which descends into the compiled path tree.
+/// Subtrees without compiled paths are skipped without any allocations.
+///
+class JsonPathExtractor::Parser
+{
+public:
+    Parser(const std::string & json, JsonExtract & result)
+        : m_cur(json.c_str()), m_end(json.c_str() + json.size()), m_result(result) {}
+
+    void parse(const Node * root)
+    {
+        skip_ws();
+        if (peek() != '{')
+        {
+            error("json root is not an object");
+        }
+        parse_value(root, &m_result.values);
+        skip_ws();
+        if (m_cur != m_end)
+        {
+            error("unexpected data after json root");
+        }
+    }
+
+private:
+    [[noreturn]] void error(const std::string & reason) const
+    {
+        throw std::runtime_error("Can't parse json dump: " + reason);
+    }
+
+    char peek() const
+    {
+        return m_cur < m_end ? *m_cur : '\0';
+    }
+
+    void expect(char c)
+    {
+        skip_ws();
+        if (peek() != c)
+        {
+            error(std::string("expected '") + c + "'");
+        }
+        m_cur++;
+    }
+
+    void skip_ws()
+    {
+        while (m_cur < m_end && (*m_cur == ' ' || *m_cur == '\n' || *m_cur == '\r' || *m_cur == '\t'))
+        {
+            m_cur++;
+        }
+    }
+
+    void parse_value(const Node * node, JsonRecords * target)
+    {
+        skip_ws();
+        if (!node)
+        {
+            skip_value();
+        }
+        else if (node->is_leaf)
+        {
+            parse_leaf(node, target);
+        }
+        else if (peek() == '{')
+        {
+            parse_object(node, target);
+        }
+        else
+        {
+            // Not an object where one is expected: its paths are reported as missing
+            skip_value();
+        }
+    }
+
+    void parse_object(const Node * node, JsonRecords * target)
+    {
+        expect('{');
+        skip_ws();
+        if (peek() == '}')
+        {
+            m_cur++;
+            return;
+        }
+
+        std::string key;
+        while (true)
+        {
+            skip_ws();
+            parse_string(key);
+            expect(':');
+
+            if (node->items)
+            {
+                parse_value(node->items.get(), &m_result.items[key]);
+            }
+            else
+            {
+                auto it = node->children.find(key);
+                parse_value(it == node->children.end() ? nullptr : it->second.get(), target);
+            }
+
+            skip_ws();
+            if (peek() == ',')
+            {
+                m_cur++;
+                continue;
+            }
+            expect('}');
+            return;
+        }
+    }
+
+    void parse_leaf(const Node * node, JsonRecords * target)
+    {
+        switch (node->type)
+        {
+            case value_type::string:
+            {
+                if (peek() != '"')
+                {
+                    error("Can't unpack a string. key='" + node->path + "'");
+                }
+                std::string value;
+                parse_string(value);
+                (*target)[node->path] = std::move(value);
+                return;
+            }
+            case value_type::boolean:
+            {
+                if (match_literal("true"))
+                {
+                    (*target)[node->path] = "true";
+                }
+                else if (match_literal("false"))
+                {
+                    (*target)[node->path] = "false";
+                }
+                else
+                {
+                    error("Can't unpack a boolean. key='" + node->path + "'");
+                }
+                return;
+            }
+            case value_type::integer:
+            {
+                const char * start = m_cur;
+                if (peek() == '-')
+                {
+                    m_cur++;
+                }
+                while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9')
+                {
+                    m_cur++;
+                }
+                if (m_cur == start || *(m_cur - 1) == '-' || peek() == '.' || peek() == 'e' || peek() == 'E')
+                {
+                    error("Can't unpack an integer. key='" + node->path + "'");
+                }
+                long long value = std::strtoll(std::string(start, m_cur).c_str(), nullptr, 10);
+                (*target)[node->path] = std::to_string(value);
+                return;
+            }
+        }
+    }
+
+    bool match_literal(const char * literal)
+    {
+        size_t len = std::strlen(literal);
+        if ((size_t)(m_end - m_cur) >= len && std::memcmp(m_cur, literal, len) == 0)
+        {
+            m_cur += len;
+            return true;
+        }
+        return false;
+    }
+
+    static int hex_value(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    uint32_t parse_hex4()
+    {
+        if (m_end - m_cur < 4)
+        {
+            error("truncated unicode escape");
+        }
+        uint32_t cp = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            int v = hex_value(*m_cur++);
+            if (v < 0)
+            {
+                error("invalid unicode escape");
+            }
+            cp = (cp << 4) | (uint32_t)v;
+        }
+        return cp;
+    }
+
+    static void append_utf8(std::string & out, uint32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            out += (char)cp;
+        }
+        else if (cp < 0x800)
+        {
+            out += (char)(0xC0 | (cp >> 6));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000)
+        {
+            out += (char)(0xE0 | (cp >> 12));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            out += (char)(0xF0 | (cp >> 18));
+            out += (char)(0x80 | ((cp >> 12) & 0x3F));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+    }
+
+    void parse_string(std::string & out)
+    {
+        if (peek() != '"')
+        {
+            error("expected a string");
+        }
+        m_cur++;
+        out.clear();
+
+        while (true)
+        {
+            // Copy the run of plain characters at once
+            const char * run = m_cur;
+            while (m_cur < m_end && *m_cur != '"' && *m_cur != '\\')
+            {
+                m_cur++;
+            }
+            out.append(run, m_cur);
+
+            if (m_cur == m_end)
+            {
+                error("unterminated string");
+            }
+            if (*m_cur == '"')
+            {
+                m_cur++;
+                return;
+            }
+
+            m_cur++; // backslash
+            if (m_cur == m_end)
+            {
+                error("unterminated string");
+            }
+            char c = *m_cur++;
+            switch (c)
+            {
+                case '"':  out += '"';  break;
+                case '\\': out += '\\'; break;
+                case '/':  out += '/';  break;
+                case 'b':  out += '\b'; break;
+                case 'f':  out += '\f'; break;
+                case 'n':  out += '\n'; break;
+                case 'r':  out += '\r'; break;
+                case 't':  out += '\t'; break;
+                case 'u':
+                {
+                    uint32_t cp = parse_hex4();
+                    if (cp >= 0xD800 && cp <= 0xDBFF && m_end - m_cur >= 2 && m_cur[0] == '\\' && m_cur[1] == 'u')
+                    {
+                        m_cur += 2;
+                        uint32_t low = parse_hex4();
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    append_utf8(out, cp);
+                    break;
+                }
+                default:
+                    error("invalid escape in string");
+            }
+        }
+    }
+
+    void skip_string()
+    {
+        m_cur++; // opening quote
+        while (m_cur < m_end)
+        {
+            if (*m_cur == '\\')
+            {
+                m_cur += 2;
+                continue;
+            }
+            if (*m_cur++ == '"')
+            {
+                return;
+            }
+        }
+        error("unterminated string");
+    }
+
+    ///
+    /// Skip a value of any type. Nested containers are skipped by tracking depth only.
+    ///
+    void skip_value()
+    {
+        skip_ws();
+        char c = peek();
+        if (c == '"')
+        {
+            skip_string();
+            return;
+        }
+        if (c != '{' && c != '[')
+        {
+            // number or literal
+            const char * start = m_cur;
+            while (m_cur < m_end && *m_cur != ',' && *m_cur != '}' && *m_cur != ']'
+                   && *m_cur != ' ' && *m_cur != '\n' && *m_cur != '\r' && *m_cur != '\t')
+            {
+                m_cur++;
+            }
+            if (m_cur == start)
+            {
+                error("expected a value");
+            }
+            return;
+        }
+
+        int depth = 0;
+        while (m_cur < m_end)
+        {
+            c = *m_cur;
+            if (c == '"')
+            {
+                skip_string();
+                continue;
+            }
+            m_cur++;
+            if (c == '{' || c == '[')
+            {
+                depth++;
+            }
+            else if (c == '}' || c == ']')
+            {
+                if (--depth == 0)
+                {
+                    return;
+                }
+            }
+        }
+        error("unterminated container");
+    }
+
+    const char * m_cur;
+    const char * m_end;
+    JsonExtract & m_result;
+};
+
+///
+/// Construct the extractor
+/// @param items_prefix a path to the object whose members are items, for example "ports"
+///
+JsonPathExtractor::JsonPathExtractor(const std::string & items_prefix)
+{
+    Node * node = &m_root;
+    size_t last = 0, next = 0;
+    do
+    {
+        next = items_prefix.find('.', last);
+        auto & child = node->children[items_prefix.substr(last, next - last)];
+        if (!child)
+        {
+            child.reset(new Node());
+        }
+        node = child.get();
+        last = next + 1;
+    } while (next != std::string::npos);
+
+    node->items.reset(new Node());
+    m_items = node->items.get();
+}
+
+///
+/// Compile a path to the value into the tree
+/// @param root a tree to add the path to
+/// @param path a path relative to the root. It's the name of the extracted value
+/// @param full_path a canonical path, used in error messages
+/// @param type a type of the value
+///
+void JsonPathExtractor::add(Node * root, const std::string & path, const std::string & full_path, value_type type)
+{
+    Node * node = root;
+    size_t last = 0, next = 0;
+    do
+    {
+        if (node->is_leaf)
+        {
+            throw std::runtime_error("Path '" + full_path + "' extends another path");
+        }
+        next = path.find('.', last);
+        auto & child = node->children[path.substr(last, next - last)];
+        if (!child)
+        {
+            child.reset(new Node());
+        }
+        node = child.get();
+        last = next + 1;
+    } while (next != std::string::npos);
+
+    if (!node->children.empty() || node->items)
+    {
+        throw std::runtime_error("Path '" + full_path + "' is a prefix of another path");
+    }
+    node->is_leaf = true;
+    node->type = type;
+    node->path = path;
+}
+
+///
+/// Add a path to the value, relative to the json root
+///
+void JsonPathExtractor::add_path(const std::string & path, value_type type)
+{
+    add(&m_root, path, path, type);
+}
+
+///
+/// Add a path to the value, relative to every item
+///
+void JsonPathExtractor::add_item_path(const std::string & path, value_type type)
+{
+    add(m_items, path, "<item>." + path, type);
+}
+
+///
+/// Extract all compiled values from the json document
+/// Throws std::runtime_error if the document is malformed, or a value has an unexpected type.
+/// Values which are missing in the document are missing in the result.
+/// @param json a json document
+/// @return extracted values
+///
+JsonExtract JsonPathExtractor::extract(const std::string & json) const
+{
+    JsonExtract result;
+    Parser parser(json, result);
+    parser.parse(&m_root);
+    return result;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+using JsonRecords = std::unordered_map<std::string, std::string>;
+
+///
+/// Values extracted from one json document by JsonPathExtractor
+///
+struct JsonExtract
+{
+    JsonRecords values;                                 // values of the regular paths
+    std::unordered_map<std::string, JsonRecords> items; // values of the item paths, per item key
+};
+
+///
+/// Extracts a fixed set of values from json documents in a single streaming pass,
+/// without building a DOM. The paths are compiled once into a tree of keys.
+/// Paths are in format "key1.key2.key3". Item paths are relative to every member
+/// of the object at items_prefix, for example every port of the "ports" object.
+/// Extracted values are converted to strings: booleans to "true"/"false",
+/// integers to their decimal representation.
+///
+class JsonPathExtractor
+{
+public:
+    enum class value_type
+    {
+        string,
+        boolean,
+        integer,
+    };
+
+    JsonPathExtractor(const std::string & items_prefix);
+    void add_path(const std::string & path, value_type type);
+    void add_item_path(const std::string & path, value_type type);
+    JsonExtract extract(const std::string & json) const;
+
+private:
+    struct Node
+    {
+        std::unordered_map<std::string, std::unique_ptr<Node>> children;
+        std::unique_ptr<Node> items; // matches any key, every key is a new item
+        bool is_leaf = false;
+        value_type type = value_type::string;
+        std::string path;            // name of the extracted value
+    };
+
+    class Parser;
+
+    void add(Node * root, const std::string & path, const std::string & full_path, value_type type);
+
+    Node m_root;
+    Node * m_items;
+};
@@ -1,6 +1,7 @@
 #include <csignal>
 #include <iostream>
 #include <deque>
+#include <chrono>
 
 #include <logger.h>
 #include <select.h>
@@ -17,10 +18,11 @@ bool g_run = true;
 /// This function extract all available updates from the table
 /// and add or remove LAG interfaces from the TeamdCtlMgr
 ///
-/// @param table reference to the SubscriberStateTable
-/// @param mgr   reference to the TeamdCtlMgr
+/// @param table  reference to the SubscriberStateTable
+/// @param mgr    reference to the TeamdCtlMgr
+/// @param values reference to the ValuesStore
 ///
-void update_interfaces(swss::SubscriberStateTable & table, TeamdCtlMgr & mgr)
+void update_interfaces(swss::SubscriberStateTable & table, TeamdCtlMgr & mgr, ValuesStore & values)
 {
     std::deque<swss::KeyOpFieldsValuesTuple> entries;
 
@@ -37,6 +39,7 @@ void update_interfaces(swss::SubscriberStateTable & table, TeamdCtlMgr & mgr)
         else if (op == "DEL")
         {
             mgr.remove_lag(lag_name);
+            values.remove_lag(lag_name);
         }
         else
         {
@@ -60,6 +63,10 @@ void sig_handler(int signo)
 int main()
 {
     const int ms_select_timeout = 1000;
+    // LAGs without change events are polled with this interval
+    const auto poll_interval = std::chrono::seconds(1);
+    // All LAGs are dumped with this interval, to catch runner state not covered by events
+    const auto resync_interval = std::chrono::seconds(30);
 
     sighandler_t sig_res;
 
@@ -85,37 +92,55 @@ int main()
         swss::DBConnector db("STATE_DB", 0);
 
         ValuesStore values_store(&db);
-        TeamdCtlMgr teamdctl_mgr;
-
         swss::Select s;
+        TeamdCtlMgr teamdctl_mgr(&s);
+
         swss::Selectable * event;
         swss::SubscriberStateTable sst_lag(&db, STATE_LAG_TABLE_NAME);
         s.addSelectable(&sst_lag);
 
+        auto last_poll = std::chrono::steady_clock::now();
+        auto last_resync = last_poll;
+
         while (g_run && rc == 0)
         {
             int res = s.select(&event, ms_select_timeout);
             if (res == swss::Select::OBJECT)
             {
-                update_interfaces(sst_lag, teamdctl_mgr);
-                values_store.update(teamdctl_mgr.get_dumps());
+                if (event == &sst_lag)
+                {
+                    update_interfaces(sst_lag, teamdctl_mgr, values_store);
+                }
+                // Change events were consumed by the listeners. Dump the changed LAGs only
+                values_store.update_lags(teamdctl_mgr.get_dumps(teamdctl_mgr.get_changed_lags()));
             }
             else if (res == swss::Select::ERROR)
             {
                 SWSS_LOG_ERROR("Select returned ERROR");
                 rc = -2;
             }
-            else if (res == swss::Select::TIMEOUT)
-            {
-                teamdctl_mgr.process_add_queue();
-                values_store.update(teamdctl_mgr.get_dumps());
-            }
-            else
+            else if (res != swss::Select::TIMEOUT)
             {
                 SWSS_LOG_ERROR("Select returned unknown value");
                 rc = -3;
             }
-	    }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now - last_poll >= poll_interval)
+            {
+                teamdctl_mgr.process_add_queue();
+                if (now - last_resync >= resync_interval)
+                {
+                    values_store.update(teamdctl_mgr.get_dumps());
+                    last_resync = now;
+                }
+                else
+                {
+                    values_store.update_lags(teamdctl_mgr.get_dumps(teamdctl_mgr.get_polled_lags()));
+                }
+                last_poll = now;
+            }
+        }
         SWSS_LOG_NOTICE("Exiting");
     }
     catch (const std::exception & e)
@@ -1,5 +1,8 @@
 #include <cstring>
 #include <algorithm>
+#include <system_error>
+
+#include <net/if.h>
 
 #include <logger.h>
 
@@ -23,11 +26,85 @@ void teamdctl_log_function(struct teamdctl *tdc, int priority,
 }
 
 
+const struct team_change_handler TeamdEventListener::m_change_handler = {
+    .func       = TeamdEventListener::change_handler,
+    .type_mask  = TEAM_PORT_CHANGE | TEAM_OPTION_CHANGE
+};
+
+///
+/// Connect to libteam notifications of the LAG interface with name lag_name.
+/// The LAG is initially marked as changed to get its first dump.
+/// Throws std::system_error if the notifications aren't available
+/// @param lag_name a name for LAG interface
+///
+TeamdEventListener::TeamdEventListener(const std::string & lag_name) : m_team(nullptr), m_changed(true)
+{
+    uint32_t ifindex = if_nametoindex(lag_name.c_str());
+    if (ifindex == 0)
+    {
+        throw std::system_error(errno, std::system_category(), "Can't find ifindex for LAG " + lag_name);
+    }
+
+    m_team = team_alloc();
+    if (!m_team)
+    {
+        throw std::system_error(make_error_code(std::errc::not_enough_memory), "Can't allocate team handler");
+    }
+
+    int err = team_init(m_team, ifindex);
+    if (!err)
+    {
+        err = team_change_handler_register(m_team, &m_change_handler, this);
+    }
+
+    if (err)
+    {
+        team_free(m_team);
+        throw std::system_error(-err, std::system_category(), "Can't subscribe to team events for LAG " + lag_name);
+    }
+}
+
+///
+/// The destructor unsubscribes from libteam notifications
+///
+TeamdEventListener::~TeamdEventListener()
+{
+    team_change_handler_unregister(m_team, &m_change_handler, this);
+    team_free(m_team);
+}
+
+int TeamdEventListener::getFd()
+{
+    return team_get_event_fd(m_team);
+}
+
+uint64_t TeamdEventListener::readData()
+{
+    team_handle_events(m_team);
+    return 0;
+}
+
+int TeamdEventListener::change_handler(struct team_handle * th, void * arg, team_change_type_mask_t type_mask)
+{
+    (void)th;
+    (void)type_mask;
+    static_cast<TeamdEventListener *>(arg)->m_changed = true;
+    return 0;
+}
+
 ///
 /// The destructor clean up handlers to teamds
 ///
 TeamdCtlMgr::~TeamdCtlMgr()
 {
+    for (const auto & p: m_listeners)
+    {
+        if (m_select)
+        {
+            m_select->removeSelectable(p.second.get());
+        }
+    }
+
     for (const auto & p: m_handlers)
     {
         const auto & lag_name = p.first;
@@ -106,11 +183,50 @@ bool TeamdCtlMgr::try_add_lag(const std::string & lag_name)
 
     m_handlers.emplace(lag_name, tdc);
     m_lags_to_add.erase(lag_name);
+    add_event_listener(lag_name);
     SWSS_LOG_NOTICE("The LAG '%s' has been added.", lag_name.c_str());
 
     return true;
 }
 
+///
+/// Subscribe to change notifications for a LAG interface with lag_name.
+/// If the subscription fails, the LAG is polled instead
+/// @param lag_name a name for LAG interface
+///
+void TeamdCtlMgr::add_event_listener(const std::string & lag_name)
+{
+    if (!m_select)
+    {
+        return;
+    }
+
+    try
+    {
+        std::unique_ptr<TeamdEventListener> listener(new TeamdEventListener(lag_name));
+        m_select->addSelectable(listener.get());
+        m_listeners.emplace(lag_name, std::move(listener));
+    }
+    catch (const std::system_error & e)
+    {
+        SWSS_LOG_INFO("No change events for LAG '%s', it will be polled: %s", lag_name.c_str(), e.what());
+    }
+}
+
+///
+/// Unsubscribe from change notifications for a LAG interface with lag_name
+/// @param lag_name a name for LAG interface
+///
+void TeamdCtlMgr::remove_event_listener(const std::string & lag_name)
+{
+    auto it = m_listeners.find(lag_name);
+    if (it != m_listeners.end())
+    {
+        m_select->removeSelectable(it->second.get());
+        m_listeners.erase(it);
+    }
+}
+
 ///
 /// Removes a LAG interface with lag_name from the manager
 /// This method deallocates teamd structures
@@ -122,6 +238,7 @@ bool TeamdCtlMgr::remove_lag(const std::string & lag_name)
     if (has_key(lag_name))
     {
         auto tdc = m_handlers[lag_name];
+        remove_event_listener(lag_name);
         teamdctl_disconnect(tdc);
         teamdctl_free(tdc);
         m_handlers.erase(lag_name);
@@ -215,3 +332,64 @@ TeamdCtlDumps TeamdCtlMgr::get_dumps()
     return res;
 }
 
+///
+/// Get dumps for LAG interfaces from lag_names
+/// @param lag_names a list of LAG names
+/// @return vector of pairs. Each pair first value is a name of LAG, second value is a dump
+///
+TeamdCtlDumps TeamdCtlMgr::get_dumps(const std::vector<std::string> & lag_names)
+{
+    TeamdCtlDumps res;
+
+    for (const auto & lag_name: lag_names)
+    {
+        const auto & result = get_dump(lag_name);
+        const auto & status = result.first;
+        const auto & dump = result.second;
+        if (status)
+        {
+            res.push_back({ lag_name, dump });
+        }
+    }
+
+    return res;
+}
+
+///
+/// Get LAG interfaces which got change notifications since the last call
+/// @return list of changed LAG names
+///
+std::vector<std::string> TeamdCtlMgr::get_changed_lags()
+{
+    std::vector<std::string> res;
+
+    for (const auto & p: m_listeners)
+    {
+        if (p.second->is_changed())
+        {
+            res.push_back(p.first);
+            p.second->clear_changed();
+        }
+    }
+
+    return res;
+}
+
+///
+/// Get LAG interfaces without change notifications, which must be polled
+/// @return list of LAG names to poll
+///
+std::vector<std::string> TeamdCtlMgr::get_polled_lags() const
+{
+    std::vector<std::string> res;
+
+    for (const auto & p: m_handlers)
+    {
+        if (m_listeners.find(p.first) == m_listeners.end())
+        {
+            res.push_back(p.first);
+        }
+    }
+
+    return res;
+}
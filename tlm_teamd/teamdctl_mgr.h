@@ -2,31 +2,66 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <unordered_map>
 
 #include <teamdctl.h>
+#include <team.h>
+
+#include <select.h>
+#include <selectable.h>
 
 using TeamdCtlDump = std::pair<bool, std::string>;
 using TeamdCtlDumpsEntry = std::pair<std::string, std::string>;
 using TeamdCtlDumps = std::vector<TeamdCtlDumpsEntry>;
 
+///
+/// Listener of libteam port and option change notifications for a LAG.
+/// Notifications only mark the LAG as changed, so a burst of them
+/// results in a single teamd dump.
+///
+class TeamdEventListener : public swss::Selectable
+{
+public:
+    TeamdEventListener(const std::string & lag_name);
+    ~TeamdEventListener();
+    int getFd() override;
+    uint64_t readData() override;
+    bool is_changed() const { return m_changed; }
+    void clear_changed() { m_changed = false; }
+
+private:
+    static int change_handler(struct team_handle * th, void * arg, team_change_type_mask_t type_mask);
+    static const struct team_change_handler m_change_handler;
+
+    struct team_handle * m_team;
+    bool m_changed;
+};
+
 class TeamdCtlMgr
 {
 public:
-    TeamdCtlMgr() = default;
+    TeamdCtlMgr(swss::Select * select = nullptr) : m_select(select) {};
     ~TeamdCtlMgr();
     bool add_lag(const std::string & lag_name);
     bool remove_lag(const std::string & lag_name);
     void process_add_queue();
     TeamdCtlDump get_dump(const std::string & lag_name);
     TeamdCtlDumps get_dumps();
+    TeamdCtlDumps get_dumps(const std::vector<std::string> & lag_names);
+    std::vector<std::string> get_changed_lags();
+    std::vector<std::string> get_polled_lags() const;
 
 private:
     bool has_key(const std::string & lag_name) const;
     bool try_add_lag(const std::string & lag_name);
+    void add_event_listener(const std::string & lag_name);
+    void remove_event_listener(const std::string & lag_name);
 
+    swss::Select * m_select;
     std::unordered_map<std::string, struct teamdctl*> m_handlers;
     std::unordered_map<std::string, int> m_lags_to_add;
+    std::unordered_map<std::string, std::unique_ptr<TeamdEventListener>> m_listeners;
 
     const int max_attempts_to_add = 10;
 };
@@ -5,6 +5,39 @@
 
 #include "values_store.h"
 
+///
+/// Construct the store and compile the json paths for the streaming extractor
+/// @param db a pointer to the database to write values to
+/// @param use_dom parse dumps with jansson DOM, instead of the streaming extractor
+///
+ValuesStore::ValuesStore(const swss::DBConnector * db, bool use_dom) : m_db(db), m_use_dom(use_dom)
+{
+    for (const auto & p: m_lag_paths)
+    {
+        m_extractor.add_path(p.first, extractor_type(p.second));
+    }
+
+    for (const auto & p: m_member_paths)
+    {
+        m_extractor.add_item_path(p.first, extractor_type(p.second));
+    }
+}
+
+///
+/// Convert the value type to the extractor value type
+///
+JsonPathExtractor::value_type ValuesStore::extractor_type(ValuesStore::json_type type)
+{
+    switch (type)
+    {
+        case ValuesStore::json_type::string:  return JsonPathExtractor::value_type::string;
+        case ValuesStore::json_type::boolean: return JsonPathExtractor::value_type::boolean;
+        case ValuesStore::json_type::integer: return JsonPathExtractor::value_type::integer;
+    }
+
+    throw std::runtime_error("Reach the end of the ValuesStore::extractor_type");
+}
+
 ///
 /// Extract port names from teamd status json dump.
 /// @return vector of LAG member port names from the dump
@@ -183,6 +216,40 @@ void ValuesStore::extract_values(const std::string & lag_name, json_t * root, Ha
     return;
 }
 
+///
+/// Extract values for LAG with name lag_name, from the raw json dump, to the temporary storage
+/// The dump is processed in a single pass with the precompiled paths.
+/// @param lag_name a name of the LAG
+/// @param json_dump a raw json dump from teamd
+/// @param storage a reference to the temporary storage
+///
+void ValuesStore::extract_values_streaming(const std::string & lag_name, const std::string & json_dump, HashOfRecords & storage)
+{
+    auto extracted = m_extractor.extract(json_dump);
+
+    for (const auto & p: m_lag_paths)
+    {
+        if (extracted.values.find(p.first) == extracted.values.end())
+        {
+            throw std::runtime_error("Can't find a value. path='" + p.first + "' LAG='" + lag_name + "'");
+        }
+    }
+    storage.emplace("LAG_TABLE|" + lag_name, std::move(extracted.values));
+
+    for (auto & item: extracted.items)
+    {
+        const auto & port = item.first;
+        for (const auto & p: m_member_paths)
+        {
+            if (item.second.find(p.first) == item.second.end())
+            {
+                throw std::runtime_error("Can't find a value. path='ports." + port + "." + p.first + "' LAG='" + lag_name + "'");
+            }
+        }
+        storage.emplace("LAG_MEMBER_TABLE|" + lag_name + "|" + port, std::move(item.second));
+    }
+}
+
 ///
 /// Parse json from the data
 /// @return a pointer to the parsed json tree
@@ -215,6 +282,11 @@ HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps)
     {
         const auto & lag_name = p.first;
         const auto & json_dump = p.second;
+        if (!m_use_dom)
+        {
+            extract_values_streaming(lag_name, json_dump, storage);
+            continue;
+        }
         json_t * root = load_json(json_dump);
         extract_values(lag_name, root, storage);
         json_decref(root);
@@ -245,6 +317,41 @@ std::vector<std::string> ValuesStore::get_old_keys(const HashOfRecords & storage
     return old_keys;
 }
 
+///
+/// Extract a list of stale keys which belong to LAGs from lag_names only.
+/// Keys of other LAGs are kept untouched
+/// @param storage a reference to the temporary storage
+/// @param lag_names names of the LAGs which were dumped into the temporary storage
+/// @return list of stale keys
+///
+std::vector<std::string> ValuesStore::get_old_keys(const HashOfRecords & storage, const std::unordered_set<std::string> & lag_names)
+{
+    std::vector<std::string> old_keys;
+    for (const auto & p: m_storage)
+    {
+        const auto & db_key = p.first;
+        if (lag_names.find(get_lag_name(db_key)) != lag_names.end()
+            && storage.find(db_key) == storage.end())
+        {
+            old_keys.push_back(db_key);
+        }
+    }
+
+    return old_keys;
+}
+
+///
+/// Extract a LAG name from a database key
+/// For example "LAG_MEMBER_TABLE|PortChannel01|Ethernet0" would return "PortChannel01"
+/// @param key a database key
+/// @return the LAG name
+///
+std::string ValuesStore::get_lag_name(const std::string & key)
+{
+    const auto & entry_key = split_key(key).second;
+    return entry_key.substr(0, entry_key.find('|'));
+}
+
 ///
 /// Remove keys from vector keys from the storage
 /// @param keys a list of keys to remove from the storage
@@ -376,3 +483,45 @@ void ValuesStore::update(const std::vector<StringPair> & dumps)
         SWSS_LOG_WARN("Exception '%s' had been thrown in ValuesStore", e.what());
     }
 }
+
+///
+/// Update the storage with json dumps for the dumped LAG interfaces only.
+/// Entries of LAGs which are not in dumps are kept as is.
+///
+void ValuesStore::update_lags(const std::vector<StringPair> & dumps)
+{
+    if (dumps.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        std::unordered_set<std::string> lag_names;
+        for (const auto & p: dumps)
+        {
+            lag_names.insert(p.first);
+        }
+
+        const auto & storage = from_json(dumps);
+        const auto & old_keys = get_old_keys(storage, lag_names);
+        remove_keys_db(old_keys);
+        remove_keys_storage(old_keys);
+        const auto & keys_to_refresh = update_storage(storage);
+        update_db(storage, keys_to_refresh);
+    }
+    catch (const std::exception & e)
+    {
+        SWSS_LOG_WARN("Exception '%s' had been thrown in ValuesStore", e.what());
+    }
+}
+
+///
+/// Remove all entries of the LAG interface with lag_name from the storage and the db
+///
+void ValuesStore::remove_lag(const std::string & lag_name)
+{
+    const auto & old_keys = get_old_keys(HashOfRecords(), { lag_name });
+    remove_keys_db(old_keys);
+    remove_keys_storage(old_keys);
+}
@@ -2,11 +2,14 @@
 
 #include <string>
 #include <vector>
+#include <unordered_set>
 
 #include <jansson.h>
 
 #include <dbconnector.h>
 
+#include "json_extractor.h"
+
 using StringPair = std::pair<std::string, std::string>;
 using Records = std::unordered_map<std::string, std::string>;
 using HashOfRecords = std::unordered_map<std::string, Records>;
@@ -14,8 +17,11 @@ using HashOfRecords = std::unordered_map<std::string, Records>;
 class ValuesStore
 {
 public:
-    ValuesStore(const swss::DBConnector * db) : m_db(db) {};
+    ValuesStore(const swss::DBConnector * db, bool use_dom = false);
     void update(const std::vector<StringPair> & dumps);
+    void update_lags(const std::vector<StringPair> & dumps);
+    void remove_lag(const std::string & lag_name);
+    HashOfRecords from_json(const std::vector<StringPair> & dumps);
 
 private:
     enum class json_type
@@ -33,8 +39,11 @@ private:
     std::string unpack_boolean(json_t * root, const std::string & key, const std::string & path);
     std::string unpack_integer(json_t * root, const std::string & key, const std::string & path);
     std::string get_value(json_t * root, const std::string & path, ValuesStore::json_type type);
-    HashOfRecords from_json(const std::vector<StringPair> & dumps);
+    JsonPathExtractor::value_type extractor_type(ValuesStore::json_type type);
+    void extract_values_streaming(const std::string & lag_name, const std::string & json_dump, HashOfRecords & storage);
     std::vector<std::string> get_old_keys(const HashOfRecords & storage);
+    std::vector<std::string> get_old_keys(const HashOfRecords & storage, const std::unordered_set<std::string> & lag_names);
+    std::string get_lag_name(const std::string & key);
     void remove_keys_storage(const std::vector<std::string> & keys);
     void remove_keys_db(const std::vector<std::string> & keys);
     StringPair split_key(const std::string & key);
@@ -44,6 +53,7 @@ private:
 
     HashOfRecords m_storage;  // our main storage
     const swss::DBConnector * m_db;
+    bool m_use_dom;           // parse dumps into a jansson DOM instead of the streaming extractor
 
     const std::vector<std::pair<std::string, ValuesStore::json_type>> m_lag_paths = {
         { "setup.kernel_team_mode_name", ValuesStore::json_type::string  },
@@ -70,4 +80,6 @@ private:
         { "runner.selected",                   ValuesStore::json_type::boolean },
         { "runner.state",                      ValuesStore::json_type::string  },
     };
+
+    JsonPathExtractor m_extractor { "ports" }; // compiled m_lag_paths and m_member_paths
 };
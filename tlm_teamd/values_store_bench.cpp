@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "values_store.h"
+
+///
+/// Microbenchmark of ValuesStore dump parsing: jansson DOM against the streaming extractor
+/// Usage: values_store_bench [lags] [members per LAG] [iterations]
+///
+
+///
+/// Generate a teamd LACP state dump for a LAG with members ports
+///
+std::string generate_dump(const std::string & lag_name, int members)
+{
+    std::string dump = "{\"ports\": {";
+    for (int i = 0; i < members; i++)
+    {
+        const auto & idx = std::to_string(i);
+        if (i != 0)
+        {
+            dump += ", ";
+        }
+        dump += "\"Ethernet" + std::to_string(i * 4) + "\": {"
+            "\"ifinfo\": {\"dev_addr\": \"52:54:00:12:34:" + std::to_string(10 + i % 90) + "\", \"dev_addr_len\": 6, "
+                "\"ifindex\": " + std::to_string(100 + i) + ", \"ifname\": \"Ethernet" + std::to_string(i * 4) + "\"}, "
+            "\"link\": {\"duplex\": \"full\", \"speed\": 100000, \"up\": true}, "
+            "\"link_watches\": {\"list\": {\"link_watch_0\": {\"delay_down\": 0, \"delay_up\": 0, \"down_count\": " + idx + ", "
+                "\"name\": \"ethtool\", \"up\": true}}, \"up\": true}, "
+            "\"runner\": {\"actor_lacpdu_info\": {\"key\": 0, \"port\": " + idx + ", \"port_priority\": 255, "
+                "\"state\": 61, \"system\": \"52:54:00:12:34:56\", \"system_priority\": 65535}, "
+            "\"aggregator\": {\"id\": 100, \"selected\": true}, \"key\": 0, "
+            "\"partner_lacpdu_info\": {\"key\": 0, \"port\": " + idx + ", \"port_priority\": 255, "
+                "\"state\": 61, \"system\": \"52:54:00:65:43:21\", \"system_priority\": 65535}, "
+            "\"prio\": 255, \"selected\": true, \"state\": \"current\"}}";
+    }
+    dump += "}, "
+        "\"runner\": {\"active\": true, \"fallback\": false, \"fast_rate\": false, \"select_policy\": \"lacp_prio\", "
+            "\"sys_prio\": 65535}, "
+        "\"setup\": {\"daemonized\": false, \"dbus_enabled\": false, \"debug_level\": 0, "
+            "\"kernel_team_mode_name\": \"loadbalance\", \"pid\": 4242, \"pid_file\": \"/var/run/teamd/" + lag_name + ".pid\", "
+            "\"runner_name\": \"lacp\", \"zmq_enabled\": false}, "
+        "\"team_device\": {\"ifinfo\": {\"dev_addr\": \"52:54:00:12:34:56\", \"dev_addr_len\": 6, \"ifindex\": 42, "
+            "\"ifname\": \"" + lag_name + "\"}}}";
+
+    return dump;
+}
+
+///
+/// Parse the dumps iterations times
+/// @return average time per LAG dump in microseconds
+///
+double run(ValuesStore & store, const std::vector<StringPair> & dumps, int iterations, HashOfRecords & result)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        result = store.from_json(dumps);
+    }
+    const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+    return elapsed.count() / iterations / (double)dumps.size();
+}
+
+int main(int argc, char ** argv)
+{
+    int lags = argc > 1 ? std::atoi(argv[1]) : 16;
+    int members = argc > 2 ? std::atoi(argv[2]) : 32;
+    int iterations = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    if (lags <= 0 || members <= 0 || iterations <= 0)
+    {
+        std::cerr << "Usage: values_store_bench [lags] [members per LAG] [iterations]" << std::endl;
+        return -1;
+    }
+
+    std::vector<StringPair> dumps;
+    for (int i = 0; i < lags; i++)
+    {
+        const auto & lag_name = "PortChannel" + std::to_string(i);
+        dumps.emplace_back(lag_name, generate_dump(lag_name, members));
+    }
+
+    ValuesStore dom_store(nullptr, true);
+    ValuesStore streaming_store(nullptr, false);
+    HashOfRecords dom_result;
+    HashOfRecords streaming_result;
+
+    double dom_us = run(dom_store, dumps, iterations, dom_result);
+    double streaming_us = run(streaming_store, dumps, iterations, streaming_result);
+
+    std::cout << "LAGs: " << lags << ", members per LAG: " << members
+              << ", dump size: " << dumps.front().second.size() << " bytes" << std::endl;
+    std::cout << "DOM:       " << dom_us << " us per LAG dump" << std::endl;
+    std::cout << "Streaming: " << streaming_us << " us per LAG dump" << std::endl;
+    std::cout << "Speedup:   " << dom_us / streaming_us << "x" << std::endl;
+
+    if (dom_result != streaming_result)
+    {
+        std::cerr << "Results of DOM and streaming parsing differ" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -1,7 +1,9 @@
 #include <string>
 #include <algorithm>
+#include <functional>
 #include "logger.h"
 #include "schema.h"
+#include "redisreply.h"
 #include "warm_restart.h"
 #include "warmRestartAssist.h"
 
@@ -97,24 +99,28 @@ string AppRestartAssist::joinVectorString(const vector<FieldValueTuple> &fv)
     return s;
 }
 
-// Set the cache entry state
-void AppRestartAssist::setCacheEntryState(std::vector<FieldValueTuple> &fvVector,
-    cache_state_t state)
+/*
+ * Combine per field/value hashes with an addition so that the digest does
+ * not depend on the order fields are stored in appDB or sent by the app.
+ */
+uint64_t AppRestartAssist::getDigest(const std::vector<FieldValueTuple> &fvVector)
 {
-    fvVector.back().second = cacheStateMap.at(state);
-}
+    std::hash<string> strHash;
+    uint64_t digest = 0;
 
-// Get the cache entry state
-AppRestartAssist::cache_state_t AppRestartAssist::getCacheEntryState(const std::vector<FieldValueTuple> &fvVector)
-{
-    for (auto &iter : cacheStateMap)
+    for (const auto &fv : fvVector)
     {
-        if (fvVector.back().second == iter.second)
-        {
-            return iter.first;
-        }
+        uint64_t h = strHash(fvField(fv));
+        h ^= strHash(fvValue(fv)) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+
+        // splitmix64 finalizer to spread the bits before summing
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+
+        digest += h;
     }
-    throw std::logic_error("cache entry state is invalid");
+    return digest;
 }
 
 void AppRestartAssist::appDataReplayed()
@@ -127,49 +133,90 @@ void AppRestartAssist::warmStartDisabled()
     WarmStart::setWarmStartState(m_appName, WarmStart::WSDISABLED);
 }
 
-// Read table(s) from APPDB and append stale flag then insert to cachemap
+/*
+ * Fetch one SCAN page of table keys along with their field/values in a single
+ * round trip. Returns the next cursor followed by key, {field, value, ...} pairs.
+ */
+static const string restoreLuaScript =
+    "local page = redis.call('SCAN', ARGV[1], 'MATCH', ARGV[2], 'COUNT', ARGV[3])\n"
+    "local ret = {page[1]}\n"
+    "for _, key in ipairs(page[2]) do\n"
+    "    table.insert(ret, key)\n"
+    "    table.insert(ret, redis.call('HGETALL', key))\n"
+    "end\n"
+    "return ret\n";
+
+// Read table(s) from APPDB and insert them to cachemap as STALE entries
 void AppRestartAssist::readTablesToMap()
 {
-    vector<string> keys;
+    if (m_restoreSha.empty())
+    {
+        m_restoreSha = m_pipeLine->loadRedisScript(restoreLuaScript);
+    }
 
     for (auto it = m_appTables.begin(); it != m_appTables.end(); it++)
     {
-        (it->second)->getKeys(keys);
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
+        readTableToMap(it->first, it->second);
+        WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
+        SWSS_LOG_NOTICE("Restored appDB table to %s internal cache map, %zu entries",
+                (it->first).c_str(), appTableCacheMap[it->first].size());
+    }
+    return;
+}
+
+/*
+ * Page through the table with SCAN instead of loading all keys and values at
+ * once, only the digest of each entry is kept in the cache map.
+ */
+void AppRestartAssist::readTableToMap(const string &tableName, Table *table)
+{
+    const string prefix = tableName + table->getTableNameSeparator();
+    const string pattern = prefix + "*";
+    const string pageSize = to_string(RESTORE_SCAN_PAGE_SIZE);
+    auto &cache = appTableCacheMap[tableName];
+    string cursor = "0";
+
+    do
+    {
+        RedisCommand command;
+        command.format("EVALSHA %s 0 %s %s %s", m_restoreSha.c_str(),
+                       cursor.c_str(), pattern.c_str(), pageSize.c_str());
+        RedisReply r(m_pipeLine->push(command, REDIS_REPLY_ARRAY));
+        redisReply *reply = r.getContext();
+
+        cursor = reply->element[0]->str;
 
-        for (const auto &key: keys)
+        for (size_t i = 1; i + 1 < reply->elements; i += 2)
         {
+            string key = string(reply->element[i]->str).substr(prefix.length());
+            redisReply *values = reply->element[i + 1];
             vector<FieldValueTuple> fv;
 
-                // if the fieldvalue is empty, skip
-            if (!(it->second)->get(key, fv))
+            // if the fieldvalue is empty, skip
+            if (values->elements == 0)
             {
                 continue;
             }
 
-            fv.push_back(state);
-            setCacheEntryState(fv, STALE);
-
-            string s = joinVectorString(fv);
+            for (size_t j = 0; j + 1 < values->elements; j += 2)
+            {
+                fv.emplace_back(values->element[j]->str, values->element[j + 1]->str);
+            }
 
             SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
-                   "%s", (it->first).c_str(), key.c_str(), s.c_str());
+                   "%s", tableName.c_str(), key.c_str(), joinVectorString(fv).c_str());
 
-            // insert to the cache map
-            appTableCacheMap[it->first][key] = fv;
+            cache[key] = cache_entry_t{getDigest(fv), true, STALE, {}};
         }
-        WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
-        SWSS_LOG_NOTICE("Restored appDB table to %s internal cache map", (it->first).c_str());
-    }
-    return;
+    } while (cursor != "0");
 }
 
 /*
  * Check and insert to CacheMap Logic:
  * if delete_key:
- *  mark the entry as "DELETE";
+ *  mark the entry as "DELETE" if it exists in appDB, drop it otherwise;
  * else:
- *  if key exist {
+ *  if key exist in appDB {
  *    if it has different value: update with "NEW" flag.
  *    if same value:  mark it as "SAME";
  *  } else {
@@ -181,47 +228,51 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
     SWSS_LOG_INFO("Received message %s, key: %s, "
             "%s, delete = %d", tableName.c_str(), key.c_str(), joinVectorString(fvVector).c_str(), delete_key);
 
-    auto found = appTableCacheMap[tableName].find(key);
+    auto &cache = appTableCacheMap[tableName];
+    auto found = cache.find(key);
 
     if (delete_key)
     {
         SWSS_LOG_NOTICE("%s, delete key: %s, ", tableName.c_str(), key.c_str());
         /* mark it as DELETE if exist, otherwise, no-op */
-        if (found != appTableCacheMap[tableName].end())
+        if (found != cache.end())
         {
-            setCacheEntryState(found->second, DELETE);
+            if (found->second.inAppDb)
+            {
+                found->second.state = DELETE;
+                found->second.fvVector.clear();
+            }
+            else
+            {
+                cache.erase(found);
+            }
         }
     }
-    else if (found != appTableCacheMap[tableName].end())
+    else if (found != cache.end() && found->second.inAppDb)
     {
-        // check only the original vector range (exclude cache-state field/value)
-        if(! contains(found->second, fvVector))
+        // compare against the content restored from appDB
+        if (found->second.digest != getDigest(fvVector))
         {
             SWSS_LOG_NOTICE("%s, found key: %s, new value ", tableName.c_str(), key.c_str());
 
-            FieldValueTuple state(CACHE_STATE_FIELD, "");
-            fvVector.push_back(state);
-
             // mark as NEW flag
-            setCacheEntryState(fvVector, NEW);
-            appTableCacheMap[tableName][key] = fvVector;
+            found->second.state = NEW;
+            found->second.fvVector = std::move(fvVector);
         }
         else
         {
             SWSS_LOG_INFO("%s, found key: %s, same value", tableName.c_str(), key.c_str());
 
             // mark as SAME flag
-            setCacheEntryState(found->second, SAME);
+            found->second.state = SAME;
+            found->second.fvVector.clear();
         }
     }
     else
     {
-        // not found, mark the entry as NEW and insert to map
+        // not in appDB, mark the entry as NEW and insert to map
         SWSS_LOG_NOTICE("%s, not found key: %s, new", tableName.c_str(), key.c_str());
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
-        fvVector.push_back(state);
-        setCacheEntryState(fvVector, NEW);
-        appTableCacheMap[tableName][key] = fvVector;
+        cache[key] = cache_entry_t{0, false, NEW, std::move(fvVector)};
     }
     return;
 }
@@ -244,31 +295,29 @@ void AppRestartAssist::reconcile()
         tableName = tableIter->first;
         for (auto it = (tableIter->second).begin(); it != (tableIter->second).end(); ++it)
         {
-            string s = joinVectorString(it->second);
-            auto state = getCacheEntryState(it->second);
+            auto state = it->second.state;
 
             if (state == SAME)
             {
-                SWSS_LOG_INFO("%s SAME, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                SWSS_LOG_INFO("%s SAME, key: %s",
+                        tableName.c_str(), it->first.c_str());
                 continue;
             }
             else if (state == STALE || state == DELETE)
             {
-                SWSS_LOG_NOTICE("%s STALE/DELETE, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                SWSS_LOG_NOTICE("%s %s, key: %s", tableName.c_str(),
+                        cacheStateMap.at(state).c_str(), it->first.c_str());
 
                 //delete from appDB
                 m_psTables[tableName]->del(it->first);
             }
             else if (state == NEW)
             {
-                SWSS_LOG_NOTICE("%s NEW, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                SWSS_LOG_NOTICE("%s NEW, key: %s, %s", tableName.c_str(),
+                        it->first.c_str(), joinVectorString(it->second.fvVector).c_str());
 
-                //add to appDB, exclude the state
-                it->second.pop_back();
-                m_psTables[tableName]->set(it->first, it->second);
+                //add to appDB
+                m_psTables[tableName]->set(it->first, it->second.fvVector);
             }
             else
             {
@@ -278,6 +327,11 @@ void AppRestartAssist::reconcile()
         // reconcile finished, clear the map, mark the warmstart state
         appTableCacheMap[tableName].clear();
     }
+    // Push out reconciled changes held by buffered producer tables
+    for (auto &psTable : m_psTables)
+    {
+        psTable.second->flush();
+    }
     appTableCacheMap.clear();
     WarmStart::setWarmStartState(m_appName, WarmStart::RECONCILED);
     m_warmStartInProgress = false;
@@ -314,18 +368,3 @@ bool AppRestartAssist::checkReconcileTimer(Selectable *s)
     }
     return false;
 }
-
-// check if left vector contains all elements of right vector
-bool AppRestartAssist::contains(const std::vector<FieldValueTuple>& left,
-              const std::vector<FieldValueTuple>& right)
-{
-    for (auto const& rv : right)
-    {
-        if (std::find(left.begin(), left.end(), rv) == left.end())
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
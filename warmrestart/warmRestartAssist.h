@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <string>
+#include <cstdint>
 #include "dbconnector.h"
 #include "table.h"
 #include "producerstatetable.h"
@@ -94,7 +95,6 @@ private:
     typedef std::map<cache_state_t, std::string> cache_state_map;
     // Enum to string translation map
     static const cache_state_map cacheStateMap;
-    const std::string CACHE_STATE_FIELD = "cache-state";
 
     /*
      * Default timer to be 5 seconds
@@ -102,7 +102,23 @@ private:
      * Precedence ascent order: Default -> loading class with value -> configuration
      */
     static const uint32_t DEFAULT_INTERNAL_TIMER_VALUE = 5;
-    typedef std::map<std::string, std::unordered_map<std::string, std::vector<swss::FieldValueTuple>>> AppTableMap;
+
+    // Number of keys requested per SCAN page when restoring app tables
+    static const uint32_t RESTORE_SCAN_PAGE_SIZE = 1000;
+
+    /*
+     * Compact cache entry. Entries restored from appDB only keep a digest of
+     * their field/value content, full field/values are held only for NEW
+     * entries which have to be written to appDB on reconciliation.
+     */
+    struct cache_entry_t
+    {
+        uint64_t digest;                             // digest of the content currently in appDB
+        bool inAppDb;                                // entry was restored from appDB
+        cache_state_t state;                         // reconcile action for the entry
+        std::vector<swss::FieldValueTuple> fvVector; // content to write, NEW entries only
+    };
+    typedef std::map<std::string, std::unordered_map<std::string, cache_entry_t>> AppTableMap;
 
     // cache map to store temporary application table
     AppTableMap appTableCacheMap;
@@ -112,17 +128,16 @@ private:
     std::string         m_dockerName; // docker name of the application
     std::string         m_appName;    // application name
     ProducerStateTables m_psTables;   // producer state tables
+    std::string         m_restoreSha; // paged table restore lua script
 
     bool m_warmStartInProgress;       // indicate if warm start is in progress
     time_t m_reconcileTimer;          // reconcile timer value
     SelectableTimer m_warmStartTimer; // reconcile timer
 
-    // Set or get cache entry state
     std::string joinVectorString(const std::vector<FieldValueTuple> &fv);
-    void setCacheEntryState(std::vector<FieldValueTuple> &fvVector, cache_state_t state);
-    cache_state_t getCacheEntryState(const std::vector<FieldValueTuple> &fvVector);
-    bool contains(const std::vector<FieldValueTuple>& left,
-                  const std::vector<FieldValueTuple>& right);
+    // Order independent digest of the field/value pairs of an entry
+    uint64_t getDigest(const std::vector<FieldValueTuple> &fvVector);
+    void readTableToMap(const std::string &tableName, Table *table);
 };
 
 }
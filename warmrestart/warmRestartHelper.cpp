@@ -1,6 +1,8 @@
 #include <cassert>
 #include <sstream>
 
+#include "redisapi.h"
+#include "redisreply.h"
 #include "warmRestartHelper.h"
 
 
@@ -12,8 +14,13 @@ WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  const std::string  &syncTableName,
                                  const std::string  &dockerName,
                                  const std::string  &appName) :
-    m_restorationTable(pipeline, syncTableName, false),
+    m_pipeline(pipeline),
     m_syncTable(syncTable),
+    m_restorationTable(pipeline, syncTableName, false),
+    m_restorationDone(false),
+    m_restorationAbort(false),
+    m_restoredRecords(0),
+    m_enabled(false),
     m_syncTableName(syncTableName),
     m_dockName(dockerName),
     m_appName(appName)
@@ -24,6 +31,7 @@ WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
 
 WarmStartHelper::~WarmStartHelper()
 {
+    stopRestoration();
 }
 
 
@@ -65,7 +73,7 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
+    stopRestoration();
     m_refreshMap.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
@@ -93,24 +101,69 @@ uint32_t WarmStartHelper::getRestartTimer(void) const
 }
 
 
+/*
+ * Check if the table holds at least one record. SCAN pages may come back empty
+ * while the cursor is not exhausted, hence the loop within the script.
+ */
+static const std::string probeLuaScript =
+    "local cursor = '0'\n"
+    "repeat\n"
+    "    local page = redis.call('SCAN', cursor, 'MATCH', ARGV[1], 'COUNT', ARGV[2])\n"
+    "    if #page[2] > 0 then\n"
+    "        return 1\n"
+    "    end\n"
+    "    cursor = page[1]\n"
+    "until cursor == '0'\n"
+    "return 0\n";
+
+/*
+ * Fetch one SCAN page of table keys along with their field/values in a single
+ * round trip. Returns the next cursor followed by key, {field, value, ...} pairs.
+ */
+static const std::string restoreLuaScript =
+    "local page = redis.call('SCAN', ARGV[1], 'MATCH', ARGV[2], 'COUNT', ARGV[3])\n"
+    "local ret = {page[1]}\n"
+    "for _, key in ipairs(page[2]) do\n"
+    "    table.insert(ret, key)\n"
+    "    table.insert(ret, redis.call('HGETALL', key))\n"
+    "end\n"
+    "return ret\n";
+
+
+bool WarmStartHelper::hasRestorationRecords(void)
+{
+    std::string pattern = m_syncTableName + m_restorationTable.getTableNameSeparator() + "*";
+
+    RedisCommand command;
+    command.format("EVAL %s 0 %s %s", probeLuaScript.c_str(), pattern.c_str(),
+                   std::to_string(RESTORATION_CHUNK_SIZE).c_str());
+    RedisReply r(m_pipeline->getDBConnector(), command, REDIS_REPLY_INTEGER);
+
+    return r.getContext()->integer != 0;
+}
+
+
 /*
  * Invoked by warmStartHelper clients during initialization. All interested parties
  * are expected to call this method to upload their associated redisDB state into
  * a temporary buffer, which will eventually serve to resolve any conflict between
  * 'old' and 'new' state.
+ *
+ * The upload itself runs on a helper thread, so that clients can proceed to
+ * accept connections and collect refreshed state while it is taking place.
  */
 bool WarmStartHelper::runRestoration()
 {
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    stopRestoration();
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (!hasRestorationRecords())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -120,20 +173,149 @@ bool WarmStartHelper::runRestoration()
         return false;
     }
 
-    SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
-                    "application.",
-                    m_restorationVector.size(),
-                    m_appName.c_str());
+    m_restorationChunks.clear();
+    m_restorationDone = false;
+    m_restorationError = nullptr;
+    m_restorationAbort = false;
+    m_restoredRecords = 0;
+
+    std::shared_ptr<DBConnector> db(m_pipeline->getDBConnector()->newConnector(0));
+    std::string prefix = m_syncTableName + m_restorationTable.getTableNameSeparator();
+
+    m_restorationThread = std::thread(&WarmStartHelper::restoreTable, this, db, prefix);
 
     setState(WarmStart::RESTORED);
 
-    SWSS_LOG_NOTICE("Warm-Restart: Completed AppDB restoration process for %s "
-                    "application.", m_appName.c_str());
+    SWSS_LOG_NOTICE("Warm-Restart: AppDB restoration process for %s application "
+                    "is running in background.", m_appName.c_str());
 
     return true;
 }
 
 
+/*
+ * Helper thread body: page through the table and hand over every non-empty
+ * page as one chunk to the reconciliation logic.
+ */
+void WarmStartHelper::restoreTable(std::shared_ptr<DBConnector> db, const std::string &prefix)
+{
+    std::string pattern = prefix + "*";
+    std::string count = std::to_string(RESTORATION_CHUNK_SIZE);
+    std::string cursor = "0";
+    std::unordered_set<std::string> restoredKeys;
+
+    try
+    {
+        std::string sha = loadRedisScript(db.get(), restoreLuaScript);
+
+        do
+        {
+            RedisCommand command;
+            command.format("EVALSHA %s 0 %s %s %s", sha.c_str(), cursor.c_str(),
+                           pattern.c_str(), count.c_str());
+            RedisReply r(db.get(), command, REDIS_REPLY_ARRAY);
+            redisReply *reply = r.getContext();
+
+            cursor = reply->element[0]->str;
+
+            kfvVector chunk;
+            parseRestorationPage(reply, prefix, restoredKeys, chunk);
+
+            if (!chunk.empty())
+            {
+                std::lock_guard<std::mutex> lock(m_restorationMutex);
+                m_restoredRecords += chunk.size();
+                m_restorationChunks.push_back(std::move(chunk));
+                m_restorationCv.notify_one();
+            }
+        } while (cursor != "0" && !m_restorationAbort);
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("Warm-Restart: AppDB restoration failed for %s application: %s",
+                       m_appName.c_str(), e.what());
+
+        std::lock_guard<std::mutex> lock(m_restorationMutex);
+        m_restorationError = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(m_restorationMutex);
+    m_restorationDone = true;
+    m_restorationCv.notify_one();
+}
+
+
+/*
+ * Append the records of one restoration page, a cursor followed by key and
+ * HGETALL reply pairs, to chunk. SCAN may return a key more than once, only
+ * its first copy is kept: reconciling it twice would delete the entry.
+ */
+void WarmStartHelper::parseRestorationPage(const redisReply                *reply,
+                                           const std::string               &prefix,
+                                           std::unordered_set<std::string> &restoredKeys,
+                                           kfvVector                       &chunk)
+{
+    for (size_t i = 1; i + 1 < reply->elements; i += 2)
+    {
+        std::string key = std::string(reply->element[i]->str).substr(prefix.length());
+        if (!restoredKeys.insert(key).second)
+        {
+            continue;
+        }
+
+        const redisReply *values = reply->element[i + 1];
+        std::vector<FieldValueTuple> fvs;
+
+        for (size_t j = 0; j + 1 < values->elements; j += 2)
+        {
+            fvs.emplace_back(values->element[j]->str, values->element[j + 1]->str);
+        }
+
+        chunk.emplace_back(key, SET_COMMAND, fvs);
+    }
+}
+
+
+/*
+ * Wait for the next restored chunk. Returns false once the whole table has
+ * been consumed, rethrows any error hit by the helper thread.
+ */
+bool WarmStartHelper::popRestorationChunk(kfvVector &chunk)
+{
+    std::unique_lock<std::mutex> lock(m_restorationMutex);
+
+    m_restorationCv.wait(lock, [this] {
+        return !m_restorationChunks.empty() || m_restorationDone;
+    });
+
+    if (!m_restorationChunks.empty())
+    {
+        chunk = std::move(m_restorationChunks.front());
+        m_restorationChunks.pop_front();
+        return true;
+    }
+
+    if (m_restorationError)
+    {
+        std::rethrow_exception(m_restorationError);
+    }
+
+    return false;
+}
+
+
+void WarmStartHelper::stopRestoration(void)
+{
+    if (m_restorationThread.joinable())
+    {
+        m_restorationAbort = true;
+        m_restorationThread.join();
+    }
+
+    m_restorationChunks.clear();
+}
+
+
 void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
 {
     const std::string key = kfvKey(kfv);
@@ -156,66 +338,81 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
+    /*
+     * Restored elements are processed chunk by chunk as the helper thread
+     * makes them available, only waiting when no chunk is pending yet.
+     */
+    kfvVector chunk;
+    while (popRestorationChunk(chunk))
     {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
-
-        auto iter = m_refreshMap.find(restoredKey);
-
-        /*
-         * If the restored element is not found in the refreshMap, we must
-         * push a delete operation for this entry.
-         */
-        if (iter == m_refreshMap.end())
+        for (auto &restoredElem : chunk)
         {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
-
-            m_syncTable->del(restoredKey);
-            continue;
-        }
+            std::string restoredKey  = kfvKey(restoredElem);
+            auto restoredFV          = kfvFieldsValues(restoredElem);
 
-        /*
-         * If an explicit delete request is sent by the application, process it
-         * right away.
-         */
-        else if (kfvOp(iter->second) == DEL_COMMAND)
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+            auto iter = m_refreshMap.find(restoredKey);
 
-            m_syncTable->del(restoredKey);
-        }
+            /*
+             * If the restored element is not found in the refreshMap, we must
+             * push a delete operation for this entry.
+             */
+            if (iter == m_refreshMap.end())
+            {
+                SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
+                                printKFV(restoredKey, restoredFV).c_str());
 
-        /*
-         * If a matching entry is found in refreshMap, proceed to compare it
-         * with its restored counterpart.
-         */
-        else
-        {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
+                m_syncTable->del(restoredKey);
+                continue;
+            }
 
-            if (compareAllFV(restoredFV, refreshedFV))
+            /*
+             * If an explicit delete request is sent by the application, process it
+             * right away.
+             */
+            else if (kfvOp(iter->second) == DEL_COMMAND)
             {
-                SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
-                                printKFV(refreshedKey, refreshedFV).c_str());
+                SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
+                                printKFV(restoredKey, restoredFV).c_str());
 
-                m_syncTable->set(refreshedKey, refreshedFV);
+                m_syncTable->del(restoredKey);
             }
+
+            /*
+             * If a matching entry is found in refreshMap, proceed to compare it
+             * with its restored counterpart.
+             */
             else
             {
-                SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
-                              "existing entry %s",
-                              printKFV(refreshedKey, refreshedFV).c_str());
+                auto refreshedKey = kfvKey(iter->second);
+                auto refreshedFV  = kfvFieldsValues(iter->second);
+
+                if (compareAllFV(restoredFV, refreshedFV))
+                {
+                    SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
+                                    printKFV(refreshedKey, refreshedFV).c_str());
+
+                    m_syncTable->set(refreshedKey, refreshedFV);
+                }
+                else
+                {
+                    SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
+                                  "existing entry %s",
+                                  printKFV(refreshedKey, refreshedFV).c_str());
+                }
             }
-        }
 
-        /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
+            /* Deleting the just-processed restored entry from the refreshMap */
+            m_refreshMap.erase(restoredKey);
+        }
     }
 
+    m_restorationThread.join();
+
+    SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
+                    "application.",
+                    m_restoredRecords,
+                    m_appName.c_str());
+
     /*
      * Iterate through all the entries left in the refreshMap, which correspond
      * to brand-new entries to be pushed down to AppDB.
@@ -250,9 +447,6 @@ void WarmStartHelper::reconcile(void)
     /* Clearing pending kfv's from refreshMap */
     m_refreshMap.clear();
 
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
-
     setState(WarmStart::RECONCILED);
 
     SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
@@ -5,7 +5,15 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <condition_variable>
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
@@ -38,6 +46,9 @@ class WarmStartHelper {
      */
     using kfvMap = std::unordered_map<std::string, KeyOpFieldsValuesTuple>;
 
+    /* Number of AppDB records requested per restoration chunk */
+    static const size_t RESTORATION_CHUNK_SIZE = 1000;
+
     void setState(WarmStart::WarmStartState state);
 
     WarmStart::WarmStartState getState(void) const;
@@ -59,17 +70,43 @@ class WarmStartHelper {
     const std::string printKFV(const std::string                  &key,
                                const std::vector<FieldValueTuple> &fv);
 
+    static void parseRestorationPage(const redisReply              *reply,
+                                     const std::string             &prefix,
+                                     std::unordered_set<std::string> &restoredKeys,
+                                     kfvVector                     &chunk);
+
   private:
 
+    bool hasRestorationRecords(void);
+
+    void restoreTable(std::shared_ptr<DBConnector> db, const std::string &prefix);
+
+    bool popRestorationChunk(kfvVector &chunk);
+
+    void stopRestoration(void);
+
     bool compareAllFV(const std::vector<FieldValueTuple> &left,
                       const std::vector<FieldValueTuple> &right);
 
     bool compareOneFV(const std::string &v1, const std::string &v2);
 
+    RedisPipeline            *m_pipeline;          // pipeline of the producer-table
     ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
     Table                     m_restorationTable;  // redis table to import current-state from
-    kfvVector                 m_restorationVector; // buffer struct to hold old state
     kfvMap                    m_refreshMap;        // buffer struct to hold new state
+
+    /*
+     * Old state is streamed in chunks by a helper thread, over its own redis
+     * connection, and consumed by reconcile() as chunks become available.
+     */
+    std::thread               m_restorationThread;
+    std::mutex                m_restorationMutex;
+    std::condition_variable   m_restorationCv;
+    std::deque<kfvVector>     m_restorationChunks; // restored chunks pending reconciliation
+    bool                      m_restorationDone;   // helper thread read the whole table
+    std::exception_ptr        m_restorationError;  // failure raised by the helper thread
+    std::atomic<bool>         m_restorationAbort;  // request helper thread to stop
+    size_t                    m_restoredRecords;   // records restored so far
     WarmStart::WarmStartState m_state;             // cached value of warmStart's FSM state
     bool                      m_enabled;           // warm-reboot enabled/disabled status
     std::string               m_syncTableName;     // producer-table-name to sync/push state to